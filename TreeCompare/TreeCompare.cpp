@@ -0,0 +1,178 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "GrammarFingerprint.h"
+#include "HuffmanSuccinctReader.h"
+#include "TextualGrammarReader.h"
+
+#include "TreeRePairVersion.h"
+#include "TreeRePairMode.h"
+#include "Helper.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+/**
+ * reads the specified file and computes the fingerprint of the
+ * represented document; the symbols are deleted afterwards so that the
+ * next file can be read
+ */
+static GrammarFingerprint * readFingerprint(char * pFilePath) {
+	GrammarFingerprint * pFingerprint;
+
+	{
+		Grammar dagGrammar;
+		Grammar mainGrammar;
+
+		// we instantiate the start symbol so that the first
+		// nonterminal of the input file becomes id 1 (instead of 0)
+		Symbol::getStartSymbol();
+
+		if (TreeRePairMode::getInstance()->useTextualGrammar()) {
+			TextualGrammarReader reader(pFilePath, dagGrammar, mainGrammar);
+		} else {
+			HuffmanSuccinctReader reader(pFilePath, dagGrammar, mainGrammar);
+		}
+
+		pFingerprint = new GrammarFingerprint(dagGrammar, mainGrammar);
+	}
+
+	Helper::deleteSymbols();
+	Symbol::reset();
+
+	return pFingerprint;
+}
+
+/**
+ * prints the element with the specified preorder number of a document
+ */
+static void printElement(const char * pFilePath,
+		GrammarFingerprint & fingerprint, unsigned long long preorder) {
+	GrammarFingerprint::Fingerprint prefix;
+	unsigned int terminal = fingerprint.getPrefix(preorder, prefix);
+
+	cout << "  " << pFilePath << ": ";
+	if (terminal == GrammarFingerprint::NO_TERMINAL) {
+		cout << "no element (the document has " << preorder
+				<< " elements)" << endl;
+		return;
+	}
+	cout << fingerprint.getElementType(terminal)
+			<< (fingerprint.hasFirstChild(terminal) ? " with" : " without")
+			<< " children, "
+			<< (fingerprint.hasNextSibling(terminal) ? "followed by a sibling"
+					: "last child of its parent") << endl;
+}
+
+/**
+ * prints the help screen to the standard output
+ */
+static void printHelp() {
+	string blank = "  ";
+
+	cout << endl;
+	cout << "TreeRePair is an implementation of the Re-pair for Trees algorithm." << endl;
+	cout << "This tool checks whether two trees which were compressed by TreeRePair" << endl;
+	cout << "are equal without decompressing them." << endl;
+	cout << endl;
+	cout << "Copyright (c) 2010 Roy Mennicke, Build date: " << VERSION << endl;
+	cout << endl;
+	cout << "This is free software.  You may redistribute copies of it under the terms of" << endl;
+	cout << "the GNU General Public License Version 3 which is available at the webpage" << endl;
+	cout << "<http://www.gnu.org/licenses/gpl-3.0.txt>. There is NO WARRANTY." << endl;
+	cout << endl;
+	cout << "Usage: TreeCompare input_file input_file" << endl;
+	cout << "Parameters:" << endl;
+	cout << blank << "input_file" << endl;
+	cout << blank << blank << "input_file must be a valid TreeRePair result file (with extension" << endl;
+	cout << blank << blank << "\"rep\")." << endl;
+	cout << endl;
+	cout << "If the trees differ, the preorder number of the first element (the root" << endl;
+	cout << "element has number 0) at which they differ is printed and the exit status" << endl;
+	cout << "is 1. The trees are compared by fingerprints, i.e., equal trees are" << endl;
+	cout << "reported as equal and different ones as different with high probability." << endl;
+}
+
+int main (int argc, char* args[]) {
+
+	char * pFilePaths[2] = { 0, 0 };
+	unsigned int numberOfFiles = 0;
+
+	for (int i = 1; i < argc; i++) {
+		char * arg = args[i];
+		if (arg[0] == '-') {
+			switch(arg[1]) {
+				case 't': // -textual
+					TreeRePairMode::getInstance()->setUseTextualGrammar(true);
+					break;
+				case '\0':
+					cout << "Unknown switch." << endl;
+				default:
+					cout << "Unknown switch: " << arg << endl;
+
+					printHelp();
+					exit(0);
+					break;
+			}
+		} else if (numberOfFiles < 2) {
+			pFilePaths[numberOfFiles++] = arg;
+		} else {
+			cout << "Please specify exactly two input files." << endl;
+			exit(1);
+		}
+	}
+
+	if (numberOfFiles < 2) {
+		cout << "Please specify two valid input files, i.e., files generated by " << endl;
+		cout << "runs of TreeRePair (with file extension .rep)." << endl;
+		printHelp();
+		exit(1);
+	}
+	for (unsigned int i = 0; i < 2; i++) {
+		if (!Helper::fileExists(pFilePaths[i])) {
+			cout << "The specified input file " << pFilePaths[i]
+					<< " does not exist." << endl;
+			exit(1);
+		}
+	}
+
+	TreeRePairMode::getInstance()->setAlgMode(TreeRePairMode::DECOMPRESS);
+
+	GrammarFingerprint * pFirst = readFingerprint(pFilePaths[0]);
+	GrammarFingerprint * pSecond = readFingerprint(pFilePaths[1]);
+
+	unsigned long long difference =
+			GrammarFingerprint::findFirstDifference(*pFirst, *pSecond);
+	if (difference == GrammarFingerprint::NO_DIFFERENCE) {
+		cout << "The trees are equal (" << pFirst->getNumberOfElements()
+				<< " elements)." << endl;
+	} else {
+		cout << "The trees differ at element " << difference << ":" << endl;
+		printElement(pFilePaths[0], *pFirst, difference);
+		printElement(pFilePaths[1], *pSecond, difference);
+	}
+
+	delete pFirst;
+	delete pSecond;
+	TreeRePairMode::deleteInstance();
+
+	return difference == GrammarFingerprint::NO_DIFFERENCE ? 0 : 1;
+}
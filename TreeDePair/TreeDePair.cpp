@@ -21,8 +21,12 @@
 #include "TreeRePairVersion.h"
 #include "Helper.h"
 
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
 /**
- * prints the help screen to the standard output
+ * prints the help screen to the standard output
  */
 static void printHelp() {
 	string blank = "  ";
@@ -37,12 +41,26 @@ static void printHelp() {
 	cout << "the GNU General Public License Version 3 which is available at the webpage" << endl;
 	cout << "<http://www.gnu.org/licenses/gpl-3.0.txt>. There is NO WARRANTY." << endl;
 	cout << endl;
-	cout << "Usage: TreeDePair [-v] [-p] input_file" << endl;
+	cout << "Usage: TreeDePair [-v] [-p] [-f] [-threads N] [-range START:COUNT | -path PATH]" << endl;
+	cout << "                  input_file" << endl;
 	cout << "Parameters:" << endl;
 	cout << blank << "input_file" << endl;
 	// TODO fix file name extension
 	cout << blank << blank << "input_file must be a valid TreeRePair result file (with extension" << endl;
 	cout << blank << blank << "\"rep\")." << endl;
+	cout << blank << "-f" << endl;
+	cout << blank << blank << "Writes every tag of the decompressed XML document on a new line." << endl;
+	cout << blank << "-threads N" << endl;
+	cout << blank << blank << "Writes the decompressed XML document using N threads (the default" << endl;
+	cout << blank << blank << "is 1)." << endl;
+	cout << blank << "-range START:COUNT" << endl;
+	cout << blank << blank << "Writes only COUNT elements starting with the element with the preorder" << endl;
+	cout << blank << blank << "number START (the root element has number 0). Fails if START is" << endl;
+	cout << blank << blank << "not smaller than the number of elements or COUNT is 0." << endl;
+	cout << blank << "-path PATH" << endl;
+	cout << blank << blank << "Writes only the subtree rooted at the element selected by PATH, e.g.," << endl;
+	cout << blank << blank << "a/b[3]/c selects the first c child of the third b child of the root" << endl;
+	cout << blank << blank << "element a. Fails if PATH does not select an element." << endl;
 	cout << blank << "-p" << endl;
 	cout << blank << blank << "Shows progress during execution." << endl;
 	cout << blank << "-v" << endl;
@@ -68,11 +86,48 @@ int main (int argc, char* args[]) {
 				case 'v': // -v (verbose)
 					TreeRePairMode::getInstance()->setVerboseMode(true);
 					break;
-				case 'p': // -p (progress)
-					TreeRePairMode::getInstance()->setShowProgress(true);
+				case 'f': // -f (formatted output)
+					TreeRePairMode::getInstance()->setFormatOutput(true);
+					break;
+				case 'p':
+					if (arg[2] == 'a') { // -path PATH
+						if (i + 1 >= argc) {
+							cout << "Please specify a path." << endl;
+							exit(1);
+						}
+						TreeRePairMode::getInstance()->setSelectedPath(args[i + 1]);
+						i++;
+					} else { // -p (progress)
+						TreeRePairMode::getInstance()->setShowProgress(true);
+					}
+					break;
+				case 'r': // -range START:COUNT
+					{
+						char * pColon = i + 1 < argc ? strchr(args[i + 1], ':') : 0;
+						if (pColon == 0 || !isdigit(args[i + 1][0])
+								|| !isdigit(pColon[1])
+								|| strtoull(pColon + 1, 0, 10) == 0) {
+							cout << "Please specify a valid range START:COUNT." << endl;
+							exit(1);
+						}
+						TreeRePairMode::getInstance()->setRange(
+								strtoull(args[i + 1], 0, 10),
+								strtoull(pColon + 1, 0, 10));
+						i++;
+					}
 					break;
-				case 't': // -textual
-					TreeRePairMode::getInstance()->setUseTextualGrammar(true);
+				case 't':
+					if (arg[2] == 'h') { // -threads N
+						if (i + 1 >= argc || atoi(args[i + 1]) < 1) {
+							cout << "Please specify a valid number of threads." << endl;
+							exit(1);
+						}
+						TreeRePairMode::getInstance()->setNumberOfThreads(
+								atoi(args[i + 1]));
+						i++;
+					} else { // -textual
+						TreeRePairMode::getInstance()->setUseTextualGrammar(true);
+					}
 					break;
 				case '\0':
 					cout << "Unknown switch." << endl;
@@ -0,0 +1,115 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "AsyncOutputBuffer.h"
+
+#include "TreeRePairConstants.h"
+
+#include <iostream>
+#include <cstdlib>
+
+AsyncOutputBuffer::AsyncOutputBuffer(const string & filePath) :
+	file(filePath.c_str(), ios_base::binary), buffers(2),
+	bufferLengths(2, 0), currentBuffer(0), filledBuffers(2),
+	freeBuffers(2), closed(false), firstWritten(false)
+{
+	if (!file) {
+		cout << "Fatal error: Could not open file " << filePath
+				<< ". Exiting ..." << endl;
+		exit(1);
+	}
+
+	for (unsigned int i = 0; i < buffers.size(); i++) {
+		buffers[i].resize(ASYNC_OUTPUT_BUFFER_SIZE);
+	}
+	freeBuffers.push(1);
+	setp(&buffers[0][0], &buffers[0][0] + buffers[0].size());
+
+	if (pthread_create(&writer, 0, runWriter, this) != 0) {
+		cout << "Fatal error: Could not create thread. Exiting ..." << endl;
+		exit(1);
+	}
+}
+
+AsyncOutputBuffer::~AsyncOutputBuffer(void)
+{
+	close();
+}
+
+void AsyncOutputBuffer::close()
+{
+	if (closed) {
+		return;
+	}
+	closed = true;
+
+	handOver();
+	filledBuffers.push(END_OF_OUTPUT);
+	pthread_join(writer, 0);
+	file.close();
+}
+
+AsyncOutputBuffer::int_type AsyncOutputBuffer::overflow(int_type c)
+{
+	handOver();
+	if (!traits_type::eq_int_type(c, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(c);
+		pbump(1);
+	}
+	return traits_type::not_eof(c);
+}
+
+int AsyncOutputBuffer::sync()
+{
+	// the buffered characters are handed over but not waited for
+	if (pptr() > pbase()) {
+		handOver();
+	}
+	return 0;
+}
+
+void AsyncOutputBuffer::handOver()
+{
+	bufferLengths[currentBuffer] = pptr() - pbase();
+	filledBuffers.push(currentBuffer);
+
+	currentBuffer = freeBuffers.pop();
+	vector<char> & buffer = buffers[currentBuffer];
+	setp(&buffer[0], &buffer[0] + buffer.size());
+}
+
+void * AsyncOutputBuffer::runWriter(void * pBuffer)
+{
+	AsyncOutputBuffer & output = *((AsyncOutputBuffer *) pBuffer);
+
+	unsigned int index;
+	while ((index = output.filledBuffers.pop()) != END_OF_OUTPUT) {
+		if (output.bufferLengths[index] > 0) {
+			output.file.write(&output.buffers[index][0],
+					output.bufferLengths[index]);
+			if (!output.firstWritten) {
+				output.file.flush();
+				clock_gettime(CLOCK_REALTIME, &output.firstWriteTime);
+				output.firstWritten = true;
+			}
+		}
+		output.freeBuffers.push(index);
+	}
+
+	return 0;
+}
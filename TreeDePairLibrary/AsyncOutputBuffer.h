@@ -0,0 +1,113 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "BoundedQueue.h"
+
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <time.h>
+
+using namespace std;
+
+/**
+ * A stream buffer writing to a file in a background thread. The
+ * characters are collected in one of two large buffers. As soon as it
+ * is full, it is handed to the writing thread and the other buffer is
+ * filled in the meantime (double buffering). The buffers are passed
+ * between the threads using bounded lock-free queues.
+ *
+ * This class requires POSIX threads.
+ */
+class AsyncOutputBuffer : public streambuf
+{
+public:
+	/**
+	 * Opens the specified file and starts the writing thread.
+	 */
+	AsyncOutputBuffer(const string & filePath);
+
+	/**
+	 * The destructor closes the file.
+	 */
+	~AsyncOutputBuffer(void);
+
+	/**
+	 * Writes the characters still buffered, waits for the writing thread
+	 * to finish and closes the file.
+	 */
+	void close();
+
+	/**
+	 * Returns the point in time (CLOCK_REALTIME) at which the first
+	 * characters were written to the file. May only be called after
+	 * AsyncOutputBuffer::close().
+	 * @returns false if nothing was written
+	 */
+	bool getFirstWriteTime(timespec & time) {
+		time = firstWriteTime;
+		return firstWritten;
+	};
+
+protected:
+	int_type overflow(int_type c);
+	int sync();
+
+private:
+	/**
+	 * Hands the filled part of the current buffer to the writing thread
+	 * and continues with a free buffer.
+	 */
+	void handOver();
+
+	/**
+	 * The main function of the writing thread.
+	 */
+	static void * runWriter(void * pBuffer);
+
+	/**
+	 * Indicates the end of the output in the queue of filled buffers.
+	 */
+	static const unsigned int END_OF_OUTPUT = 0xFFFFFFFF;
+
+	ofstream file;
+
+	/**
+	 * The buffers and the number of characters filled into each of them.
+	 */
+	vector<vector<char> > buffers;
+	vector<size_t> bufferLengths;
+	unsigned int currentBuffer;
+
+	/**
+	 * The indexes of the buffers to write and of the buffers which may
+	 * be filled again.
+	 */
+	BoundedQueue<unsigned int> filledBuffers;
+	BoundedQueue<unsigned int> freeBuffers;
+
+	pthread_t writer;
+	bool closed;
+
+	bool firstWritten;
+	timespec firstWriteTime;
+};
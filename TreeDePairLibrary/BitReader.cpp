@@ -18,9 +18,12 @@
  */
 #include "BitReader.h"
 
+#include "TreeRePairConstants.h"
 
 BitReader::BitReader(ifstream * pFinPar) :
-	pFin(pFinPar)
+	pFin(pFinPar), buffer(BIT_READER_BUFFER_SIZE), bufferSize(0),
+			bufferPos(0), bitRegister(0), registerBits(0), paddingBits(0),
+			pastEnd(false)
 {
 }
 
@@ -28,28 +31,56 @@ BitReader::~BitReader()
 {
 }
 
-string BitReader::readBitString(unsigned int length, bool lookAhead)
+void BitReader::consume(unsigned int n)
 {
-	char buf, temp;
-	while (strBuf.length() < length) {
-		pFin->read(&buf, 1);
-		for (short int i = 7; i >= 0; i--) {
-			temp = buf;
-			temp |= (0x01 << i);
-
-			if (temp == buf) {
-				strBuf += "1";
-			} else {
-				strBuf += "0";
-			}
-		}
+	while (n > MAX_PEEK_BITS) {
+		consume(MAX_PEEK_BITS);
+		n -= MAX_PEEK_BITS;
+	}
+
+	if (registerBits < n) {
+		refillRegister();
 	}
 
-	string result = strBuf.substr(0, length);
+	// n < 64 since MAX_PEEK_BITS < 64
+	bitRegister <<= n;
+	registerBits -= n;
+
+	if (registerBits < paddingBits) {
+		pastEnd = true;
+		paddingBits = registerBits;
+	}
+}
 
-	if (!lookAhead) {
-		strBuf = strBuf.substr(length, strBuf.length() - length);
+uint64_t BitReader::readBits(unsigned int n)
+{
+	if (n > 32) {
+		uint64_t high = readBits(n - 32);
+		return (high << 32) | readBits(32);
 	}
 
-	return result;
+	uint64_t bits = peek(n);
+	consume(n);
+	return bits;
+}
+
+void BitReader::refillRegister()
+{
+	while (registerBits <= MAX_PEEK_BITS) {
+		if (bufferPos == bufferSize) {
+			pFin->read(&buffer[0], buffer.size());
+			bufferSize = pFin->gcount();
+			bufferPos = 0;
+		}
+
+		uint64_t byte = 0;
+		if (bufferPos < bufferSize) {
+			byte = (unsigned char) buffer[bufferPos++];
+		} else {
+			paddingBits += 8;
+		}
+
+		bitRegister |= byte << (56 - registerBits);
+		registerBits += 8;
+	}
 }
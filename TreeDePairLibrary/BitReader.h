@@ -19,11 +19,18 @@
 #pragma once
 
 #include <fstream>
+#include <vector>
+#include <stdint.h>
 
 using namespace std;
 
 /**
- * This class reads bitwise from an input stream.
+ * This class reads bitwise from an input stream. The input stream is
+ * read in large blocks into a byte buffer. The next bits are kept in a
+ * 64-bit register (the next bit is the most significant one) which is
+ * refilled from the byte buffer. Beyond the end of the input stream
+ * zero bits are returned, absorbing them is recorded (see
+ * BitReader::isPastEnd()).
  */
 class BitReader
 {
@@ -38,26 +45,89 @@ public:
 	virtual ~BitReader();
 
 	/**
-	 * This methods returns a certain number of bits from the input stream
-	 * and optionally reads (i.e., deletes) them from the input stream.
-	 * @param length The number of bits to read. If the end of the input
-	 *  stream is reached, a smaller number of bits is returned.
-	 * @param lookAhead This optional parameter specifies if the bits
-	 * 	read from the input stream shall be absorbed. The default is to
-	 *  not absorbed them, i.e., the next call to this method will
-	 *  return them again.
-	 * @returns the bits read are returned as a string
+	 * Returns the next n bits of the input stream without absorbing them.
+	 * The first bit is the most significant one of the result.
+	 * @param n the number of bits to return (at most
+	 *  BitReader::MAX_PEEK_BITS)
 	 */
-	string readBitString(unsigned int length, bool lookAhead = false);
+	uint64_t peek(unsigned int n) {
+		if (registerBits < n) {
+			refillRegister();
+		}
+		return n == 0 ? 0 : bitRegister >> (64 - n);
+	};
+
+	/**
+	 * Absorbs the next n bits of the input stream.
+	 */
+	void consume(unsigned int n);
+
+	/**
+	 * Reads (i.e., absorbs) the next n bits of the input stream and
+	 * returns them. The first bit is the most significant one of the
+	 * result.
+	 * @param n the number of bits to read (at most 64)
+	 */
+	uint64_t readBits(unsigned int n);
+
+	/**
+	 * Returns true if and only if bits beyond the end of the input
+	 * stream were absorbed, i.e., the input is truncated.
+	 */
+	bool isPastEnd() const { return pastEnd; };
+
+	/**
+	 * The maximal number of bits which can be returned by
+	 * BitReader::peek().
+	 */
+	static const unsigned int MAX_PEEK_BITS = 56;
 
 private:
+	/**
+	 * Moves bytes from the byte buffer to the register until it holds
+	 * more than BitReader::MAX_PEEK_BITS bits.
+	 */
+	void refillRegister();
+
 	/**
 	 * The input stream which is read bitwise.
 	 */
 	ifstream * pFin;
 
 	/**
-	 * The buffer which is used to read the input stream.
+	 * The block of the input stream which is currently read.
+	 */
+	vector<char> buffer;
+
+	/**
+	 * The number of valid bytes in the buffer.
+	 */
+	unsigned int bufferSize;
+
+	/**
+	 * The position of the next byte in the buffer.
+	 */
+	unsigned int bufferPos;
+
+	/**
+	 * The next bits of the input stream, aligned to the most
+	 * significant bit.
+	 */
+	uint64_t bitRegister;
+
+	/**
+	 * The number of valid bits in the register.
+	 */
+	unsigned int registerBits;
+
+	/**
+	 * The number of bits at the end of the register which were filled
+	 * in beyond the end of the input stream.
+	 */
+	unsigned int paddingBits;
+
+	/**
+	 * Specifies if bits beyond the end of the input stream were absorbed.
 	 */
-	string strBuf;
+	bool pastEnd;
 };
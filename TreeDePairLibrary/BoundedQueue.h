@@ -0,0 +1,130 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#if defined(__GNUC__)
+#include <vector>
+#include <sched.h>
+#include <time.h>
+
+using namespace std;
+
+/**
+ * This class template implements a bounded lock-free queue connecting
+ * exactly one producing thread with exactly one consuming thread. The
+ * elements are stored in a ring buffer. The producer only writes the
+ * tail and the consumer only writes the head of the queue, both of
+ * which are published with release semantics. Each side keeps a copy
+ * of the index of the other side and only reloads it if the queue
+ * seems to be full (or empty). A thread which has to wait yields the
+ * processor and sleeps shortly if this happens repeatedly.
+ *
+ * This class requires the atomic built-ins of GCC and is only available
+ * when compiling with GCC.
+ */
+template <class T>
+class BoundedQueue
+{
+public:
+	/**
+	 * The constructor.
+	 * @param capacity the number of elements the queue can hold (it is
+	 *  rounded up to the next power of two)
+	 */
+	BoundedQueue(unsigned int capacity) :
+		head(0), cachedTail(0), tail(0), cachedHead(0)
+	{
+		unsigned int size = 1;
+		while (size < capacity) {
+			size <<= 1;
+		}
+		elements.resize(size);
+		mask = size - 1;
+	};
+
+	/**
+	 * Appends an element to the queue. Waits while the queue is full.
+	 */
+	void push(const T & element) {
+		if (tail - cachedHead > mask) {
+			unsigned int rounds = 0;
+			while (tail - (cachedHead = load(&head)) > mask) {
+				wait(rounds);
+			}
+		}
+		elements[tail & mask] = element;
+		store(&tail, tail + 1);
+	};
+
+	/**
+	 * Removes the first element from the queue. Waits while the queue is
+	 * empty.
+	 */
+	T pop() {
+		if (head == cachedTail) {
+			unsigned int rounds = 0;
+			while (head == (cachedTail = load(&tail))) {
+				wait(rounds);
+			}
+		}
+		T element = elements[head & mask];
+		store(&head, head + 1);
+		return element;
+	};
+
+private:
+	static unsigned long long load(unsigned long long * pIndex) {
+		return __atomic_load_n(pIndex, __ATOMIC_ACQUIRE);
+	};
+
+	static void store(unsigned long long * pIndex, unsigned long long value) {
+		__atomic_store_n(pIndex, value, __ATOMIC_RELEASE);
+	};
+
+	static void wait(unsigned int & rounds) {
+		if (++rounds < 64) {
+			sched_yield();
+		} else {
+			timespec pause = { 0, 50000 };
+			nanosleep(&pause, 0);
+		}
+	};
+
+	vector<T> elements;
+	unsigned long long mask;
+
+	/**
+	 * The index of the next element to pop and the consumer's copy of
+	 * the tail. The padding keeps the indexes of the producer and of the
+	 * consumer in different cache lines.
+	 */
+	char paddingBefore[64];
+	unsigned long long head;
+	unsigned long long cachedTail;
+	char paddingBetween[64];
+
+	/**
+	 * The index of the next element to push and the producer's copy of
+	 * the head.
+	 */
+	unsigned long long tail;
+	unsigned long long cachedHead;
+	char paddingBehind[64];
+};
+#endif
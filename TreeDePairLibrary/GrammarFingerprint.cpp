@@ -0,0 +1,309 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "GrammarFingerprint.h"
+
+#include "Symbol.h"
+#include "TreeNode.h"
+
+#include <iostream>
+#include <cstdlib>
+
+const unsigned int GrammarFingerprint::NO_TERMINAL;
+const unsigned long long GrammarFingerprint::NO_DIFFERENCE;
+const unsigned int GrammarFingerprint::NO_FRAME;
+
+/**
+ * The moduli (primes below 2^32, so that products of residues fit into
+ * 64 bits) and the bases of the polynomial hashes.
+ */
+static const unsigned long long MODULI[2] = { 4294967291ULL, 4294967279ULL };
+static const unsigned long long BASES[2] = { 2654435761ULL, 2246822519ULL };
+
+GrammarFingerprint::GrammarFingerprint(Grammar & dagGrammar,
+		Grammar & mainGrammar) :
+	pIndex(0), currentParameters(0)
+{
+	GrammarIndex index(dagGrammar, mainGrammar);
+	pIndex = &index;
+
+	const vector<unsigned int> & order = index.getOrder();
+	roots.resize(index.size(), 0);
+	ranks.assign(index.size(), 0);
+	terminals.assign(Symbol::counter, NO_TERMINAL);
+
+	vector<unsigned int> children;
+	vector<Fingerprint> fingerprints;
+
+	// bottom-up: the referenced productions are processed first
+	for (unsigned int i = order.size(); i > 0; i--) {
+		unsigned int production = order[i - 1];
+		unsigned int begin = kinds.size();
+
+		// the nodes are appended in preorder
+		currentParameters = 0;
+		childrenCounts.clear();
+		traverseTree(index.getRightHandSide(production));
+		ranks[production] = currentParameters;
+		roots[production] = begin;
+
+		subtreeEnds.resize(kinds.size(), 0);
+		parameterCounts.resize(kinds.size(), 0);
+		pieceBegins.resize(kinds.size(), 0);
+
+		// in reverse preorder, the children are visited before their
+		// parents
+		for (unsigned int j = childrenCounts.size(); j > 0; j--) {
+			unsigned int node = begin + j - 1;
+
+			children.clear();
+			for (unsigned int child = node + 1;
+					children.size() < childrenCounts[j - 1];
+					child = subtreeEnds[child]) {
+				children.push_back(child);
+			}
+			subtreeEnds[node] = children.empty()
+					? node + 1 : subtreeEnds[children.back()];
+
+			fingerprints.clear();
+			if (kinds[node] == PARAMETER) {
+				parameterCounts[node] = 1;
+				fingerprints.push_back(getEmptyFingerprint());
+				fingerprints.push_back(getEmptyFingerprint());
+			} else if (kinds[node] == NONTERMINAL) {
+				// the pieces of the referenced production alternate with
+				// the arguments
+				const Fingerprint * pReferenced =
+						&pieces[pieceBegins[roots[labels[node]]]];
+				fingerprints.push_back(pReferenced[0]);
+				for (unsigned int k = 0; k < children.size(); k++) {
+					parameterCounts[node] += parameterCounts[children[k]];
+					appendPieces(fingerprints, &pieces[pieceBegins[children[k]]],
+							parameterCounts[children[k]] + 1);
+					appendPieces(fingerprints, &pReferenced[k + 1], 1);
+				}
+			} else {
+				fingerprints.push_back(terminalFingerprints[labels[node]]);
+				for (unsigned int k = 0; k < children.size(); k++) {
+					parameterCounts[node] += parameterCounts[children[k]];
+					appendPieces(fingerprints, &pieces[pieceBegins[children[k]]],
+							parameterCounts[children[k]] + 1);
+				}
+			}
+
+			pieceBegins[node] = pieces.size();
+			pieces.insert(pieces.end(), fingerprints.begin(), fingerprints.end());
+		}
+	}
+
+	// the grammar may be deleted afterwards
+	pIndex = 0;
+	vector<unsigned int>().swap(ranks);
+	vector<unsigned int>().swap(terminals);
+	vector<unsigned int>().swap(childrenCounts);
+}
+
+GrammarFingerprint::~GrammarFingerprint(void)
+{
+}
+
+void GrammarFingerprint::preVisit(TreeNode * pNode, unsigned int index,
+		int depth)
+{
+	Symbol * pSymbol = pNode->getSymbol();
+	unsigned int referenced = pIndex->getProduction(pSymbol);
+
+	childrenCounts.push_back(pNode->getCurrentChildrenCount());
+	firstParameters.push_back(currentParameters);
+	if (pSymbol == Symbol::getParameterSymbol()) {
+		kinds.push_back(PARAMETER);
+		labels.push_back(currentParameters++);
+	} else if (referenced != GrammarIndex::NO_PRODUCTION) {
+		if (ranks[referenced] != pNode->getCurrentChildrenCount()) {
+			cout << "Fatal error: The rank of a nonterminal does not "
+				"match the number of parameters of its production. "
+				"Exiting ..." << endl;
+			exit(1);
+		}
+		kinds.push_back(NONTERMINAL);
+		labels.push_back(referenced);
+	} else {
+		unsigned int id = pSymbol->getId();
+		if (terminals[id] == NO_TERMINAL) {
+			terminals[id] = addTerminal(Symbol::getElementTypeById(id),
+					pSymbol->hasLeftChild(), pSymbol->hasRightChild());
+		}
+		kinds.push_back(TERMINAL);
+		labels.push_back(terminals[id]);
+	}
+}
+
+unsigned int GrammarFingerprint::getPrefix(unsigned long long length,
+		Fingerprint & prefix)
+{
+	prefix = getEmptyFingerprint();
+
+	// the nodes still to visit together with the frames of the
+	// applications they belong to; a node is skipped as a whole if its
+	// expanded subtree fits into the prefix
+	vector<Frame> frames(1);
+	frames.back().caller = NO_FRAME;
+	vector<pair<unsigned int, unsigned int> > nodes;
+	nodes.push_back(make_pair(roots.back(), 0));
+
+	while (!nodes.empty()) {
+		unsigned int node = nodes.back().first;
+		unsigned int frame = nodes.back().second;
+		nodes.pop_back();
+
+		Fingerprint fingerprint = getFingerprint(node, frames[frame].arguments);
+		if (prefix.length + fingerprint.length <= length) {
+			append(prefix, fingerprint);
+			continue;
+		}
+
+		if (kinds[node] == PARAMETER) {
+			nodes.push_back(make_pair(
+					frames[frame].argumentNodes[labels[node]],
+					frames[frame].caller));
+			continue;
+		}
+
+		vector<unsigned int> children;
+		for (unsigned int child = node + 1; child < subtreeEnds[node];
+				child = subtreeEnds[child]) {
+			children.push_back(child);
+		}
+
+		if (kinds[node] == NONTERMINAL) {
+			Frame referenced;
+			referenced.caller = frame;
+			referenced.argumentNodes = children;
+			for (unsigned int k = 0; k < children.size(); k++) {
+				referenced.arguments.push_back(
+						getFingerprint(children[k], frames[frame].arguments));
+			}
+			frames.push_back(referenced);
+			nodes.push_back(make_pair(roots[labels[node]], frames.size() - 1));
+			continue;
+		}
+
+		if (prefix.length == length) {
+			return labels[node];
+		}
+		append(prefix, terminalFingerprints[labels[node]]);
+		for (unsigned int k = children.size(); k > 0; k--) {
+			nodes.push_back(make_pair(children[k - 1], frame));
+		}
+	}
+
+	return NO_TERMINAL;
+}
+
+unsigned long long GrammarFingerprint::findFirstDifference(
+		GrammarFingerprint & first, GrammarFingerprint & second)
+{
+	if (first.getFingerprint() == second.getFingerprint()) {
+		return NO_DIFFERENCE;
+	}
+
+	// the longest common prefix is searched for by binary search
+	unsigned long long low = 0;
+	unsigned long long high = min(first.getNumberOfElements(),
+			second.getNumberOfElements());
+	Fingerprint firstPrefix, secondPrefix;
+	while (low < high) {
+		unsigned long long middle = low + (high - low + 1) / 2;
+		first.getPrefix(middle, firstPrefix);
+		second.getPrefix(middle, secondPrefix);
+		if (firstPrefix == secondPrefix) {
+			low = middle;
+		} else {
+			high = middle - 1;
+		}
+	}
+
+	return low;
+}
+
+GrammarFingerprint::Fingerprint GrammarFingerprint::getEmptyFingerprint()
+{
+	Fingerprint fingerprint;
+	for (unsigned int i = 0; i < 2; i++) {
+		fingerprint.hashes[i] = 0;
+		fingerprint.powers[i] = 1;
+	}
+	fingerprint.length = 0;
+	return fingerprint;
+}
+
+void GrammarFingerprint::append(Fingerprint & fingerprint,
+		const Fingerprint & suffix)
+{
+	for (unsigned int i = 0; i < 2; i++) {
+		fingerprint.hashes[i] = (fingerprint.hashes[i] * suffix.powers[i]
+				+ suffix.hashes[i]) % MODULI[i];
+		fingerprint.powers[i] = fingerprint.powers[i] * suffix.powers[i]
+				% MODULI[i];
+	}
+	fingerprint.length += suffix.length;
+}
+
+void GrammarFingerprint::appendPieces(vector<Fingerprint> & fingerprints,
+		const Fingerprint * pSuffixes, unsigned int count)
+{
+	append(fingerprints.back(), pSuffixes[0]);
+	fingerprints.insert(fingerprints.end(), pSuffixes + 1, pSuffixes + count);
+}
+
+GrammarFingerprint::Fingerprint GrammarFingerprint::getFingerprint(
+		unsigned int node, const vector<Fingerprint> & arguments)
+{
+	Fingerprint fingerprint = pieces[pieceBegins[node]];
+	for (unsigned int k = 0; k < parameterCounts[node]; k++) {
+		append(fingerprint, arguments[firstParameters[node] + k]);
+		append(fingerprint, pieces[pieceBegins[node] + k + 1]);
+	}
+	return fingerprint;
+}
+
+unsigned int GrammarFingerprint::addTerminal(const string & elementType,
+		bool firstChild, bool nextSibling)
+{
+	// FNV-1a of the element type and the children characteristics
+	unsigned long long value = 14695981039346656037ULL;
+	string key = elementType;
+	key += (char) ((firstChild ? 2 : 0) | (nextSibling ? 1 : 0));
+	for (unsigned int i = 0; i < key.size(); i++) {
+		value ^= (unsigned char) key[i];
+		value *= 1099511628211ULL;
+	}
+
+	Fingerprint fingerprint;
+	for (unsigned int i = 0; i < 2; i++) {
+		fingerprint.hashes[i] = value % MODULI[i];
+		fingerprint.powers[i] = BASES[i];
+	}
+	fingerprint.length = 1;
+
+	elementTypes.push_back(elementType);
+	hasFirstChildren.push_back(firstChild);
+	hasNextSiblings.push_back(nextSibling);
+	terminalFingerprints.push_back(fingerprint);
+	return elementTypes.size() - 1;
+}
@@ -0,0 +1,237 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "Grammar.h"
+#include "GrammarIndex.h"
+#include "StaticTreeTraversal.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Computes a fingerprint of the XML document represented by a linear
+ * SLCF tree grammar without decompressing it. Two documents are equal
+ * (with high probability) if their fingerprints are equal.
+ *
+ * The document is identified with the sequence of the terminal symbols
+ * of its binary tree in preorder, where a terminal symbol consists of
+ * the element type and the information whether the element has a first
+ * child and a next sibling (this sequence determines the tree). The
+ * fingerprint of a sequence consists of its length and of two
+ * polynomial hashes of it, so the fingerprint of a concatenation is
+ * computed from the fingerprints of its parts.
+ *
+ * The expanded subtree of every node of a right-hand side is a sequence
+ * interrupted by the arguments of the parameters below the node. The
+ * fingerprints of its pieces between the parameters are computed
+ * bottom-up in time linear in the size of the grammar. They are copied
+ * together with the structure of the right-hand sides, so the grammar
+ * (and its symbols) may be deleted afterwards. This allows to compute
+ * the fingerprint of every prefix of the document by descending into
+ * the grammar and thereby to find the first element at which two
+ * documents differ by binary search.
+ */
+class GrammarFingerprint : public StaticTreeTraversal<GrammarFingerprint>
+{
+	friend class StaticTreeTraversal<GrammarFingerprint>;
+
+public:
+	/**
+	 * The fingerprint of a sequence of terminal symbols.
+	 */
+	struct Fingerprint {
+		unsigned long long hashes[2];
+
+		/**
+		 * The powers of the bases of the hashes to the length of the
+		 * sequence.
+		 */
+		unsigned long long powers[2];
+		unsigned long long length;
+
+		bool operator==(const Fingerprint & other) const {
+			return length == other.length && hashes[0] == other.hashes[0]
+					&& hashes[1] == other.hashes[1];
+		};
+
+		bool operator!=(const Fingerprint & other) const {
+			return !(*this == other);
+		};
+	};
+
+	/**
+	 * Indicates that there is no terminal symbol at a position (and that
+	 * two documents do not differ).
+	 */
+	static const unsigned int NO_TERMINAL = 0xFFFFFFFF;
+	static const unsigned long long NO_DIFFERENCE = 0xFFFFFFFFFFFFFFFFULL;
+
+	/**
+	 * The constructor computes the fingerprints.
+	 * @param dagGrammar the grammar containing the start production
+	 * @param mainGrammar the grammar containing the remaining productions
+	 */
+	GrammarFingerprint(Grammar & dagGrammar, Grammar & mainGrammar);
+	~GrammarFingerprint(void);
+
+	/**
+	 * Returns the fingerprint of the document.
+	 */
+	const Fingerprint & getFingerprint() { return pieces[pieceBegins[roots.back()]]; };
+
+	/**
+	 * Returns the number of elements of the document.
+	 */
+	unsigned long long getNumberOfElements() { return getFingerprint().length; };
+
+	/**
+	 * Computes the fingerprint of the first elements of the document (in
+	 * preorder) and returns the terminal symbol of the next element (or
+	 * NO_TERMINAL if there is none).
+	 * @param length the number of elements of the prefix
+	 * @param prefix receives the fingerprint of the prefix
+	 */
+	unsigned int getPrefix(unsigned long long length, Fingerprint & prefix);
+
+	string getElementType(unsigned int terminal) { return elementTypes[terminal]; };
+	bool hasFirstChild(unsigned int terminal) { return hasFirstChildren[terminal]; };
+	bool hasNextSibling(unsigned int terminal) { return hasNextSiblings[terminal]; };
+
+	/**
+	 * Returns the preorder number of the first element at which the
+	 * specified documents differ (which is the number of elements of the
+	 * shorter document if it is a prefix of the other one) or
+	 * NO_DIFFERENCE if they are equal.
+	 */
+	static unsigned long long findFirstDifference(GrammarFingerprint & first,
+			GrammarFingerprint & second);
+
+protected:
+	/**
+	 * Appends the current node of a right-hand side to the nodes.
+	 */
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
+
+private:
+	/**
+	 * The kinds of the nodes of the right-hand sides.
+	 */
+	enum NodeKind { TERMINAL, NONTERMINAL, PARAMETER };
+
+	/**
+	 * An application of a production visited by getPrefix().
+	 */
+	struct Frame {
+		/**
+		 * The frame of the application containing the nonterminal node
+		 * or NO_FRAME for the start production.
+		 */
+		unsigned int caller;
+
+		/**
+		 * The arguments (nodes of the right-hand side of the caller) and
+		 * their fingerprints.
+		 */
+		vector<unsigned int> argumentNodes;
+		vector<Fingerprint> arguments;
+	};
+
+	static const unsigned int NO_FRAME = 0xFFFFFFFF;
+
+	/**
+	 * Returns the fingerprint of the empty sequence.
+	 */
+	static Fingerprint getEmptyFingerprint();
+
+	/**
+	 * Appends the second fingerprint to the first one.
+	 */
+	static void append(Fingerprint & fingerprint, const Fingerprint & suffix);
+
+	/**
+	 * Appends the specified pieces to the specified pieces, i.e., the
+	 * first one is appended to the last piece of the latter.
+	 */
+	static void appendPieces(vector<Fingerprint> & fingerprints,
+			const Fingerprint * pSuffixes, unsigned int count);
+
+	/**
+	 * Returns the fingerprint of the expanded subtree of the specified
+	 * node given the fingerprints of the arguments of the application.
+	 */
+	Fingerprint getFingerprint(unsigned int node,
+			const vector<Fingerprint> & arguments);
+
+	/**
+	 * Returns the index of the terminal symbol of the specified element
+	 * type and children characteristics (which is added if necessary).
+	 */
+	unsigned int addTerminal(const string & elementType, bool firstChild,
+			bool nextSibling);
+
+	/**
+	 * The terminal symbols: the element types, the children
+	 * characteristics and the fingerprints of the one-element sequences.
+	 */
+	vector<string> elementTypes;
+	vector<bool> hasFirstChildren;
+	vector<bool> hasNextSiblings;
+	vector<Fingerprint> terminalFingerprints;
+
+	/**
+	 * The nodes of the right-hand sides in preorder: the kind, the
+	 * terminal symbol, production or parameter number, the index
+	 * following the last node of the subtree and the number of the first
+	 * parameter and of the parameters of the subtree.
+	 */
+	vector<unsigned char> kinds;
+	vector<unsigned int> labels;
+	vector<unsigned int> subtreeEnds;
+	vector<unsigned int> firstParameters;
+	vector<unsigned int> parameterCounts;
+
+	/**
+	 * By node: the index of the fingerprint of the first piece of its
+	 * expanded subtree (a subtree with k parameters has k + 1 pieces).
+	 */
+	vector<unsigned int> pieceBegins;
+	vector<Fingerprint> pieces;
+
+	/**
+	 * By production: the root of the right-hand side (the start
+	 * production comes last).
+	 */
+	vector<unsigned int> roots;
+
+	/**
+	 * The state of the constructor while traversing a right-hand side:
+	 * the numbers of the productions, the number of parameters visited,
+	 * the ranks of the productions visited, the terminal symbols by
+	 * symbol id (or NO_TERMINAL) and the numbers of children of the
+	 * nodes visited.
+	 */
+	GrammarIndex * pIndex;
+	unsigned int currentParameters;
+	vector<unsigned int> ranks;
+	vector<unsigned int> terminals;
+	vector<unsigned int> childrenCounts;
+};
@@ -0,0 +1,92 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "GrammarIndex.h"
+
+#include "Production.h"
+
+#include <deque>
+#include <iostream>
+#include <cstdlib>
+
+const unsigned int GrammarIndex::NO_PRODUCTION;
+
+GrammarIndex::GrammarIndex(Grammar & dagGrammar, Grammar & mainGrammar) :
+	currentProduction(0)
+{
+	productions.assign(Symbol::counter, NO_PRODUCTION);
+	for (unsigned int i = 0; i < mainGrammar.size(); i++) {
+		productions[mainGrammar[i]->getLeftHandSide()->getId()] =
+				rightHandSides.size();
+		rightHandSides.push_back(mainGrammar[i]->getRightHandSide());
+	}
+	rightHandSides.push_back(dagGrammar[0]->getRightHandSide());
+
+	unsigned int size = rightHandSides.size();
+	referencedProductions.resize(size);
+	pendingReferences.assign(size, 0);
+
+	for (currentProduction = 0; currentProduction < size; currentProduction++) {
+		traverseTree(rightHandSides[currentProduction]);
+	}
+
+	// a production is placed after all productions referencing it
+	order.reserve(size);
+	deque<unsigned int> readyProductions;
+	for (unsigned int i = size; i > 0; i--) {
+		if (pendingReferences[i - 1] == 0) {
+			readyProductions.push_back(i - 1);
+		}
+	}
+
+	while (!readyProductions.empty()) {
+		unsigned int production = readyProductions.front();
+		readyProductions.pop_front();
+		order.push_back(production);
+
+		vector<unsigned int> & referenced = referencedProductions[production];
+		for (unsigned int j = 0; j < referenced.size(); j++) {
+			if (--pendingReferences[referenced[j]] == 0) {
+				readyProductions.push_back(referenced[j]);
+			}
+		}
+	}
+
+	if (order.size() != size) {
+		cout << "Fatal error: The productions of the grammar are cyclic. "
+			"Exiting ..." << endl;
+		exit(1);
+	}
+
+	// the references are only needed for ordering the productions
+	vector<vector<unsigned int> >().swap(referencedProductions);
+	vector<unsigned int>().swap(pendingReferences);
+}
+
+GrammarIndex::~GrammarIndex(void)
+{
+}
+
+void GrammarIndex::preVisit(TreeNode * pNode, unsigned int index, int depth)
+{
+	unsigned int referenced = getProduction(pNode->getSymbol());
+	if (referenced != NO_PRODUCTION) {
+		referencedProductions[currentProduction].push_back(referenced);
+		pendingReferences[referenced]++;
+	}
+}
@@ -0,0 +1,120 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "Grammar.h"
+#include "StaticTreeTraversal.h"
+#include "Symbol.h"
+#include "TreeNode.h"
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * Numbers the productions of a linear SLCF tree grammar consisting of a
+ * start production and the remaining productions (the start production
+ * gets the highest number) and orders them topologically. This is the
+ * common basis of the classes computing something bottom-up (or
+ * top-down) over the productions without expanding them.
+ */
+class GrammarIndex : public StaticTreeTraversal<GrammarIndex>
+{
+	friend class StaticTreeTraversal<GrammarIndex>;
+
+public:
+	/**
+	 * The constructor.
+	 * @param dagGrammar the grammar containing the start production
+	 * @param mainGrammar the grammar containing the remaining productions
+	 */
+	GrammarIndex(Grammar & dagGrammar, Grammar & mainGrammar);
+	~GrammarIndex(void);
+
+	/**
+	 * Indicates that a symbol is not the left-hand side of a production.
+	 */
+	static const unsigned int NO_PRODUCTION = 0xFFFFFFFF;
+
+	/**
+	 * Returns the number of productions (including the start production).
+	 */
+	unsigned int size() { return rightHandSides.size(); };
+
+	/**
+	 * Returns the number of the start production.
+	 */
+	unsigned int getStartProduction() { return rightHandSides.size() - 1; };
+
+	TreeNode * getRightHandSide(unsigned int production) {
+		return rightHandSides[production];
+	};
+
+	/**
+	 * Returns the number of the production whose left-hand side is the
+	 * specified symbol or NO_PRODUCTION for terminal and parameter
+	 * symbols.
+	 */
+	unsigned int getProduction(Symbol * pSymbol) {
+		return pSymbol->getId() < productions.size()
+				? productions[pSymbol->getId()] : NO_PRODUCTION;
+	};
+
+	/**
+	 * Returns the numbers of the productions in topological order, i.e.,
+	 * every production is placed before the productions it references
+	 * (the start production comes first).
+	 */
+	const vector<unsigned int> & getOrder() { return order; };
+
+protected:
+	/**
+	 * Records the references of the current production.
+	 */
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
+
+private:
+	/**
+	 * The right-hand sides of the productions by number.
+	 */
+	vector<TreeNode *> rightHandSides;
+
+	/**
+	 * The numbers of the productions by the ids of their left-hand sides.
+	 */
+	vector<unsigned int> productions;
+
+	vector<unsigned int> order;
+
+	/**
+	 * The production whose right-hand side is traversed.
+	 */
+	unsigned int currentProduction;
+
+	/**
+	 * The numbers of the productions referenced by a production (once
+	 * per reference).
+	 */
+	vector<vector<unsigned int> > referencedProductions;
+
+	/**
+	 * The number of references to a production which are not placed yet.
+	 */
+	vector<unsigned int> pendingReferences;
+};
@@ -0,0 +1,383 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "GrammarNavigator.h"
+
+#include <iostream>
+#include <cstdlib>
+
+GrammarNavigator::GrammarNavigator(Grammar & dagGrammar, Grammar & mainGrammar) :
+	index(dagGrammar, mainGrammar), numberOfElements(0), currentElements(0),
+	currentParameters(0)
+{
+	unsigned int size = index.size();
+	eventBegins.resize(size, 0);
+	eventEnds.resize(size, 0);
+	ranks.resize(size, 0);
+	parameterBegins.resize(size, 0);
+	segmentBegins.resize(size, 0);
+
+	firstEvents.resize(TreeNode::idCounter, 0);
+	endEvents.resize(TreeNode::idCounter, 0);
+	siblingChainTops.resize(TreeNode::idCounter, 0);
+
+	// the referenced productions are flattened first
+	const vector<unsigned int> & order = index.getOrder();
+	for (unsigned int i = order.size(); i > 0; i--) {
+		flatten(order[i - 1]);
+	}
+
+	unsigned int startProduction = index.getStartProduction();
+	numberOfElements = elementsBefore[eventEnds[startProduction]];
+}
+
+GrammarNavigator::~GrammarNavigator(void)
+{
+}
+
+void GrammarNavigator::flatten(unsigned int production)
+{
+	TreeNode * pRoot = index.getRightHandSide(production);
+
+	eventBegins[production] = eventNodes.size();
+	parameterBegins[production] = parameterNodes.size();
+	segmentBegins[production] = segmentLengths.size();
+
+	currentElements = 0;
+	currentParameters = 0;
+	traverseTree(pRoot);
+
+	// the sentinel event
+	eventEnds[production] = eventNodes.size();
+	eventNodes.push_back(0);
+	elementsBefore.push_back(currentElements);
+	parametersBefore.push_back(currentParameters);
+
+	// the parameters are numbered in preorder, i.e., in the order of
+	// their events
+	ranks[production] = currentParameters;
+	unsigned long long previous = 0;
+	for (unsigned int j = 0; j < currentParameters; j++) {
+		TreeNode * pParameter = parameterNodes[parameterBegins[production] + j];
+		unsigned long long before = elementsBefore[firstEvents[pParameter->getId()]];
+		segmentLengths.push_back(before - previous);
+		previous = before;
+		hasFirstChildEdges.push_back(siblingChainTops[pParameter->getId()] != pRoot);
+	}
+	segmentLengths.push_back(currentElements - previous);
+}
+
+void GrammarNavigator::preVisit(TreeNode * pNode, unsigned int childIndex,
+		int depth)
+{
+	unsigned int id = pNode->getId();
+	firstEvents[id] = eventNodes.size();
+	siblingChainTops[id] = childIndex == UINT_MAX || !isSiblingEdge(pNode)
+			? pNode : siblingChainTops[pNode->getParent()->getId()];
+
+	Symbol * pSymbol = pNode->getSymbol();
+	unsigned int referenced = index.getProduction(pSymbol);
+	if (pSymbol == Symbol::getParameterSymbol()) {
+		addEvent(pNode, 0);
+		parameterNodes.push_back(pNode);
+		currentParameters++;
+	} else if (referenced != GrammarIndex::NO_PRODUCTION) {
+		if (ranks[referenced] != pNode->getCurrentChildrenCount()) {
+			cout << "Fatal error: The rank of a nonterminal does not "
+				"match the number of parameters of its production. "
+				"Exiting ..." << endl;
+			exit(1);
+		}
+		addEvent(pNode, segmentLengths[segmentBegins[referenced]]);
+	} else {
+		addEvent(pNode, 1);
+	}
+}
+
+void GrammarNavigator::visitEdge(TreeNode * pParent, unsigned int childIndex,
+		TreeNode * pChild)
+{
+	// the segments and the arguments alternate
+	unsigned int referenced = index.getProduction(pParent->getSymbol());
+	if (childIndex > 0 && referenced != GrammarIndex::NO_PRODUCTION) {
+		addEvent(pParent, segmentLengths[segmentBegins[referenced] + childIndex]);
+	}
+}
+
+void GrammarNavigator::postVisit(TreeNode * pNode, unsigned int childIndex,
+		int depth)
+{
+	unsigned int children = pNode->getCurrentChildrenCount();
+	unsigned int referenced = index.getProduction(pNode->getSymbol());
+	if (children > 0 && referenced != GrammarIndex::NO_PRODUCTION) {
+		addEvent(pNode, segmentLengths[segmentBegins[referenced] + children]);
+	}
+	endEvents[pNode->getId()] = eventNodes.size();
+}
+
+void GrammarNavigator::addEvent(TreeNode * pNode, unsigned long long weight)
+{
+	eventNodes.push_back(pNode);
+	elementsBefore.push_back(currentElements);
+	parametersBefore.push_back(currentParameters);
+	currentElements += weight;
+}
+
+bool GrammarNavigator::isSiblingEdge(TreeNode * pNode)
+{
+	TreeNode * pParent = pNode->getParent();
+	unsigned int referenced = index.getProduction(pParent->getSymbol());
+	if (referenced != GrammarIndex::NO_PRODUCTION) {
+		return !hasFirstChildEdges[parameterBegins[referenced] + pNode->getIndex()];
+	} else {
+		return !pParent->getSymbol()->hasLeftChild() || pNode->getIndex() != 0;
+	}
+}
+
+void GrammarNavigator::push(Position & position, TreeNode * pCallNode)
+{
+	Frame frame;
+	frame.pCallNode = pCallNode;
+	frame.production = index.getProduction(pCallNode->getSymbol());
+	frame.base = getValue(position, firstEvents[pCallNode->getId()]);
+	frame.arguments = position.argumentSums.size();
+
+	// the arguments are evaluated in the frame of the call node
+	unsigned long long sum = 0;
+	position.argumentSums.push_back(sum);
+	for (unsigned int j = 0; j < ranks[frame.production]; j++) {
+		TreeNode * pArgument = pCallNode->getChild(j);
+		sum += getValue(position, endEvents[pArgument->getId()])
+				- getValue(position, firstEvents[pArgument->getId()]);
+		position.argumentSums.push_back(sum);
+	}
+
+	position.frames.push_back(frame);
+}
+
+void GrammarNavigator::descend(Position & position, TreeNode * pNode)
+{
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+
+	while (true) {
+		Symbol * pSymbol = pNode->getSymbol();
+		if (pSymbol == pParameterSymbol) {
+			unsigned int parameter = parametersBefore[firstEvents[pNode->getId()]];
+			TreeNode * pCallNode = position.frames.back().pCallNode;
+			pop(position);
+			pNode = pCallNode->getChild(parameter);
+			continue;
+		}
+
+		unsigned int referenced = index.getProduction(pSymbol);
+		if (referenced != GrammarIndex::NO_PRODUCTION) {
+			push(position, pNode);
+			pNode = index.getRightHandSide(referenced);
+			continue;
+		}
+
+		position.pNode = pNode;
+		return;
+	}
+}
+
+void GrammarNavigator::reset(Position & position)
+{
+	Frame frame;
+	frame.pCallNode = 0;
+	frame.production = index.getStartProduction();
+	frame.base = 0;
+	frame.arguments = 0;
+
+	position.frames.clear();
+	position.frames.push_back(frame);
+	position.argumentSums.assign(1, 0);
+}
+
+bool GrammarNavigator::moveToRoot(Position & position)
+{
+	if (numberOfElements == 0) {
+		return false;
+	}
+
+	reset(position);
+	descend(position, index.getRightHandSide(index.getStartProduction()));
+	return true;
+}
+
+bool GrammarNavigator::moveToFirstChild(Position & position)
+{
+	TreeNode * pNode = position.pNode;
+	if (!pNode->getSymbol()->hasLeftChild()) {
+		return false;
+	}
+
+	descend(position, pNode->getChild(0));
+	return true;
+}
+
+bool GrammarNavigator::moveToNextSibling(Position & position)
+{
+	TreeNode * pNode = position.pNode;
+	Symbol * pSymbol = pNode->getSymbol();
+	if (!pSymbol->hasRightChild()) {
+		return false;
+	}
+
+	descend(position, pNode->getChild(pSymbol->hasLeftChild() ? 1 : 0));
+	return true;
+}
+
+bool GrammarNavigator::moveToParent(Position & position)
+{
+	unsigned long long preorder = getPreorder(position);
+	TreeNode * pNode = position.pNode;
+
+	// we move upwards along the edges to next siblings until we reach
+	// an edge to a first child (whose upper end is the parent)
+	while (true) {
+		pNode = siblingChainTops[pNode->getId()];
+
+		if (pNode == index.getRightHandSide(position.frames.back().production)) {
+			if (position.frames.size() == 1) {
+				// the element is the root element (or one of its siblings)
+				moveToPreorder(position, preorder);
+				return false;
+			}
+			pNode = position.frames.back().pCallNode;
+			pop(position);
+			continue;
+		}
+
+		TreeNode * pParent = pNode->getParent();
+		unsigned int referenced = index.getProduction(pParent->getSymbol());
+		if (referenced == GrammarIndex::NO_PRODUCTION) {
+			position.pNode = pParent;
+			return true;
+		}
+
+		// the edge to the first child lies within the expanded
+		// right-hand side of the referenced production
+		push(position, pParent);
+		pNode = parameterNodes[parameterBegins[referenced] + pNode->getIndex()];
+	}
+}
+
+bool GrammarNavigator::moveToPreorder(Position & position,
+		unsigned long long preorder)
+{
+	if (preorder >= numberOfElements) {
+		return false;
+	}
+
+	reset(position);
+
+	while (true) {
+		unsigned int production = position.frames.back().production;
+
+		// we look for the last event of the production which is preceded
+		// by at most preorder elements; the element is never generated
+		// by an argument since we came down from the root
+		unsigned int low = eventBegins[production];
+		unsigned int high = eventEnds[production];
+		while (high - low > 1) {
+			unsigned int middle = low + (high - low) / 2;
+			if (getValue(position, middle) <= preorder) {
+				low = middle;
+			} else {
+				high = middle;
+			}
+		}
+
+		TreeNode * pNode = eventNodes[low];
+		if (index.getProduction(pNode->getSymbol()) == GrammarIndex::NO_PRODUCTION) {
+			position.pNode = pNode;
+			return true;
+		}
+		push(position, pNode);
+	}
+}
+
+unsigned long long GrammarNavigator::getSubtreeSize(const Position & position)
+{
+	TreeNode * pNode = position.pNode;
+	if (!pNode->getSymbol()->hasLeftChild()) {
+		return 1;
+	}
+
+	TreeNode * pFirstChild = pNode->getChild(0);
+	return 1 + getValue(position, endEvents[pFirstChild->getId()])
+			- getValue(position, firstEvents[pFirstChild->getId()]);
+}
+
+bool GrammarNavigator::moveToPath(Position & position, const string & path)
+{
+	// the steps are parsed first to reject malformed paths right away
+	vector<pair<string, unsigned long long> > steps;
+	string::size_type begin = path.size() > 0 && path[0] == '/' ? 1 : 0;
+	while (begin <= path.size()) {
+		string::size_type end = path.find('/', begin);
+		if (end == string::npos) {
+			end = path.size();
+		}
+
+		string step = path.substr(begin, end - begin);
+		unsigned long long number = 1;
+		string::size_type bracket = step.find('[');
+		if (bracket != string::npos) {
+			if (step[step.size() - 1] != ']') {
+				return false;
+			}
+			string digits = step.substr(bracket + 1, step.size() - bracket - 2);
+			if (digits.empty()
+					|| digits.find_first_not_of("0123456789") != string::npos) {
+				return false;
+			}
+			number = strtoull(digits.c_str(), 0, 10);
+			step.erase(bracket);
+		}
+		if (step.empty() || number == 0) {
+			return false;
+		}
+
+		steps.push_back(make_pair(step, number));
+		begin = end + 1;
+	}
+
+	Position current;
+	if (!moveToRoot(current) || getElementType(current) != steps[0].first
+			|| steps[0].second != 1) {
+		return false;
+	}
+
+	for (unsigned int i = 1; i < steps.size(); i++) {
+		if (!moveToFirstChild(current)) {
+			return false;
+		}
+
+		unsigned long long remaining = steps[i].second;
+		while (getElementType(current) != steps[i].first || --remaining > 0) {
+			if (!moveToNextSibling(current)) {
+				return false;
+			}
+		}
+	}
+
+	position = current;
+	return true;
+}
@@ -0,0 +1,312 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "Grammar.h"
+#include "GrammarIndex.h"
+#include "StaticTreeTraversal.h"
+#include "Symbol.h"
+#include "TreeNode.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Navigates the XML document represented by a linear SLCF tree grammar
+ * without decompressing it. The elements are addressed by their
+ * preorder numbers (the root element has number 0).
+ *
+ * An element is a terminal node of the binary tree obtained by expanding
+ * the start production. It is represented by a Position, i.e., by the
+ * terminal node of a right-hand side together with the stack of the
+ * applications of productions (frames) leading to it. Moving to the first
+ * child, the next sibling or the parent of an element and moving to the
+ * element with a given preorder number pushes and pops at most as many
+ * frames as the grammar is deep.
+ *
+ * To this end, the right-hand side of every production is flattened into
+ * a sequence of events in preorder: an event for every terminal node, an
+ * event for every parameter and, for every nonterminal node, an event for
+ * every segment of the expanded right-hand side of the referenced
+ * production between its parameters. The number of elements preceding an
+ * event is precomputed except for the elements generated by the
+ * parameters, which are summed up when a frame is pushed.
+ */
+class GrammarNavigator : public StaticTreeTraversal<GrammarNavigator>
+{
+	friend class StaticTreeTraversal<GrammarNavigator>;
+
+public:
+	/**
+	 * An application of a production.
+	 */
+	struct Frame {
+		/**
+		 * The nonterminal node which is expanded or 0 for the start
+		 * production.
+		 */
+		TreeNode * pCallNode;
+		unsigned int production;
+
+		/**
+		 * The preorder number of the first element generated by the
+		 * application.
+		 */
+		unsigned long long base;
+
+		/**
+		 * The index of the first of the prefix sums of the numbers of
+		 * elements generated by the arguments of the application (see
+		 * Position::argumentSums).
+		 */
+		unsigned int arguments;
+	};
+
+	/**
+	 * The position of an element.
+	 */
+	struct Position {
+		vector<Frame> frames;
+
+		/**
+		 * The prefix sums of the numbers of elements generated by the
+		 * arguments of all frames.
+		 */
+		vector<unsigned long long> argumentSums;
+
+		/**
+		 * The terminal node of the right-hand side of the topmost frame.
+		 */
+		TreeNode * pNode;
+	};
+
+	/**
+	 * The constructor precomputes the events of all productions.
+	 * @param dagGrammar the grammar containing the start production
+	 * @param mainGrammar the grammar containing the remaining productions
+	 */
+	GrammarNavigator(Grammar & dagGrammar, Grammar & mainGrammar);
+	~GrammarNavigator(void);
+
+	/**
+	 * Returns the number of elements of the document.
+	 */
+	unsigned long long getNumberOfElements() { return numberOfElements; };
+
+	/**
+	 * Moves the specified position to the root element. Returns false
+	 * if the document is empty.
+	 */
+	bool moveToRoot(Position & position);
+
+	/**
+	 * Moves the specified position to the first child of its element.
+	 * Returns false (and leaves the position untouched) if the element
+	 * has no children.
+	 */
+	bool moveToFirstChild(Position & position);
+
+	/**
+	 * Moves the specified position to the next sibling of its element.
+	 * Returns false (and leaves the position untouched) if the element
+	 * is the last child of its parent.
+	 */
+	bool moveToNextSibling(Position & position);
+
+	/**
+	 * Moves the specified position to the parent of its element. Returns
+	 * false (and leaves the position untouched) for the root element.
+	 */
+	bool moveToParent(Position & position);
+
+	/**
+	 * Moves the specified position to the element with the specified
+	 * preorder number. Returns false (and leaves the position untouched)
+	 * if there is no such element.
+	 */
+	bool moveToPreorder(Position & position, unsigned long long preorder);
+
+	/**
+	 * Moves the specified position to the element selected by the
+	 * specified path. A path consists of steps separated by slashes,
+	 * every step is an element type optionally followed by a number in
+	 * brackets (e.g., "a/b[3]/c"). The first step selects the root
+	 * element, every further step the n-th child (the first one by
+	 * default) of the specified type of the element selected so far.
+	 * Returns false (and leaves the position untouched) if the path is
+	 * malformed or does not select an element.
+	 */
+	bool moveToPath(Position & position, const string & path);
+
+	/**
+	 * Returns the preorder number of the element at the specified
+	 * position.
+	 */
+	unsigned long long getPreorder(const Position & position) {
+		return getValue(position, firstEvents[position.pNode->getId()]);
+	};
+
+	/**
+	 * Returns the number of elements of the subtree rooted at the element
+	 * at the specified position (including the element itself).
+	 */
+	unsigned long long getSubtreeSize(const Position & position);
+
+	/**
+	 * Returns the element type of the element at the specified position.
+	 */
+	string getElementType(const Position & position) {
+		return Symbol::getElementTypeById(position.pNode->getSymbol()->getId());
+	};
+
+protected:
+	/**
+	 * The hooks of the traversal of a right-hand side by flatten(): the
+	 * events of a node are generated when entering it and, if it is a
+	 * nonterminal node, after each of its arguments.
+	 */
+	void preVisit(TreeNode * pNode, unsigned int childIndex, int depth);
+	void postVisit(TreeNode * pNode, unsigned int childIndex, int depth);
+	void visitEdge(TreeNode * pParent, unsigned int childIndex,
+			TreeNode * pChild);
+
+private:
+	/**
+	 * Flattens the right-hand side of the specified production into
+	 * events. The productions it references must have been flattened
+	 * already.
+	 */
+	void flatten(unsigned int production);
+
+	/**
+	 * Appends an event for the specified node which is followed by the
+	 * specified number of elements.
+	 */
+	void addEvent(TreeNode * pNode, unsigned long long weight);
+
+	/**
+	 * Returns the number of elements preceding the specified event in the
+	 * frame on top of the specified position.
+	 */
+	unsigned long long getValue(const Position & position,
+			unsigned int event) {
+		const Frame & frame = position.frames.back();
+		return frame.base + elementsBefore[event]
+				+ position.argumentSums[frame.arguments + parametersBefore[event]];
+	};
+
+	/**
+	 * Replaces the frames of the specified position by the frame of the
+	 * start production.
+	 */
+	void reset(Position & position);
+
+	/**
+	 * Pushes a frame for the specified nonterminal node of the right-hand
+	 * side of the topmost frame.
+	 */
+	void push(Position & position, TreeNode * pCallNode);
+
+	/**
+	 * Pops the topmost frame.
+	 */
+	void pop(Position & position) {
+		position.argumentSums.resize(position.frames.back().arguments);
+		position.frames.pop_back();
+	};
+
+	/**
+	 * Moves the specified position to the first element generated by the
+	 * specified node of the right-hand side of the topmost frame.
+	 */
+	void descend(Position & position, TreeNode * pNode);
+
+	/**
+	 * Returns true if the path of the expanded binary tree from the first
+	 * element generated by the specified node up to the first element
+	 * generated by its parent consists of edges to next siblings only.
+	 */
+	bool isSiblingEdge(TreeNode * pNode);
+
+	GrammarIndex index;
+
+	unsigned long long numberOfElements;
+
+	/**
+	 * The events of all productions. The events of production p are
+	 * eventBegins[p], ..., eventEnds[p] - 1 followed by a sentinel event
+	 * eventEnds[p]. Every event stores the node it was generated for,
+	 * the number of elements and the number of parameters preceding it
+	 * in the production.
+	 */
+	vector<unsigned int> eventBegins;
+	vector<unsigned int> eventEnds;
+	vector<TreeNode *> eventNodes;
+	vector<unsigned long long> elementsBefore;
+	vector<unsigned int> parametersBefore;
+
+	/**
+	 * By node id: the first event of the subtree rooted at the node and
+	 * the event following the last one.
+	 */
+	vector<unsigned int> firstEvents;
+	vector<unsigned int> endEvents;
+
+	/**
+	 * By node id: the topmost ancestor which can be reached by following
+	 * sibling edges only (see isSiblingEdge()).
+	 */
+	vector<TreeNode *> siblingChainTops;
+
+	/**
+	 * By production: the number of parameters, the index of the first
+	 * entry of parameterNodes and hasFirstChildEdges and the index of
+	 * the first entry of segmentLengths belonging to it.
+	 */
+	vector<unsigned int> ranks;
+	vector<unsigned int> parameterBegins;
+	vector<unsigned int> segmentBegins;
+
+	/**
+	 * The parameter nodes of the productions.
+	 */
+	vector<TreeNode *> parameterNodes;
+
+	/**
+	 * The numbers of elements of the segments of the expanded right-hand
+	 * sides before, between and after the parameters (a production of
+	 * rank r has r + 1 segments).
+	 */
+	vector<unsigned long long> segmentLengths;
+
+	/**
+	 * Indicates whether the path from a parameter to the root of the
+	 * expanded right-hand side contains an edge to a first child.
+	 */
+	vector<bool> hasFirstChildEdges;
+
+	/**
+	 * The state of flatten() while traversing a right-hand side: the
+	 * number of elements and of parameters preceding the next event.
+	 */
+	unsigned long long currentElements;
+	unsigned int currentParameters;
+};
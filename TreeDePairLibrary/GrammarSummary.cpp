@@ -0,0 +1,164 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "GrammarSummary.h"
+
+#include "Production.h"
+#include "TreeNode.h"
+
+#include <iostream>
+#include <cstdlib>
+
+const long long GrammarSummary::NO_ELEMENTS;
+
+GrammarSummary::GrammarSummary(Grammar & dagGrammar, Grammar & mainGrammar) :
+	index(dagGrammar, mainGrammar), currentApplications(0)
+{
+	const vector<unsigned int> & order = index.getOrder();
+	unsigned int size = index.size();
+	numbersOfElements.assign(size, 0);
+	maximalDepths.assign(size, NO_ELEMENTS);
+	parameterDepths.resize(size);
+	numbersOfApplications.assign(size, 0);
+
+	// bottom-up: the referenced productions are summarized first
+	for (unsigned int i = order.size(); i > 0; i--) {
+		summarize(order[i - 1]);
+	}
+
+	// top-down: a production is applied once for every application
+	// of a production referencing it
+	numbersById.assign(Symbol::counter, 0);
+	numbersOfApplications[index.getStartProduction()] = 1;
+	for (unsigned int i = 0; i < order.size(); i++) {
+		currentApplications = numbersOfApplications[order[i]];
+		traverseTree(index.getRightHandSide(order[i]));
+	}
+
+	// the terminals of different binary ranks may share an element type
+	for (unsigned int id = 0; id < numbersById.size(); id++) {
+		if (numbersById[id] > 0) {
+			histogram[Symbol::getElementTypeById(id)] += numbersById[id];
+		}
+	}
+	vector<unsigned long long>().swap(numbersById);
+}
+
+GrammarSummary::~GrammarSummary(void)
+{
+}
+
+void GrammarSummary::preVisit(TreeNode * pNode, unsigned int childIndex,
+		int depth)
+{
+	Symbol * pSymbol = pNode->getSymbol();
+	unsigned int referenced = index.getProduction(pSymbol);
+	if (referenced != GrammarIndex::NO_PRODUCTION) {
+		numbersOfApplications[referenced] += currentApplications;
+	} else if (pSymbol != Symbol::getParameterSymbol()) {
+		numbersById[pSymbol->getId()] += currentApplications;
+	}
+}
+
+unsigned long long GrammarSummary::getNumberOfElements()
+{
+	return numbersOfElements[index.getStartProduction()];
+}
+
+unsigned long long GrammarSummary::getNumberOfElements(
+		const string & elementType)
+{
+	map<string, unsigned long long>::iterator it = histogram.find(elementType);
+	return it != histogram.end() ? it->second : 0;
+}
+
+unsigned long long GrammarSummary::getMaximalDepth()
+{
+	long long depth = maximalDepths[index.getStartProduction()];
+	return depth == NO_ELEMENTS ? 0 : depth + 1;
+}
+
+void GrammarSummary::summarize(unsigned int production)
+{
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+
+	unsigned long long numberOfElements = 0;
+	long long maximalDepth = NO_ELEMENTS;
+	vector<unsigned long long> & depths = parameterDepths[production];
+
+	// the nodes are visited in preorder together with their depths in
+	// the unranked tree, i.e., only the edge to the left child (which
+	// is the first child in the unranked tree) increases the depth
+	vector<pair<TreeNode *, unsigned long long> > nodes;
+	nodes.push_back(make_pair(index.getRightHandSide(production), 0ULL));
+
+	while (!nodes.empty()) {
+		TreeNode * pNode = nodes.back().first;
+		unsigned long long depth = nodes.back().second;
+		nodes.pop_back();
+
+		Symbol * pSymbol = pNode->getSymbol();
+		unsigned int children = pNode->getCurrentChildrenCount();
+
+		if (pSymbol == pParameterSymbol) {
+			depths.push_back(depth);
+			continue;
+		}
+
+		unsigned int referenced = index.getProduction(pSymbol);
+		if (referenced != GrammarIndex::NO_PRODUCTION) {
+			numberOfElements += numbersOfElements[referenced];
+			if (maximalDepths[referenced] != NO_ELEMENTS
+					&& (long long) depth + maximalDepths[referenced] > maximalDepth) {
+				maximalDepth = depth + maximalDepths[referenced];
+			}
+
+			vector<unsigned long long> & argumentDepths =
+					parameterDepths[referenced];
+			if (argumentDepths.size() != children) {
+				cout << "Fatal error: The rank of a nonterminal does not "
+					"match the number of parameters of its production. "
+					"Exiting ..." << endl;
+				exit(1);
+			}
+			for (unsigned int j = children; j > 0; j--) {
+				nodes.push_back(make_pair(pNode->getChild(j - 1),
+						depth + argumentDepths[j - 1]));
+			}
+			continue;
+		}
+
+		numberOfElements++;
+		if ((long long) depth > maximalDepth) {
+			maximalDepth = depth;
+		}
+
+		// the right child is pushed first to visit the nodes in preorder
+		if (pSymbol->hasLeftChild()) {
+			if (pSymbol->hasRightChild()) {
+				nodes.push_back(make_pair(pNode->getChild(1), depth));
+			}
+			nodes.push_back(make_pair(pNode->getChild(0), depth + 1));
+		} else if (pSymbol->hasRightChild()) {
+			nodes.push_back(make_pair(pNode->getChild(0), depth));
+		}
+	}
+
+	numbersOfElements[production] = numberOfElements;
+	maximalDepths[production] = maximalDepth;
+}
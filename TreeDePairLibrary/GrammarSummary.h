@@ -0,0 +1,134 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "Grammar.h"
+#include "GrammarIndex.h"
+#include "StaticTreeTraversal.h"
+#include "Symbol.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Answers aggregate queries about the XML document represented by a
+ * linear SLCF tree grammar without decompressing it. A summary of every
+ * production is computed once, bottom-up: the number of element nodes
+ * of its expanded right-hand side, the depth of the deepest of them and
+ * the depths of its parameters (relative to the root of the right-hand
+ * side). Additionally, the number of times every production is applied
+ * when deriving the document is computed top-down, which yields the
+ * number of elements per element type.
+ *
+ * All this takes time linear in the size of the grammar. Afterwards,
+ * the queries are answered without looking at the grammar again.
+ */
+class GrammarSummary : public StaticTreeTraversal<GrammarSummary>
+{
+	friend class StaticTreeTraversal<GrammarSummary>;
+
+public:
+	/**
+	 * The constructor computes the summaries.
+	 * @param dagGrammar the grammar containing the start production
+	 * @param mainGrammar the grammar containing the remaining productions
+	 */
+	GrammarSummary(Grammar & dagGrammar, Grammar & mainGrammar);
+	~GrammarSummary(void);
+
+	/**
+	 * Returns the number of elements of the document.
+	 */
+	unsigned long long getNumberOfElements();
+
+	/**
+	 * Returns the number of elements of the specified element type.
+	 */
+	unsigned long long getNumberOfElements(const string & elementType);
+
+	/**
+	 * Returns the maximal depth of an element (the root element has
+	 * depth 1).
+	 */
+	unsigned long long getMaximalDepth();
+
+	/**
+	 * Returns the number of elements of every element type occurring in
+	 * the document.
+	 */
+	const map<string, unsigned long long> & getElementTypeHistogram() {
+		return histogram;
+	};
+
+protected:
+	/**
+	 * Adds the applications of the current production to the referenced
+	 * productions and terminal symbols.
+	 */
+	void preVisit(TreeNode * pNode, unsigned int childIndex, int depth);
+
+private:
+	/**
+	 * Indicates that the expanded right-hand side of a production does
+	 * not contain an element node.
+	 */
+	static const long long NO_ELEMENTS = -1;
+
+	/**
+	 * Computes the number of elements, the maximal depth and the depths
+	 * of the parameters of the specified production. The productions it
+	 * references must have been summarized already.
+	 */
+	void summarize(unsigned int production);
+
+	/**
+	 * The numbers of the productions and their topological order.
+	 */
+	GrammarIndex index;
+
+	/**
+	 * By production: the number of elements of the expanded right-hand
+	 * side, the depth of its deepest element (or NO_ELEMENTS), the
+	 * depths of its parameters and the number of times it is applied.
+	 */
+	vector<unsigned long long> numbersOfElements;
+	vector<long long> maximalDepths;
+	vector<vector<unsigned long long> > parameterDepths;
+	vector<unsigned long long> numbersOfApplications;
+
+	/**
+	 * The number of elements of every element type.
+	 */
+	map<string, unsigned long long> histogram;
+
+	/**
+	 * The number of applications of the production whose right-hand side
+	 * is traversed top-down.
+	 */
+	unsigned long long currentApplications;
+
+	/**
+	 * The number of elements labeled by a terminal symbol by its id
+	 * (only used while counting the applications).
+	 */
+	vector<unsigned long long> numbersById;
+};
@@ -0,0 +1,195 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "GrammarValidator.h"
+
+#include <iostream>
+#include <cstdlib>
+
+const unsigned int GrammarValidator::NO_EVALUATION;
+
+/**
+ * Marks the entries of GrammarValidator::elements which were not looked
+ * up yet.
+ */
+static const unsigned int UNKNOWN_ELEMENT = 0xFFFFFFFE;
+
+GrammarValidator::GrammarValidator(Grammar & dagGrammar, Grammar & mainGrammar,
+		SchemaAutomaton & automatonPar) :
+	index(dagGrammar, mainGrammar), automaton(automatonPar),
+	currentProduction(0)
+{
+	ranks.resize(index.size(), 0);
+	parameterNumbers.resize(TreeNode::idCounter, 0);
+	elements.resize(Symbol::counter, UNKNOWN_ELEMENT);
+	evaluationIndexes.resize(index.size());
+
+	// the referenced productions are traversed first, so their ranks
+	// are known when checking the nonterminals
+	const vector<unsigned int> & order = index.getOrder();
+	for (unsigned int i = order.size(); i > 0; i--) {
+		currentProduction = order[i - 1];
+		traverseTree(index.getRightHandSide(currentProduction));
+	}
+}
+
+GrammarValidator::~GrammarValidator(void)
+{
+}
+
+void GrammarValidator::preVisit(TreeNode * pNode, unsigned int childIndex,
+		int depth)
+{
+	Symbol * pSymbol = pNode->getSymbol();
+
+	// the parameters are numbered in preorder
+	if (pSymbol == Symbol::getParameterSymbol()) {
+		parameterNumbers[pNode->getId()] = ranks[currentProduction]++;
+		return;
+	}
+
+	unsigned int referenced = index.getProduction(pSymbol);
+	if (referenced != GrammarIndex::NO_PRODUCTION
+			&& ranks[referenced] != pNode->getCurrentChildrenCount()) {
+		cout << "Fatal error: The rank of a nonterminal does not "
+			"match the number of parameters of its production. "
+			"Exiting ..." << endl;
+		exit(1);
+	}
+}
+
+bool GrammarValidator::isValid()
+{
+	return getEvaluation(index.getStartProduction(),
+			automaton.getDocumentState()) != NO_EVALUATION;
+}
+
+unsigned int GrammarValidator::getElement(Symbol * pSymbol)
+{
+	unsigned int id = pSymbol->getId();
+	if (elements[id] == UNKNOWN_ELEMENT) {
+		elements[id] = automaton.getElementIndex(
+				Symbol::getElementTypeById(id));
+	}
+	return elements[id];
+}
+
+unsigned int GrammarValidator::getEvaluation(unsigned int production,
+		unsigned int state)
+{
+	map<unsigned int, unsigned int>::iterator it =
+			evaluationIndexes[production].find(state);
+	if (it != evaluationIndexes[production].end()) {
+		return it->second;
+	}
+
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+
+	// the referenced productions are evaluated on demand, the evaluation
+	// of the referencing one is resumed afterwards
+	vector<PendingEvaluation> evaluations(1);
+	evaluations.back().production = production;
+	evaluations.back().state = state;
+	evaluations.back().parameterStates.assign(ranks[production],
+			SchemaAutomaton::INVALID_STATE);
+	PendingNode root = { index.getRightHandSide(production), state };
+	evaluations.back().nodes.push_back(root);
+
+	while (!evaluations.empty()) {
+		PendingEvaluation & evaluation = evaluations.back();
+
+		if (evaluation.nodes.empty()) {
+			evaluationIndexes[evaluation.production][evaluation.state] =
+					parameterStateBegins.size();
+			parameterStateBegins.push_back(parameterStates.size());
+			parameterStates.insert(parameterStates.end(),
+					evaluation.parameterStates.begin(),
+					evaluation.parameterStates.end());
+			evaluations.pop_back();
+			continue;
+		}
+
+		PendingNode node = evaluation.nodes.back();
+		TreeNode * pNode = node.pNode;
+		Symbol * pSymbol = pNode->getSymbol();
+
+		if (pSymbol == pParameterSymbol) {
+			evaluation.nodes.pop_back();
+			evaluation.parameterStates[parameterNumbers[pNode->getId()]] =
+					node.state;
+			continue;
+		}
+
+		unsigned int referenced = index.getProduction(pSymbol);
+		if (referenced != GrammarIndex::NO_PRODUCTION) {
+			it = evaluationIndexes[referenced].find(node.state);
+			if (it == evaluationIndexes[referenced].end()) {
+				PendingEvaluation referencedEvaluation;
+				referencedEvaluation.production = referenced;
+				referencedEvaluation.state = node.state;
+				referencedEvaluation.parameterStates.assign(ranks[referenced],
+						SchemaAutomaton::INVALID_STATE);
+				PendingNode referencedRoot = {
+						index.getRightHandSide(referenced), node.state };
+				referencedEvaluation.nodes.push_back(referencedRoot);
+				// invalidates the reference to the current evaluation
+				evaluations.push_back(referencedEvaluation);
+				continue;
+			}
+
+			evaluation.nodes.pop_back();
+			unsigned int begin = parameterStateBegins[it->second];
+			for (unsigned int j = 0; j < ranks[referenced]; j++) {
+				PendingNode argument = { pNode->getChild(j),
+						parameterStates[begin + j] };
+				evaluation.nodes.push_back(argument);
+			}
+			continue;
+		}
+
+		// a terminal node: the left child is the first child and the
+		// right child is the next sibling in the unranked tree; the
+		// content model of the parent has to accept the siblings read so
+		// far at the last sibling and the one of the element has to
+		// accept the empty sequence if it has no children
+		evaluation.nodes.pop_back();
+		unsigned int element = getElement(pSymbol);
+		unsigned int siblingState = automaton.getNextState(node.state, element);
+		unsigned int childState = automaton.getContentState(element);
+		if (siblingState == SchemaAutomaton::INVALID_STATE
+				|| childState == SchemaAutomaton::INVALID_STATE
+				|| (!pSymbol->hasRightChild()
+						&& !automaton.isFinalState(siblingState))
+				|| (!pSymbol->hasLeftChild()
+						&& !automaton.isFinalState(childState))) {
+			return NO_EVALUATION;
+		}
+
+		unsigned int children = pNode->getCurrentChildrenCount();
+		if (pSymbol->hasRightChild()) {
+			PendingNode sibling = { pNode->getChild(children - 1), siblingState };
+			evaluation.nodes.push_back(sibling);
+		}
+		if (pSymbol->hasLeftChild()) {
+			PendingNode child = { pNode->getChild(0), childState };
+			evaluation.nodes.push_back(child);
+		}
+	}
+
+	return evaluationIndexes[production][state];
+}
@@ -0,0 +1,152 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "Grammar.h"
+#include "GrammarIndex.h"
+#include "SchemaAutomaton.h"
+#include "StaticTreeTraversal.h"
+#include "Symbol.h"
+#include "TreeNode.h"
+
+#include <map>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Validates the XML document represented by a linear SLCF tree grammar
+ * against a DTD without decompressing it by running the automaton of the
+ * DTD (see SchemaAutomaton) over the binary right-hand sides, i.e., over
+ * the first-child/next-sibling encoding of the document.
+ *
+ * The states at the parameters of a right-hand side only depend on the
+ * state at its root. They are therefore computed at most once for every
+ * production and every state, so the running time depends on the size
+ * of the grammar and on the number of states of the content models, but
+ * not on the size of the document. The validation stops at the first
+ * element whose children do not match its content model.
+ */
+class GrammarValidator : public StaticTreeTraversal<GrammarValidator>
+{
+	friend class StaticTreeTraversal<GrammarValidator>;
+
+public:
+	/**
+	 * The constructor.
+	 * @param dagGrammar the grammar containing the start production
+	 * @param mainGrammar the grammar containing the remaining productions
+	 * @param automaton the automaton of the DTD
+	 */
+	GrammarValidator(Grammar & dagGrammar, Grammar & mainGrammar,
+			SchemaAutomaton & automaton);
+	~GrammarValidator(void);
+
+	/**
+	 * Indicates whether the document is valid with respect to the DTD.
+	 */
+	bool isValid();
+
+	/**
+	 * Returns the number of pairs of productions and states at the roots
+	 * of their right-hand sides evaluated so far.
+	 */
+	unsigned int getNumberOfEvaluations() { return parameterStateBegins.size(); };
+
+protected:
+	/**
+	 * Numbers the parameters of the current production and checks the
+	 * ranks of the nonterminals.
+	 */
+	void preVisit(TreeNode * pNode, unsigned int childIndex, int depth);
+
+private:
+	/**
+	 * A node of a right-hand side which is still to visit together with
+	 * the state at the node.
+	 */
+	struct PendingNode
+	{
+		TreeNode * pNode;
+		unsigned int state;
+	};
+
+	/**
+	 * The evaluation of a production which is still in progress.
+	 */
+	struct PendingEvaluation
+	{
+		unsigned int production;
+		unsigned int state;
+		vector<PendingNode> nodes;
+		vector<unsigned int> parameterStates;
+	};
+
+	/**
+	 * Returns the index of the evaluation of the specified production for
+	 * the specified state at the root of its right-hand side (the
+	 * production is evaluated if necessary) or NO_EVALUATION if an element
+	 * of the expanded right-hand side is not valid.
+	 */
+	unsigned int getEvaluation(unsigned int production, unsigned int state);
+
+	/**
+	 * Returns the index of the element type of the specified terminal
+	 * symbol in the DTD.
+	 */
+	unsigned int getElement(Symbol * pSymbol);
+
+	static const unsigned int NO_EVALUATION = 0xFFFFFFFF;
+
+	GrammarIndex index;
+	SchemaAutomaton & automaton;
+
+	/**
+	 * By production: the number of parameters.
+	 */
+	vector<unsigned int> ranks;
+
+	/**
+	 * By node id of a parameter: its number in the right-hand side.
+	 */
+	vector<unsigned int> parameterNumbers;
+
+	/**
+	 * By terminal symbol id: the index of its element type in the DTD
+	 * (UNKNOWN_ELEMENT if it was not looked up yet).
+	 */
+	vector<unsigned int> elements;
+
+	/**
+	 * By production: the indexes of the evaluations by state.
+	 */
+	vector<map<unsigned int, unsigned int> > evaluationIndexes;
+
+	/**
+	 * By evaluation: the index of the first state at the parameters in
+	 * parameterStates.
+	 */
+	vector<unsigned int> parameterStateBegins;
+	vector<unsigned int> parameterStates;
+
+	/**
+	 * The production whose right-hand side is traversed.
+	 */
+	unsigned int currentProduction;
+};
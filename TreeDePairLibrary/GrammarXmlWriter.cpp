@@ -0,0 +1,681 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "GrammarXmlWriter.h"
+
+#include "GrammarNavigator.h"
+#include "Production.h"
+#include "ExpandedEdgeCounter.h"
+#include "XmlSerializer.h"
+#include "TreeRePairConstants.h"
+
+#include <cstdlib>
+#include <climits>
+
+#if defined(__GNUC__)
+#include <pthread.h>
+
+struct GrammarXmlWriter::WorkerContext
+{
+	GrammarXmlWriter * pWriter;
+	bool useFormatting;
+
+	/**
+	 * The next job to take and the number of jobs written to the output
+	 * stream. A worker does not take a job more than maxJobsAhead jobs
+	 * ahead of the output, so the memory needed for the buffers stays
+	 * bounded.
+	 */
+	unsigned int nextJob;
+	unsigned int writtenJobs;
+	unsigned int maxJobsAhead;
+
+	pthread_mutex_t mutex;
+	pthread_cond_t jobDone;
+	pthread_cond_t jobWritten;
+};
+#endif
+
+TreeNode * const GrammarXmlWriter::STREAMED_NODE = (TreeNode *) 1;
+
+GrammarXmlWriter::GrammarXmlWriter(Grammar & dagGrammarPar,
+		Grammar & mainGrammarPar) :
+	dagGrammar(dagGrammarPar), mainGrammar(mainGrammarPar),
+#if defined(__GNUC__)
+	pStartProduction(0),
+#endif
+	pJobStart(0), jobStartBinding(NO_BINDING), jobSize(0), numberOfNodes(0)
+{
+	rightHandSides.resize(Symbol::counter, 0);
+	parameterIndexes.resize(TreeNode::idCounter, 0);
+
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+	vector<TreeNode *> nodes;
+
+	for (unsigned int i = 0; i < mainGrammar.size(); i++) {
+		Production * pProduction = mainGrammar[i];
+		rightHandSides[pProduction->getLeftHandSide()->getId()] =
+				pProduction->getRightHandSide();
+
+		// the parameters are numbered in preorder
+		unsigned int parameterCounter = 0;
+		nodes.push_back(pProduction->getRightHandSide());
+		while (!nodes.empty()) {
+			TreeNode * pNode = nodes.back();
+			nodes.pop_back();
+			if (pNode->getSymbol() == pParameterSymbol) {
+				parameterIndexes[pNode->getId()] = parameterCounter++;
+			}
+			for (unsigned int j = pNode->getCurrentChildrenCount(); j > 0; j--) {
+				nodes.push_back(pNode->getChild(j - 1));
+			}
+		}
+	}
+}
+
+GrammarXmlWriter::~GrammarXmlWriter(void)
+{
+}
+
+void GrammarXmlWriter::writeXml(ostream & out, bool useFormatting,
+		unsigned int numberOfThreads)
+{
+#if defined(__GNUC__)
+	if (numberOfThreads > 1) {
+		computeSizes();
+		// small documents are not worth starting threads for
+		if (nodeSizes[dagGrammar[0]->getRightHandSide()->getId()]
+				>= (unsigned long long) numberOfThreads * MIN_DECOMPRESSION_JOB_SIZE) {
+			writeInParallel(out, useFormatting, numberOfThreads);
+			return;
+		}
+	}
+#endif
+
+	XmlSerializer serializer(out, useFormatting);
+	Expansion expansion;
+	numberOfNodes = expand(expansion, dagGrammar[0]->getRightHandSide(),
+			NO_BINDING, ULLONG_MAX, serializer);
+	serializer.flush();
+}
+
+#if defined(__GNUC__)
+void GrammarXmlWriter::writeXml(ostream & out,
+		BoundedQueue<Symbol *> & startProduction, bool useFormatting)
+{
+	pStartProduction = &startProduction;
+
+	XmlSerializer serializer(out, useFormatting);
+	Expansion expansion;
+	numberOfNodes = expand(expansion, STREAMED_NODE, NO_BINDING, ULLONG_MAX,
+			serializer);
+	serializer.flush();
+
+	pStartProduction = 0;
+}
+#endif
+
+void GrammarXmlWriter::writeXml(ostream & out, GrammarNavigator & navigator,
+		unsigned long long start, unsigned long long count,
+		bool useFormatting)
+{
+	XmlSerializer serializer(out, useFormatting);
+	Expansion expansion;
+	numberOfNodes = 0;
+
+	GrammarNavigator::Position position;
+	if (count == 0 || !navigator.moveToPreorder(position, start)) {
+		serializer.flush();
+		return;
+	}
+
+	while (true) {
+		// the frames of the navigator become the chain of bindings (the
+		// first frame belongs to the start production)
+		unsigned int binding = NO_BINDING;
+		for (unsigned int i = 1; i < position.frames.size(); i++) {
+			binding = expansion.createBinding(position.frames[i].pCallNode,
+					binding);
+		}
+
+		// the element, its descendants and its following siblings
+		numberOfNodes += expand(expansion, position.pNode, binding,
+				count - numberOfNodes, serializer);
+		if (numberOfNodes == count) {
+			// the elements which are still open are closed
+			vector<StackEntry> & stack = expansion.stack;
+			for (unsigned int i = stack.size(); i > 0; i--) {
+				if (stack[i - 1].pClosingSymbol != 0) {
+					serializer.writeClosingTag(stack[i - 1].pClosingSymbol);
+				}
+			}
+			break;
+		}
+
+		// the range continues with the next sibling of an ancestor
+		bool found = false;
+		while (!found && navigator.moveToParent(position)) {
+			found = navigator.moveToNextSibling(position);
+		}
+		if (!found) {
+			break;
+		}
+	}
+
+	serializer.flush();
+}
+
+unsigned long long GrammarXmlWriter::expand(Expansion & expansion,
+		TreeNode * pStart, unsigned int startBinding,
+		unsigned long long maxNodes, XmlSerializer & serializer)
+{
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+	vector<Binding> & bindings = expansion.bindings;
+	vector<StackEntry> & stack = expansion.stack;
+	unsigned long long nodes = 0;
+
+	StackEntry start = { pStart, startBinding, 0 };
+	stack.push_back(start);
+
+	while (!stack.empty()) {
+
+		StackEntry entry = stack.back();
+
+		if (entry.pClosingSymbol != 0) {
+			stack.pop_back();
+			serializer.writeClosingTag(entry.pClosingSymbol);
+			continue;
+		}
+
+		if (nodes >= maxNodes) {
+			break;
+		}
+		stack.pop_back();
+
+		TreeNode * pNode = entry.pNode;
+		unsigned int binding = entry.binding;
+
+		// the reference of the stack entry to its binding is now held
+		// by pNode and passed on until pNode is done
+		while (pNode != 0) {
+
+			bool streamed = pNode == STREAMED_NODE;
+#if defined(__GNUC__)
+			Symbol * pSymbol = streamed ? pStartProduction->pop()
+					: pNode->getSymbol();
+			if (pSymbol == 0) {
+				// the decoding thread failed, it is up to the caller to
+				// report the error
+				stack.clear();
+				break;
+			}
+#else
+			Symbol * pSymbol = pNode->getSymbol();
+#endif
+
+			if (pSymbol == pParameterSymbol && !streamed) {
+				Binding & current = bindings[binding];
+				if (current.pCallNode == STREAMED_NODE) {
+					// the argument is the next subtree of the stream
+					pNode = STREAMED_NODE;
+				} else {
+					unsigned int index = parameterIndexes[pNode->getId()];
+					if (index >= current.pCallNode->getCurrentChildrenCount()) {
+						cout << "Fatal error: Production has more parameters "
+							"than the rank of its left-hand side. Exiting ..."
+							<< endl;
+						exit(1);
+					}
+					pNode = current.pCallNode->getChild(index);
+				}
+				unsigned int parent = current.parent;
+				expansion.retainBinding(parent);
+				expansion.releaseBinding(binding);
+				binding = parent;
+				continue;
+			}
+
+			unsigned int id = pSymbol->getId();
+			TreeNode * pRightHandSide = id < rightHandSides.size()
+					? rightHandSides[id] : 0;
+			if (pRightHandSide != 0) {
+				binding = expansion.createBinding(pNode, binding);
+				pNode = pRightHandSide;
+				continue;
+			}
+
+			// a terminal node: the left child is the first child and the
+			// right child is the next sibling in the unranked tree
+			if (nodes >= maxNodes) {
+				// the node is left on the stack (this never happens for
+				// streamed nodes since they are expanded without a limit)
+				StackEntry rest = { pNode, binding, 0 };
+				stack.push_back(rest);
+				break;
+			}
+			nodes++;
+
+			// the children of a streamed node are the next subtrees of the
+			// stream
+			TreeNode * pLeftChild = 0, * pRightChild = 0;
+			if (pSymbol->hasLeftChild()) {
+				serializer.writeOpeningTag(pSymbol);
+				pLeftChild = streamed ? STREAMED_NODE : pNode->getChild(0);
+				if (pSymbol->hasRightChild()) {
+					pRightChild = streamed ? STREAMED_NODE : pNode->getChild(1);
+				}
+			} else {
+				serializer.writeEmptyTag(pSymbol);
+				if (pSymbol->hasRightChild()) {
+					pRightChild = streamed ? STREAMED_NODE : pNode->getChild(0);
+				}
+			}
+
+			if (pRightChild != 0) {
+				expansion.retainBinding(binding);
+				StackEntry right = { pRightChild, binding, 0 };
+				stack.push_back(right);
+			}
+
+			if (pLeftChild != 0) {
+				StackEntry closing = { 0, NO_BINDING, pSymbol };
+				stack.push_back(closing);
+				pNode = pLeftChild;
+			} else {
+				expansion.releaseBinding(binding);
+				pNode = 0;
+			}
+		}
+	}
+
+	return nodes;
+}
+
+unsigned int GrammarXmlWriter::Expansion::createBinding(TreeNode * pCallNode,
+		unsigned int parent)
+{
+	unsigned int binding;
+	if (!freeBindings.empty()) {
+		binding = freeBindings.back();
+		freeBindings.pop_back();
+	} else {
+		binding = bindings.size();
+		bindings.push_back(Binding());
+	}
+
+	Binding & newBinding = bindings[binding];
+	newBinding.pCallNode = pCallNode;
+	newBinding.parent = parent;
+	newBinding.refCount = 1;
+
+	return binding;
+}
+
+void GrammarXmlWriter::Expansion::releaseBinding(unsigned int binding)
+{
+	// a released binding drops its reference to its parent
+	while (binding != NO_BINDING && --bindings[binding].refCount == 0) {
+		freeBindings.push_back(binding);
+		binding = bindings[binding].parent;
+	}
+}
+
+void GrammarXmlWriter::computeSizes()
+{
+	if (!nodeSizes.empty()) {
+		return;
+	}
+
+	nodeSizes.resize(TreeNode::idCounter, 0);
+	firstParameters.resize(TreeNode::idCounter, 0);
+	parameterCounts.resize(TreeNode::idCounter, 0);
+
+	ExpandedEdgeCounter expandedEdgeCounter(mainGrammar);
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+	vector<TreeNode *> nodes;
+
+	for (unsigned int i = 0; i <= mainGrammar.size(); i++) {
+		TreeNode * pRoot = i < mainGrammar.size()
+				? mainGrammar[i]->getRightHandSide()
+				: dagGrammar[0]->getRightHandSide();
+
+		// the children of a node are collected behind it, hence, they
+		// are done before the node itself when going backwards
+		nodes.clear();
+		nodes.push_back(pRoot);
+		for (unsigned int j = 0; j < nodes.size(); j++) {
+			TreeNode * pNode = nodes[j];
+			for (unsigned int k = 0; k < pNode->getCurrentChildrenCount(); k++) {
+				nodes.push_back(pNode->getChild(k));
+			}
+		}
+
+		for (unsigned int j = nodes.size(); j > 0; j--) {
+			TreeNode * pNode = nodes[j - 1];
+			unsigned int id = pNode->getId();
+			Symbol * pSymbol = pNode->getSymbol();
+
+			if (pSymbol == pParameterSymbol) {
+				firstParameters[id] = parameterIndexes[id];
+				parameterCounts[id] = 1;
+				continue;
+			}
+
+			unsigned long long size = 1;
+			unsigned int symbolId = pSymbol->getId();
+			if (symbolId < rightHandSides.size()
+					&& rightHandSides[symbolId] != 0) {
+				size = expandedEdgeCounter.getExpandedEdges(
+						mainGrammar.getProductionBySymbol(pSymbol)) + 1;
+			}
+
+			unsigned int count = 0;
+			for (unsigned int k = 0; k < pNode->getCurrentChildrenCount(); k++) {
+				unsigned int childId = pNode->getChild(k)->getId();
+				size += nodeSizes[childId];
+				if (count == 0) {
+					firstParameters[id] = firstParameters[childId];
+				}
+				count += parameterCounts[childId];
+			}
+
+			nodeSizes[id] = size;
+			parameterCounts[id] = count;
+		}
+	}
+}
+
+unsigned long long GrammarXmlWriter::getSize(TreeNode * pNode,
+		unsigned int binding)
+{
+	unsigned int id = pNode->getId();
+	unsigned long long size = nodeSizes[id];
+	unsigned int count = parameterCounts[id];
+	if (count > 0) {
+		vector<unsigned long long> & argumentSizes =
+				planningBindings[binding].argumentSizes;
+		size += argumentSizes[firstParameters[id] + count]
+				- argumentSizes[firstParameters[id]];
+	}
+	return size;
+}
+
+void GrammarXmlWriter::planJobs(unsigned long long targetSize,
+		bool useFormatting, string & trailingOutput)
+{
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+
+	string plannedOutput;
+	XmlSerializer serializer(plannedOutput, useFormatting);
+
+	planningBindings.clear();
+	jobs.clear();
+	pJobStart = 0;
+	jobSize = 0;
+
+	// the binary tree is traversed like in expand(), but every subtree
+	// (or element) fitting into the current job is skipped
+	vector<StackEntry> stack;
+	StackEntry root = { dagGrammar[0]->getRightHandSide(), NO_BINDING, 0 };
+	stack.push_back(root);
+
+	while (!stack.empty()) {
+
+		StackEntry entry = stack.back();
+		stack.pop_back();
+
+		// a worker stops in front of the first node taken from its stack
+		// which is beyond its range, hence, a job cannot span a node
+		// taken from our stack
+		finishJob(serializer, plannedOutput);
+
+		if (entry.pClosingSymbol != 0) {
+			serializer.writeClosingTag(entry.pClosingSymbol);
+			continue;
+		}
+
+		TreeNode * pNode = entry.pNode;
+		unsigned int binding = entry.binding;
+
+		while (pNode != 0) {
+
+			unsigned long long size = getSize(pNode, binding);
+			if (jobSize + size <= targetSize) {
+				if (pJobStart == 0) {
+					pJobStart = pNode;
+					jobStartBinding = binding;
+				}
+				jobSize += size;
+				break;
+			}
+
+			Symbol * pSymbol = pNode->getSymbol();
+
+			if (pSymbol == pParameterSymbol) {
+				PlanningBinding & current = planningBindings[binding];
+				pNode = current.pCallNode->getChild(
+						parameterIndexes[pNode->getId()]);
+				binding = current.parent;
+				continue;
+			}
+
+			unsigned int id = pSymbol->getId();
+			TreeNode * pRightHandSide = id < rightHandSides.size()
+					? rightHandSides[id] : 0;
+			if (pRightHandSide != 0) {
+				PlanningBinding newBinding;
+				newBinding.pCallNode = pNode;
+				newBinding.parent = binding;
+				newBinding.argumentSizes.push_back(0);
+				for (unsigned int i = 0; i < pNode->getCurrentChildrenCount(); i++) {
+					newBinding.argumentSizes.push_back(
+							newBinding.argumentSizes.back()
+							+ getSize(pNode->getChild(i), binding));
+				}
+				planningBindings.push_back(newBinding);
+				binding = planningBindings.size() - 1;
+				pNode = pRightHandSide;
+				continue;
+			}
+
+			TreeNode * pLeftChild = 0, * pRightChild = 0;
+			if (pSymbol->hasLeftChild()) {
+				pLeftChild = pNode->getChild(0);
+				if (pSymbol->hasRightChild()) {
+					pRightChild = pNode->getChild(1);
+				}
+			} else if (pSymbol->hasRightChild()) {
+				pRightChild = pNode->getChild(0);
+			}
+
+			// the size of the element without its following siblings
+			size = 1 + (pLeftChild != 0 ? getSize(pLeftChild, binding) : 0);
+			if (jobSize + size > targetSize) {
+				finishJob(serializer, plannedOutput);
+			}
+
+			if (size <= targetSize) {
+				if (pJobStart == 0) {
+					pJobStart = pNode;
+					jobStartBinding = binding;
+				}
+				jobSize += size;
+				pNode = pRightChild;
+				continue;
+			}
+
+			// the element is too large for a single job
+			serializer.writeOpeningTag(pSymbol);
+			if (pRightChild != 0) {
+				StackEntry right = { pRightChild, binding, 0 };
+				stack.push_back(right);
+			}
+			StackEntry closing = { 0, NO_BINDING, pSymbol };
+			stack.push_back(closing);
+			pNode = pLeftChild;
+		}
+	}
+
+	finishJob(serializer, plannedOutput);
+	serializer.flush();
+	trailingOutput.swap(plannedOutput);
+}
+
+void GrammarXmlWriter::finishJob(XmlSerializer & serializer,
+		string & plannedOutput)
+{
+	if (pJobStart == 0) {
+		return;
+	}
+
+	serializer.flush();
+
+	jobs.push_back(Job());
+	Job & job = jobs.back();
+	job.pNode = pJobStart;
+	for (unsigned int binding = jobStartBinding; binding != NO_BINDING;
+			binding = planningBindings[binding].parent) {
+		job.callNodes.push_back(planningBindings[binding].pCallNode);
+	}
+	job.numberOfNodes = jobSize;
+	job.precedingOutput.swap(plannedOutput);
+	job.done = false;
+
+	pJobStart = 0;
+	jobSize = 0;
+}
+
+#if defined(__GNUC__)
+void GrammarXmlWriter::writeInParallel(ostream & out, bool useFormatting,
+		unsigned int numberOfThreads)
+{
+	numberOfNodes = nodeSizes[dagGrammar[0]->getRightHandSide()->getId()];
+	unsigned long long targetSize = numberOfNodes
+			/ (numberOfThreads * DECOMPRESSION_JOBS_PER_THREAD);
+	if (targetSize < MIN_DECOMPRESSION_JOB_SIZE) {
+		targetSize = MIN_DECOMPRESSION_JOB_SIZE;
+	}
+
+	string trailingOutput;
+	planJobs(targetSize, useFormatting, trailingOutput);
+	vector<PlanningBinding>().swap(planningBindings);
+
+	WorkerContext context;
+	context.pWriter = this;
+	context.useFormatting = useFormatting;
+	context.nextJob = 0;
+	context.writtenJobs = 0;
+	context.maxJobsAhead = 2 * numberOfThreads;
+	pthread_mutex_init(&context.mutex, 0);
+	pthread_cond_init(&context.jobDone, 0);
+	pthread_cond_init(&context.jobWritten, 0);
+
+	vector<pthread_t> threads(numberOfThreads);
+	for (unsigned int i = 0; i < numberOfThreads; i++) {
+		if (pthread_create(&threads[i], 0, runWorker, &context) != 0) {
+			cout << "Fatal error: Could not create thread. Exiting ..." << endl;
+			exit(1);
+		}
+	}
+
+	// the output of the jobs is written in document order as soon as
+	// it is available
+	for (unsigned int i = 0; i < jobs.size(); i++) {
+		Job & job = jobs[i];
+		out.write(job.precedingOutput.data(), job.precedingOutput.size());
+		string().swap(job.precedingOutput);
+
+		pthread_mutex_lock(&context.mutex);
+		while (!job.done) {
+			pthread_cond_wait(&context.jobDone, &context.mutex);
+		}
+		pthread_mutex_unlock(&context.mutex);
+
+		out.write(job.output.data(), job.output.size());
+		string().swap(job.output);
+
+		pthread_mutex_lock(&context.mutex);
+		context.writtenJobs = i + 1;
+		pthread_cond_broadcast(&context.jobWritten);
+		pthread_mutex_unlock(&context.mutex);
+	}
+	out.write(trailingOutput.data(), trailingOutput.size());
+	out.flush();
+
+	for (unsigned int i = 0; i < numberOfThreads; i++) {
+		pthread_join(threads[i], 0);
+	}
+
+	pthread_cond_destroy(&context.jobWritten);
+	pthread_cond_destroy(&context.jobDone);
+	pthread_mutex_destroy(&context.mutex);
+	jobs.clear();
+}
+
+void * GrammarXmlWriter::runWorker(void * pContextPar)
+{
+	WorkerContext & context = *((WorkerContext *) pContextPar);
+	GrammarXmlWriter & writer = *context.pWriter;
+	Expansion expansion;
+
+	while (true) {
+
+		pthread_mutex_lock(&context.mutex);
+		while (context.nextJob < writer.jobs.size()
+				&& context.nextJob >= context.writtenJobs + context.maxJobsAhead) {
+			pthread_cond_wait(&context.jobWritten, &context.mutex);
+		}
+		if (context.nextJob >= writer.jobs.size()) {
+			pthread_mutex_unlock(&context.mutex);
+			break;
+		}
+		Job & job = writer.jobs[context.nextJob++];
+		pthread_mutex_unlock(&context.mutex);
+
+		// the chain of bindings the range starts in is rebuilt from the
+		// outermost binding on
+		expansion.bindings.clear();
+		expansion.freeBindings.clear();
+		expansion.stack.clear();
+		unsigned int binding = NO_BINDING;
+		for (unsigned int i = job.callNodes.size(); i > 0; i--) {
+			binding = expansion.createBinding(job.callNodes[i - 1], binding);
+		}
+
+		string output;
+		XmlSerializer serializer(output, context.useFormatting);
+		unsigned long long nodes = writer.expand(expansion, job.pNode, binding,
+				job.numberOfNodes, serializer);
+		serializer.flush();
+
+		if (nodes != job.numberOfNodes) {
+			cout << "Fatal error: " << nodes << " nodes were expanded instead of "
+					<< job.numberOfNodes << ". Exiting ..." << endl;
+			exit(1);
+		}
+
+		pthread_mutex_lock(&context.mutex);
+		job.output.swap(output);
+		job.done = true;
+		pthread_cond_broadcast(&context.jobDone);
+		pthread_mutex_unlock(&context.mutex);
+	}
+
+	return 0;
+}
+#endif
@@ -0,0 +1,348 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "BoundedQueue.h"
+#include "Grammar.h"
+#include "TreeNode.h"
+#include "Symbol.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class GrammarNavigator;
+class XmlSerializer;
+
+/**
+ * Writes the unranked tree represented by a linear SLCF tree grammar
+ * as XML document without computing val(G) in memory. The productions
+ * are expanded lazily while the binary tree is traversed: an explicit
+ * stack holds the nodes still to visit together with the parameter
+ * bindings of the production instance they belong to. The tags are
+ * written by a XmlSerializer; the output is identical to the one of
+ * XmlTreePrinter for the expanded tree.
+ *
+ * The memory needed is linear in the size of the grammar plus the
+ * depth of the tree. The running time is linear in the size of the
+ * output.
+ *
+ * The document can be written by several threads, too. The expanded
+ * sizes of the productions are used to cut the binary tree into ranges
+ * of consecutive nodes of about the same size. Every range is expanded
+ * and serialized into its own buffer by a worker thread and the buffers
+ * are written in document order.
+ *
+ * Alternatively, the nodes of the start production can be streamed in
+ * preorder (e.g., while another thread decodes them). A streamed node
+ * is expanded as soon as it arrives. This works since the arguments of
+ * a nonterminal follow it in preorder and the parameters of a
+ * right-hand side are visited in the order of their indexes.
+ *
+ * Finally, a range of elements can be written alone. A GrammarNavigator
+ * locates the first of them without expanding the productions in front
+ * of it, and the expansion stops behind the last one.
+ */
+class GrammarXmlWriter
+{
+public:
+	/**
+	 * The constructor.
+	 * @param dagGrammar the grammar containing the start production
+	 * @param mainGrammar the grammar containing the remaining productions
+	 */
+	GrammarXmlWriter(Grammar & dagGrammar, Grammar & mainGrammar);
+	~GrammarXmlWriter(void);
+
+	/**
+	 * Writes the XML document represented by the grammar.
+	 * @param out the output stream to write to
+	 * @param useFormatting specifies if every tag shall be followed by
+	 *  a line break
+	 * @param numberOfThreads the number of worker threads to use (the
+	 *  document is written by the calling thread alone if it is 1)
+	 */
+	void writeXml(ostream & out, bool useFormatting = false,
+			unsigned int numberOfThreads = 1);
+
+#if defined(__GNUC__)
+	/**
+	 * Writes the XML document represented by the productions of the
+	 * main grammar and the streamed start production.
+	 * @param out the output stream to write to
+	 * @param startProduction the queue delivering the symbols of the
+	 *  nodes of the right-hand side of the start production in preorder;
+	 *  writing stops as soon as it delivers 0 (i.e., decoding failed)
+	 * @param useFormatting specifies if every tag shall be followed by
+	 *  a line break
+	 */
+	void writeXml(ostream & out, BoundedQueue<Symbol *> & startProduction,
+			bool useFormatting = false);
+#endif
+
+	/**
+	 * Writes the elements with the preorder numbers start, ...,
+	 * start + count - 1 of the XML document represented by the grammar.
+	 * An element is enclosed by its ancestors only if they are written,
+	 * too, i.e., the output is a sequence of XML fragments if the range
+	 * does not consist of a subtree.
+	 * @param out the output stream to write to
+	 * @param navigator a navigator on the same grammar
+	 * @param start the preorder number of the first element to write
+	 * @param count the number of elements to write
+	 * @param useFormatting specifies if every tag shall be followed by
+	 *  a line break
+	 */
+	void writeXml(ostream & out, GrammarNavigator & navigator,
+			unsigned long long start, unsigned long long count,
+			bool useFormatting = false);
+
+	/**
+	 * Returns the number of edges of the binary tree written by the last
+	 * call of GrammarXmlWriter::writeXml().
+	 */
+	unsigned long long getNumberOfEdges() {
+		return numberOfNodes > 0 ? numberOfNodes - 1 : 0;
+	};
+
+private:
+	/**
+	 * The parameter bindings of an instance of a production, i.e., the
+	 * node labeled by the nonterminal which was replaced by it. The
+	 * i-th parameter of the right-hand side refers to the i-th child of
+	 * this node (in the context of the parent binding).
+	 */
+	struct Binding
+	{
+		TreeNode * pCallNode;
+		unsigned int parent;
+		unsigned int refCount;
+	};
+
+	/**
+	 * An entry of the stack of pending work. Either a node which is
+	 * still to visit in the context of a binding or a terminal whose
+	 * closing tag is still to write (then pClosingSymbol is not 0).
+	 */
+	struct StackEntry
+	{
+		TreeNode * pNode;
+		unsigned int binding;
+		Symbol * pClosingSymbol;
+	};
+
+	/**
+	 * Indicates that a node does not belong to an instance of a
+	 * production (i.e., it belongs to the start production).
+	 */
+	static const unsigned int NO_BINDING = 0xFFFFFFFF;
+
+	/**
+	 * Stands for the next subtree of the streamed start production (a
+	 * binding with this call node takes its arguments from the stream).
+	 */
+	static TreeNode * const STREAMED_NODE;
+
+	/**
+	 * The state of one expansion of (a part of) the tree. Bindings
+	 * are reference counted and reused as soon as they are released.
+	 */
+	class Expansion
+	{
+	public:
+		/**
+		 * Creates a binding with a reference count of one. The reference
+		 * of the caller to the parent binding is passed on to it.
+		 */
+		unsigned int createBinding(TreeNode * pCallNode, unsigned int parent);
+
+		void retainBinding(unsigned int binding) {
+			if (binding != NO_BINDING) {
+				bindings[binding].refCount++;
+			}
+		};
+
+		/**
+		 * Drops a reference to the specified binding.
+		 */
+		void releaseBinding(unsigned int binding);
+
+		vector<Binding> bindings;
+		vector<unsigned int> freeBindings;
+		vector<StackEntry> stack;
+	};
+
+	/**
+	 * A range of consecutive terminal nodes of the binary tree which is
+	 * written by a worker thread. The range starts at a node in the
+	 * context of a chain of bindings.
+	 */
+	struct Job
+	{
+		TreeNode * pNode;
+
+		/**
+		 * The call nodes of the chain of bindings, innermost first.
+		 */
+		vector<TreeNode *> callNodes;
+
+		unsigned long long numberOfNodes;
+
+		/**
+		 * The output written by the planning thread in front of the
+		 * range and the output of the range itself.
+		 */
+		string precedingOutput;
+		string output;
+
+		bool done;
+	};
+
+	/**
+	 * A binding of the planning thread. In addition to the call node,
+	 * it keeps the prefix sums of the expanded sizes of the arguments.
+	 */
+	struct PlanningBinding
+	{
+		TreeNode * pCallNode;
+		unsigned int parent;
+		vector<unsigned long long> argumentSizes;
+	};
+
+	/**
+	 * The state shared by the worker threads (defined in the
+	 * implementation file).
+	 */
+	struct WorkerContext;
+
+	/**
+	 * Expands the tree starting with the specified node in the context
+	 * of the specified binding and writes the tags of at most maxNodes
+	 * terminal nodes. The expansion stops in front of the first node
+	 * beyond this limit (closing tags which are still pending are
+	 * written up to the next entry of the stack which is not a closing
+	 * tag, the remaining entries are left on the stack).
+	 * @returns the number of terminal nodes written
+	 */
+	unsigned long long expand(Expansion & expansion, TreeNode * pStart,
+			unsigned int startBinding, unsigned long long maxNodes,
+			XmlSerializer & serializer);
+
+#if defined(__GNUC__)
+	/**
+	 * Writes the document using the specified number of worker threads.
+	 * The sizes must have been computed by computeSizes().
+	 */
+	void writeInParallel(ostream & out, bool useFormatting,
+			unsigned int numberOfThreads);
+#endif
+
+	/**
+	 * Computes the sizes of the expanded subtrees of all nodes of the
+	 * right-hand sides (not counting the arguments of parameters) and
+	 * the ranges of parameters below them.
+	 */
+	void computeSizes();
+
+	/**
+	 * Returns the number of terminal nodes of the expanded subtree of
+	 * the specified node in the context of the specified planning
+	 * binding.
+	 */
+	unsigned long long getSize(TreeNode * pNode, unsigned int binding);
+
+	/**
+	 * Cuts the binary tree into jobs of at most targetSize nodes. The
+	 * nodes not covered by any job are written into the preceding
+	 * output of the jobs (or into trailingOutput behind the last job).
+	 */
+	void planJobs(unsigned long long targetSize, bool useFormatting,
+			string & trailingOutput);
+
+	/**
+	 * Turns the range of nodes collected by the planning thread (if
+	 * any) into a job.
+	 */
+	void finishJob(XmlSerializer & serializer, string & plannedOutput);
+
+#if defined(__GNUC__)
+	/**
+	 * The main function of a worker thread.
+	 */
+	static void * runWorker(void * pContext);
+#endif
+
+	/**
+	 * The grammar containing the start production.
+	 */
+	Grammar & dagGrammar;
+
+	/**
+	 * The grammar containing the remaining productions.
+	 */
+	Grammar & mainGrammar;
+
+	/**
+	 * The right-hand sides of the productions by the ids of their
+	 * left-hand sides (0 for terminal symbols).
+	 */
+	vector<TreeNode *> rightHandSides;
+
+	/**
+	 * The indexes of the parameter nodes of the right-hand sides by
+	 * node id.
+	 */
+	vector<unsigned int> parameterIndexes;
+
+#if defined(__GNUC__)
+	/**
+	 * The queue delivering the streamed start production (0 if the
+	 * start production is not streamed).
+	 */
+	BoundedQueue<Symbol *> * pStartProduction;
+#endif
+
+	/**
+	 * By node id: the number of terminal nodes of the expanded subtree
+	 * (not counting the arguments of parameters), the index of the first
+	 * parameter below the node and the number of these parameters. They
+	 * are only computed when writing in parallel.
+	 */
+	vector<unsigned long long> nodeSizes;
+	vector<unsigned int> firstParameters;
+	vector<unsigned int> parameterCounts;
+
+	/**
+	 * The bindings of the planning thread.
+	 */
+	vector<PlanningBinding> planningBindings;
+
+	/**
+	 * The jobs of a parallel run and the range of nodes which is being
+	 * collected for the next job by the planning thread.
+	 */
+	vector<Job> jobs;
+	TreeNode * pJobStart;
+	unsigned int jobStartBinding;
+	unsigned long long jobSize;
+
+	unsigned long long numberOfNodes;
+};
@@ -18,19 +18,16 @@
  */
 #include "HuffmanDecoding.h"
 
-#include "HuffmanTreeNode.h"
-#include "HuffmanSuccinctReader.h"
-
 #include "TreeRePairConstants.h"
 #include "Helper.h"
 
-#include <string>
 #include <cmath>
 
 using namespace std;
 
 HuffmanDecoding::HuffmanDecoding(BitReader * pBitReaderPar) :
-	Huffman(), numberOfCodeLengths(0), pBitReader(pBitReaderPar)
+	numberOfCodeLengths(0), pBitReader(pBitReaderPar), maximumCodeLength(0),
+			lookupBits(0)
 {
 	rlcMaxRepNonNullCodeLength = (unsigned int)pow(2.0, RLC_NON_NULL_CODE_LENGTH_BITS) + RLC_MAX_RUN_LENGTH;
 	rlcMaxRepNullCodeLengthFew = (unsigned int)pow(2.0, RLC_NULL_CODE_LENGTH_FEW_BITS) + RLC_MAX_RUN_LENGTH;
@@ -43,42 +40,74 @@ HuffmanDecoding::~HuffmanDecoding()
 
 unsigned int HuffmanDecoding::readNext(bool lookAhead)
 {
-	HuffmanTreeNode * pCurrentNode = pRootNode;
-	string currentBit;
-	unsigned int childIndex;
+	if (maximumCodeLength == 0)
+	{
+		// there is no code to read
+		return 0;
+	}
 
-	unsigned int length = 1;
-	while (true)
+	const LookupEntry & entry = lookupTable[pBitReader->peek(lookupBits)];
+
+	unsigned int symbol = entry.symbol;
+	unsigned int length = entry.length;
+	if (length == 0 && !readLongCode(symbol, length))
 	{
-		currentBit = pBitReader->readBitString(length, true);
-		if (currentBit.at(length - 1) == '0')
-		{
-			childIndex = 0;
-		}
-		else
-		{
-			childIndex = 1;
-		}
+		cout << "Fatal error: Invalid Huffman code. Exiting ..." << endl;
+		exit(1);
+	}
 
-		if (pCurrentNode->getChild(childIndex) != 0)
-		{
-			pCurrentNode = pCurrentNode->getChild(childIndex);
-		}
-		else
+	if (!lookAhead)
+	{
+		pBitReader->consume(length);
+		if (pBitReader->isPastEnd())
 		{
-			break;
+			cout << "Fatal error: Unexpected end of file. Exiting ..." << endl;
+			exit(1);
 		}
+	}
+
+	return symbol;
+}
+
+bool HuffmanDecoding::tryReadNext(unsigned int & symbol)
+{
+	symbol = 0;
+	if (maximumCodeLength == 0)
+	{
+		// there is no code to read
+		return true;
+	}
+
+	const LookupEntry & entry = lookupTable[pBitReader->peek(lookupBits)];
 
-		length++;
+	symbol = entry.symbol;
+	unsigned int length = entry.length;
+	if (length == 0 && !readLongCode(symbol, length))
+	{
+		return false;
 	}
-	// 00
 
-	if (!lookAhead)
+	pBitReader->consume(length);
+	return !pBitReader->isPastEnd();
+}
+
+bool HuffmanDecoding::readLongCode(unsigned int & symbol, unsigned int & length)
+{
+	uint64_t bits = pBitReader->peek(maximumCodeLength);
+
+	for (length = lookupBits + 1; length <= maximumCodeLength; length++)
 	{
-		pBitReader->readBitString(length - 1, false);
+		uint64_t code = bits >> (maximumCodeLength - length);
+		if (code >= firstCodes[length]
+				&& code - firstCodes[length] < lengthCounts[length])
+		{
+			symbol = sortedSymbols[symbolOffsets[length] + (code
+					- firstCodes[length])];
+			return true;
+		}
 	}
 
-	return pCurrentNode->getSymbol();
+	return false;
 }
 
 void HuffmanDecoding::processCodeLengths(HuffmanDecoding * pDecoding)
@@ -95,8 +124,13 @@ void HuffmanDecoding::processCodeLengths(HuffmanDecoding * pDecoding)
 		codeLengths = readHuffmanCodedCodeLengths(pDecoding);
 	}
 
-	HASH_I_S codesHashMap = reconstructHuffmanCodes(codeLengths);
-	reconstructHuffmanTree(codesHashMap);
+	if (pBitReader->isPastEnd())
+	{
+		cout << "Fatal error: Unexpected end of file. Exiting ..." << endl;
+		exit(1);
+	}
+
+	buildDecodingTables(codeLengths);
 
 	// printCoding();
 }
@@ -105,19 +139,16 @@ vector<unsigned int> HuffmanDecoding::readFixedCodedCodeLengths()
 {
 	vector<unsigned int> codeLengths;
 
-	unsigned int bitsPerCodeLength = HuffmanSuccinctReader::binaryToDec(
-			pBitReader->readBitString(CODE_LENGTH_BITS));
+	unsigned int bitsPerCodeLength = pBitReader->readBits(CODE_LENGTH_BITS);
 //	cout << "bits per code length: " << bitsPerCodeLength << endl;
 
-	numberOfCodeLengths = HuffmanSuccinctReader::binaryToDec(
-			pBitReader->readBitString(CODE_LENGTH_BITS));
+	numberOfCodeLengths = pBitReader->readBits(CODE_LENGTH_BITS);
 //	cout << "number of code lengths: " << numberOfCodeLengths << endl;
 
 	unsigned int codeLength;
 	for (unsigned int i = 0; i < numberOfCodeLengths; i++)
 	{
-		codeLength = HuffmanSuccinctReader::binaryToDec(pBitReader->readBitString(
-				bitsPerCodeLength));
+		codeLength = pBitReader->readBits(bitsPerCodeLength);
 		codeLengths.push_back(codeLength);
 		// cout << codeLength << endl;
 	}
@@ -132,8 +163,7 @@ vector<unsigned int> HuffmanDecoding::readHuffmanCodedCodeLengths(
 
 	// decode code lengths of first huffman tree
 
-	unsigned int numberOfCodeLengths = HuffmanSuccinctReader::binaryToDec(
-			pBitReader->readBitString(CODE_LENGTH_BITS));
+	unsigned int numberOfCodeLengths = pBitReader->readBits(CODE_LENGTH_BITS);
 
 //	cout << "number of code lengths: " << numberOfCodeLengths << endl;
 
@@ -167,8 +197,7 @@ vector<unsigned int> HuffmanDecoding::readHuffmanCodedCodeLengths(
 
 					pSuperHuffmanCoding->readNext(false);
 
-					unsigned int add = HuffmanSuccinctReader::binaryToDec(
-							pBitReader->readBitString(RLC_NON_NULL_CODE_LENGTH_BITS))
+					unsigned int add = pBitReader->readBits(RLC_NON_NULL_CODE_LENGTH_BITS)
 							+ RLC_MAX_RUN_LENGTH + 1;
 					runLength += add;
 
@@ -211,8 +240,7 @@ vector<unsigned int> HuffmanDecoding::readHuffmanCodedCodeLengths(
 			while (runlengthCodingType == 3 && counter + runLength
 					< numberOfCodeLengths)
 			{
-				unsigned int add = HuffmanSuccinctReader::binaryToDec(
-						pBitReader->readBitString(RLC_NULL_CODE_LENGTH_MANY_BITS))
+				unsigned int add = pBitReader->readBits(RLC_NULL_CODE_LENGTH_MANY_BITS)
 						+ rlcMaxRepNullCodeLengthFew + 1;
 				runLength += add;
 
@@ -234,8 +262,7 @@ vector<unsigned int> HuffmanDecoding::readHuffmanCodedCodeLengths(
 			if (runlengthCodingType == 2 && counter + runLength
 					< numberOfCodeLengths)
 			{
-				unsigned int add = HuffmanSuccinctReader::binaryToDec(
-						pBitReader->readBitString(RLC_NULL_CODE_LENGTH_FEW_BITS))
+				unsigned int add = pBitReader->readBits(RLC_NULL_CODE_LENGTH_FEW_BITS)
 						+ RLC_MAX_RUN_LENGTH + 1;
 				runLength += add;
 
@@ -260,94 +287,104 @@ vector<unsigned int> HuffmanDecoding::readHuffmanCodedCodeLengths(
 	return codeLengths;
 }
 
-void HuffmanDecoding::reconstructHuffmanTree(HASH_I_S codesHashMap)
-{
-
-	pRootNode = new HuffmanTreeNode();
-
-	HASH_I_S::iterator it;
-	for (it = codesHashMap.begin(); it != codesHashMap.end(); it++)
-	{
-		HuffmanTreeNode * pCurrentNode = pRootNode;
-
-		string strRepr = it->second;
-		unsigned int childIndex = 0;
-		for (unsigned int j = 0; j < strRepr.length(); j++)
-		{
-			if (strRepr.at(j) == '1')
-			{
-				childIndex = 1;
-			}
-			else
-			{
-				childIndex = 0;
-			}
-
-			if (pCurrentNode->getChild(childIndex) == 0)
-			{
-				pCurrentNode->setChild(childIndex, new HuffmanTreeNode());
-			}
-
-			pCurrentNode = pCurrentNode->getChild(childIndex);
-		}
-
-		pCurrentNode->setBitRepresentation(it->second);
-		pCurrentNode->setSymbol(it->first);
-		(*pHashedHuffmanTreeNodes)[it->first] = pCurrentNode;
-	}
-
-}
-
 // see page 7 in DEFLATE specfication
-HASH_I_S HuffmanDecoding::reconstructHuffmanCodes(
-		vector<unsigned int> codeLengths)
+void HuffmanDecoding::buildDecodingTables(
+		const vector<unsigned int> & codeLengths)
 {
-	unsigned int maximumCodeLength = 0;
+	maximumCodeLength = 0;
 	for (unsigned int i = 0; i < codeLengths.size(); i++)
 	{
-		if (maximumCodeLength < codeLengths.at(i))
+		if (maximumCodeLength < codeLengths[i])
 		{
-			maximumCodeLength = codeLengths.at(i);
+			maximumCodeLength = codeLengths[i];
 		}
 	}
 
-	unsigned int ** bl_count = new unsigned int *[maximumCodeLength + 1];
-	unsigned int ** next_code = new unsigned int *[maximumCodeLength + 1];
-
-	for (unsigned int i = 0; i <= maximumCodeLength; i++)
+	if (maximumCodeLength > BitReader::MAX_PEEK_BITS)
 	{
-		bl_count[i] = new unsigned int(0);
-		next_code[i] = new unsigned int(0);
+		cout << "Fatal error: Huffman codes with more than "
+				<< BitReader::MAX_PEEK_BITS << " bits are not supported. "
+				"Exiting ..." << endl;
+		exit(1);
 	}
 
+	lengthCounts.assign(maximumCodeLength + 1, 0);
 	for (unsigned int symbol = 0; symbol < codeLengths.size(); symbol++)
 	{
-		unsigned int codeLength = codeLengths.at(symbol);
-		unsigned int * count = bl_count[codeLength];
-		(*count)++;
+		lengthCounts[codeLengths[symbol]]++;
 	}
+	lengthCounts[0] = 0;
 
-	unsigned int code = 0;
-	(*(bl_count[0])) = 0;
-
+	firstCodes.assign(maximumCodeLength + 1, 0);
+	symbolOffsets.assign(maximumCodeLength + 1, 0);
+	uint64_t code = 0;
 	for (unsigned int bits = 1; bits <= maximumCodeLength; bits++)
 	{
-		code = (code + (*(bl_count[bits - 1]))) << 1;
-		(*(next_code[bits])) = code;
+		code = (code + lengthCounts[bits - 1]) << 1;
+
+		// a corrupt input may specify more codes than there are bit
+		// strings of a length (violating the Kraft inequality); the codes
+		// would index the tables below out of their bounds
+		if (code + lengthCounts[bits] > (((uint64_t) 1) << bits))
+		{
+			cout << "Fatal error: Invalid Huffman code lengths. Exiting ..."
+					<< endl;
+			exit(1);
+		}
+
+		firstCodes[bits] = code;
+		symbolOffsets[bits] = symbolOffsets[bits - 1] + lengthCounts[bits - 1];
 	}
 
-	HASH_I_S codesHashMap;
+	// the codes of the same length are assigned in increasing order of
+	// the symbols
+	sortedSymbols.assign(symbolOffsets[maximumCodeLength]
+			+ lengthCounts[maximumCodeLength], 0);
+	vector<unsigned int> nextOffsets(symbolOffsets);
 	for (unsigned int symbol = 0; symbol < codeLengths.size(); symbol++)
 	{
-		unsigned int codeLength = codeLengths.at(symbol);
+		unsigned int codeLength = codeLengths[symbol];
 		if (codeLength != 0)
 		{
-			codesHashMap[symbol] = convertUintToBinary(
-					(*(next_code[codeLength])), codeLength);
-			(*(next_code[codeLength]))++;
+			sortedSymbols[nextOffsets[codeLength]++] = symbol;
 		}
 	}
 
-	return codesHashMap;
+	// each code not longer than the lookup bits fills all entries of
+	// the lookup table whose index starts with the code
+	lookupBits = min(maximumCodeLength, (unsigned int) HUFFMAN_LOOKUP_BITS);
+	LookupEntry longCode = { 0, 0 };
+	lookupTable.assign(((size_t) 1) << lookupBits, longCode);
+	for (unsigned int length = 1; length <= lookupBits; length++)
+	{
+		for (unsigned int i = 0; i < lengthCounts[length]; i++)
+		{
+			unsigned int shift = lookupBits - length;
+			uint64_t first = (firstCodes[length] + i) << shift;
+			LookupEntry entry = { sortedSymbols[symbolOffsets[length] + i],
+					length };
+			for (uint64_t j = 0; j < (((uint64_t) 1) << shift); j++)
+			{
+				lookupTable[first + j] = entry;
+			}
+		}
+	}
 }
 
+#ifdef DEBUG
+void HuffmanDecoding::printCoding()
+{
+	for (unsigned int length = 1; length <= maximumCodeLength; length++)
+	{
+		for (unsigned int i = 0; i < lengthCounts[length]; i++)
+		{
+			cout << sortedSymbols[symbolOffsets[length] + i] << ": ";
+			for (int j = length - 1; j >= 0; j--)
+			{
+				cout << (((firstCodes[length] + i) >> j) & 1);
+			}
+			cout << endl;
+		}
+	}
+}
+#endif
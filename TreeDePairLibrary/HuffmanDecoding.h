@@ -18,21 +18,22 @@
  */
 #pragma once
 
-#include "Huffman.h"
 #include "BitReader.h"
-#include "HuffmanTreeNode.h"
-#include "TreeRePairTypes.h"
 
 #include <vector>
+#include <stdint.h>
 
 using namespace std;
 
 /**
- * This class reconstructs a Huffman tree from its list of code
- * lengths which is either encoded using another Huffman coding
- * or using a fixed-length coding.
+ * This class reconstructs a canonical Huffman coding from its list of
+ * code lengths which is either encoded using another Huffman coding
+ * or using a fixed-length coding. Symbols are decoded by a table
+ * lookup on the next HUFFMAN_LOOKUP_BITS bits of the input. Longer
+ * codes are resolved using the first code and the number of codes of
+ * each code length.
  */
-class HuffmanDecoding: public Huffman
+class HuffmanDecoding
 {
 public:
 	/**
@@ -56,8 +57,8 @@ public:
 
 	/**
 	 * This method reads the next bits from the BitReader instance
-	 * and tries to decode it using the Huffman tree which was
-	 * constructed before using the method processCodeLengths.
+	 * and tries to decode it using the Huffman coding which was
+	 * reconstructed before using the method processCodeLengths.
 	 * @param lookAhead If this parameter is set to true the bits
 	 *  are removed from the input stream used by the BitReader
 	 *  instance, i.e., they cannot be read again. The default is
@@ -66,6 +67,16 @@ public:
 	 */
 	unsigned int readNext(bool lookAhead = false);
 
+	/**
+	 * Like HuffmanDecoding::readNext(), but an invalid code or the end
+	 * of the input is reported to the caller instead of exiting. This is
+	 * needed when decoding in a thread other than the main thread.
+	 * @param symbol is set to the integer which was read
+	 * @returns false if the next bits are not a valid code or lie beyond
+	 *  the end of the input
+	 */
+	bool tryReadNext(unsigned int & symbol);
+
 	/**
 	 * Returns the number of code lengths which is necessary to represent
 	 * the Huffman tree by the enumeration of its code lengths.
@@ -74,25 +85,39 @@ public:
 		return numberOfCodeLengths;
 	};
 
+#ifdef DEBUG
+	void printCoding();
+#endif
+
 private:
 	/**
-	 * This method reconstructs the Huffman codes of the Huffman coding
-	 * after the code lengths have been retrieved (and decoded) from
-	 * the input stream.
-	 * @param codeLengths the code lengths by which the Huffman tree
+	 * An entry of the lookup table. If the length is 0, then the
+	 * code starting with the bits of the index is longer than the
+	 * lookup bits.
+	 */
+	struct LookupEntry
+	{
+		unsigned int symbol;
+		unsigned int length;
+	};
+
+	/**
+	 * Builds the decoding tables from the code lengths which have been
+	 * retrieved (and decoded) from the input stream. The codes are
+	 * assigned like in the canonical Huffman coding of DEFLATE (see
+	 * page 7 in DEFLATE specification).
+	 * @param codeLengths the code lengths by which the Huffman coding
 	 *  is represented
-	 * @returns a hash map allowing constant time access to the Huffman
-	 *  code of each input symbol encoded by the Huffman coding
 	 */
-	HASH_I_S reconstructHuffmanCodes(vector<unsigned int> codeLengths);
+	void buildDecodingTables(const vector<unsigned int> & codeLengths);
 
 	/**
-	 * Reconstructs the Huffman tree after the Huffman codes have
-	 * been reconstructed from the enumeration of code lengths.
-	 * @param codesHashMap the hash map assigning each input symbol
-	 *  its Huffman code
+	 * Decodes a code which is longer than the lookup bits.
+	 * @param symbol is set to the decoded symbol
+	 * @param length is set to the length of the decoded code
+	 * @returns false if the next bits are not a valid code
 	 */
-	void reconstructHuffmanTree(HASH_I_S codesHashMap);
+	bool readLongCode(unsigned int & symbol, unsigned int & length);
 
 	/**
 	 * Decodes the code lengths supplied by the bit reader using
@@ -115,7 +140,7 @@ private:
 
 	/**
 	 * The bit reader to read the enumeration of code lengths, which
-	 * is used to reconstruct the Huffman tree, from.
+	 * is used to reconstruct the Huffman coding, from.
 	 */
 	BitReader * pBitReader;
 
@@ -139,4 +164,41 @@ private:
 	 * (see Chap. Succinct Coding).
 	 */
 	unsigned int rlcMaxRepNullCodeLengthMany;
+
+	/**
+	 * The length of the longest Huffman code.
+	 */
+	unsigned int maximumCodeLength;
+
+	/**
+	 * The number of bits used to index the lookup table.
+	 */
+	unsigned int lookupBits;
+
+	/**
+	 * Assigns each combination of the next lookup bits the symbol whose
+	 * code is a prefix of it.
+	 */
+	vector<LookupEntry> lookupTable;
+
+	/**
+	 * The first (i.e., smallest) code of each code length.
+	 */
+	vector<uint64_t> firstCodes;
+
+	/**
+	 * The number of codes of each code length.
+	 */
+	vector<unsigned int> lengthCounts;
+
+	/**
+	 * The index into HuffmanDecoding::sortedSymbols of the symbol having
+	 * the first code of each code length.
+	 */
+	vector<unsigned int> symbolOffsets;
+
+	/**
+	 * The symbols sorted by their codes.
+	 */
+	vector<unsigned int> sortedSymbols;
 };
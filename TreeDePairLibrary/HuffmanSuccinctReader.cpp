@@ -25,12 +25,14 @@
 
 #include <stack>
 #include <iostream>
+#include <sstream>
 #include <cmath>
 
 using namespace std;
 
 HuffmanSuccinctReader::HuffmanSuccinctReader(char * pFilePath,
-		Grammar & dagGrammarPar, Grammar & mainGrammarPar) :
+		Grammar & dagGrammarPar, Grammar & mainGrammarPar,
+		bool readStartProductionPar) :
 	numberOfTerminals(0), numberOfProductionsMinusStartProd(0), dagGrammar(dagGrammarPar),
 	mainGrammar(mainGrammarPar) {
 
@@ -46,8 +48,8 @@ HuffmanSuccinctReader::HuffmanSuccinctReader(char * pFilePath,
 	// reader other huffman trees
 
 //	cout << "base Huffman coding for start production: " << endl;
-	HuffmanDecoding huffmanCodingStartProduction(pBitReader);
-	huffmanCodingStartProduction.processCodeLengths(&superHuffmanCoding);
+	pHuffmanCodingStartProduction = new HuffmanDecoding(pBitReader);
+	pHuffmanCodingStartProduction->processCodeLengths(&superHuffmanCoding);
 	// pHuffmanDecodingTree->printCoding();
 
 //	cout << "base Huffman coding for productions, numbers, children characteristics: " << endl;
@@ -91,16 +93,59 @@ HuffmanSuccinctReader::HuffmanSuccinctReader(char * pFilePath,
 	readProductions(huffmanCodingProductions);
 
 //	cout << "reading start production" << endl;
-	readStartProduction(huffmanCodingStartProduction);
+	if (readStartProductionPar) {
+		readStartProduction(*pHuffmanCodingStartProduction);
+	}
 }
 
 HuffmanSuccinctReader::~HuffmanSuccinctReader() {
+	delete pHuffmanCodingStartProduction;
 	delete pBitReader;
 
 	pIfs->close();
 	delete pIfs;
 }
 
+#if defined(__GNUC__)
+void HuffmanSuccinctReader::streamStartProduction(BoundedQueue<Symbol *> & queue) {
+
+	// the tree is complete as soon as there is no node left whose
+	// children were not read yet
+	unsigned long long missingNodes = 1;
+
+	while (missingNodes > 0) {
+
+		// this runs in the decoding thread: errors are handed to the
+		// consuming thread, which reports them and exits
+		unsigned int id;
+		if (!pHuffmanCodingStartProduction->tryReadNext(id)) {
+			streamingError = pBitReader->isPastEnd()
+				? "Fatal error when reading start production: "
+					"Unexpected end of file. Exiting ..."
+				: "Fatal error when reading start production: "
+					"Invalid Huffman code. Exiting ...";
+			queue.push(0);
+			return;
+		}
+
+		Symbol * pSymbol = Symbol::getSymbolById(id);
+		if (pSymbol == 0) {
+			ostringstream error;
+			error << "Fatal error when reading start production: Can't find "
+				"symbol with id " << id << ". Exiting ...";
+			streamingError = error.str();
+			queue.push(0);
+			return;
+		}
+
+		queue.push(pSymbol);
+		missingNodes += pSymbol->getRank();
+		missingNodes--;
+	}
+
+}
+#endif
+
 void HuffmanSuccinctReader::readStartProduction(HuffmanDecoding & huffmanDecoding) {
 
 	TreeNode * pRoot = readTree(huffmanDecoding, new unsigned int(0));
@@ -124,11 +169,10 @@ TreeNode * HuffmanSuccinctReader::readTree(HuffmanDecoding & huffmanDecoding,
 	stack<unsigned int*> sumOfRanksStack;
 	sumOfRanksStack.push(new unsigned int(0));
 
-	while (huffmanDecoding.readNext(true) != 0) {
+	while ((currentSymbolId = huffmanDecoding.readNext(true)) != 0) {
 
 //		cout << currentSymbolId << endl;
 
-		currentSymbolId = huffmanDecoding.readNext(true);
 		if (currentSymbolId == Symbol::getParameterSymbol()->getId()) {
 			(*pNumberOfParameters)++;
 		}
@@ -216,7 +260,7 @@ void HuffmanSuccinctReader::readNames(HuffmanDecoding & huffmanDecoding) {
 
 void HuffmanSuccinctReader::readRanks(HuffmanDecoding & huffmanDecoding) {
 
-	string childInfo = pBitReader->readBitString(2);
+	unsigned int childInfo = pBitReader->readBits(2);
 
 	unsigned int numberOfSymbols = huffmanDecoding.readNext();
 
@@ -233,13 +277,13 @@ void HuffmanSuccinctReader::readRanks(HuffmanDecoding & huffmanDecoding) {
 
 		unsigned int childrenCount = 0;
 
-		if (childInfo.at(0) == '1') {
+		if (childInfo & 0x02) {
 			pSymbol->setHasLeftChild(true);
 			childrenCount++;
 		} else {
 			pSymbol->setHasLeftChild(false);
 		}
-		if (childInfo.at(1) == '1') {
+		if (childInfo & 0x01) {
 			pSymbol->setHasRightChild(true);
 			childrenCount++;
 		} else {
@@ -249,18 +293,3 @@ void HuffmanSuccinctReader::readRanks(HuffmanDecoding & huffmanDecoding) {
 		pSymbol->setRank(childrenCount);
 	}
 }
-
-unsigned int HuffmanSuccinctReader::binaryToDec(string binaryRep) {
-
-	unsigned int dec = 0;
-
-	for (short int i = (short int) binaryRep.length() - 1; i >= 0; i--) {
-
-		if (binaryRep.at(i) == '1') {
-			dec += (unsigned int) pow(2.0, (int) (binaryRep.length() - i - 1));
-		}
-
-	}
-
-	return dec;
-}
@@ -19,9 +19,12 @@
 #pragma once
 
 #include "BitReader.h"
+#include "BoundedQueue.h"
 #include "HuffmanDecoding.h"
 #include "Production.h"
 
+#include <string>
+
 using namespace std;
 
 /**
@@ -36,17 +39,35 @@ public:
 	 * @param pFilePath the file containing the succinct coding
 	 * @param dagGrammar the grammar containing the start production
 	 * @param mainGrammar the grammar containing the remaining productions
+	 * @param readStartProductionPar specifies if the start production
+	 *  shall be read, too (otherwise, it has to be streamed using
+	 *  HuffmanSuccinctReader::streamStartProduction())
 	 */
 	HuffmanSuccinctReader(char * pFilePath,
-			Grammar & dagGrammar, Grammar & mainGrammar);
+			Grammar & dagGrammar, Grammar & mainGrammar,
+			bool readStartProductionPar = true);
 	virtual ~HuffmanSuccinctReader();
 
+#if defined(__GNUC__)
 	/**
-	 * Converts a binary number into a decimal number.
-	 * @param strRep the binary number to convert
-	 * @returns the corresponding decimal number
+	 * Decodes the right-hand side of the start production without
+	 * constructing it. The symbols of its nodes are appended to the
+	 * specified queue in preorder. This method may be called from
+	 * another thread than the constructor, but only once and only if
+	 * the start production was not read by the constructor. It never
+	 * exits the process: if the input is corrupt, 0 is appended to the
+	 * queue and the error can be retrieved using
+	 * HuffmanSuccinctReader::getStreamingError().
 	 */
-	static unsigned int binaryToDec(string strRep);
+	void streamStartProduction(BoundedQueue<Symbol *> & queue);
+
+	/**
+	 * Returns the error which stopped streaming the start production
+	 * (an empty string if there was none). May only be called after
+	 * HuffmanSuccinctReader::streamStartProduction() returned.
+	 */
+	const string & getStreamingError() const { return streamingError; };
+#endif
 
 private:
 	/**
@@ -86,6 +107,12 @@ private:
 	 */
 	TreeNode * readTree(HuffmanDecoding & pHuffmanDecoding, unsigned int * pNumberOfParameters);
 
+	/**
+	 * The Huffman coding of the start production. It is kept until the
+	 * start production is streamed.
+	 */
+	HuffmanDecoding * pHuffmanCodingStartProduction;
+
 	/**
 	 * The bit reader to use to read the binary representation of the
 	 * linear SLCF tree grammar.
@@ -121,4 +148,9 @@ private:
 	 * to reconstruct.
 	 */
 	Grammar & mainGrammar;
+
+	/**
+	 * The error which stopped streaming the start production.
+	 */
+	string streamingError;
 };
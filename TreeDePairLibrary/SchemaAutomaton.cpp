@@ -0,0 +1,375 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "SchemaAutomaton.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+const unsigned int SchemaAutomaton::INVALID_STATE;
+const unsigned int SchemaAutomaton::NO_ELEMENT;
+const unsigned int SchemaAutomaton::ANY_ELEMENT;
+const unsigned int SchemaAutomaton::UNKNOWN_STATE;
+
+/**
+ * Advances the specified position to the next character of the
+ * specified string which is no white space.
+ */
+static void skipWhiteSpace(const string & str, string::size_type & position) {
+	while (position < str.size() && isspace((unsigned char) str[position])) {
+		position++;
+	}
+}
+
+/**
+ * Reads the name starting at the specified position.
+ */
+static string readName(const string & str, string::size_type & position) {
+	string::size_type begin = position;
+	while (position < str.size() && !isspace((unsigned char) str[position])
+			&& string("()[],|?*+>%").find(str[position]) == string::npos) {
+		position++;
+	}
+	return str.substr(begin, position - begin);
+}
+
+SchemaAutomaton::SchemaAutomaton(const char * pFilePath)
+{
+	ifstream ifs(pFilePath);
+	if (!ifs) {
+		cout << "Fatal error: Cannot read the DTD " << pFilePath
+				<< ". Exiting ..." << endl;
+		exit(1);
+	}
+	stringstream buffer;
+	buffer << ifs.rdbuf();
+	string text = buffer.str();
+
+	string rootElementType;
+	string::size_type position = text.find('<');
+	while (position != string::npos) {
+		string::size_type end;
+		if (text.compare(position, 4, "<!--") == 0) {
+			end = text.find("-->", position);
+		} else if (text.compare(position, 2, "<?") == 0) {
+			end = text.find("?>", position);
+		} else if (text.compare(position, 9, "<!DOCTYPE") == 0) {
+			// the declarations of the internal subset follow
+			end = position + 9;
+			skipWhiteSpace(text, end);
+			rootElementType = readName(text, end);
+		} else if (text.compare(position, 9, "<!ELEMENT") == 0) {
+			end = text.find('>', position);
+			if (end == string::npos) {
+				fail("Unterminated element type declaration",
+						text.substr(position));
+			}
+			string declaration = text.substr(position, end + 1 - position);
+
+			string::size_type i = 9;
+			skipWhiteSpace(declaration, i);
+			string elementType = readName(declaration, i);
+			if (elementType.empty()) {
+				fail("Missing element type", declaration);
+			}
+			Fragment contentModel = parseContentModel(declaration, i);
+			skipWhiteSpace(declaration, i);
+			if (i != declaration.size() - 1) {
+				fail("Malformed content model", declaration);
+			}
+
+			unsigned int element = addElement(elementType);
+			if (declared[element]) {
+				fail("Duplicate element type declaration", declaration);
+			}
+			declared[element] = true;
+			contentModels[element] = contentModel;
+		} else {
+			// attribute list, entity and notation declarations (the
+			// quoted literals may contain '>')
+			end = position + 1;
+			char quote = 0;
+			while (end < text.size() && (quote != 0 || text[end] != '>')) {
+				if (quote != 0 ? text[end] == quote
+						: text[end] == '"' || text[end] == '\'') {
+					quote = quote != 0 ? 0 : text[end];
+				}
+				end++;
+			}
+		}
+
+		if (end == string::npos || end >= text.size()) {
+			break;
+		}
+		position = text.find('<', end);
+	}
+
+	if (elementIndexes.empty()) {
+		cout << "Fatal error: The DTD " << pFilePath << " does not declare "
+				"any element type. Exiting ..." << endl;
+		exit(1);
+	}
+
+	// the document consists of a single root element
+	Fragment documentModel(addNfaState(), addNfaState());
+	transitions[documentModel.first].push_back(make_pair(
+			rootElementType.empty() ? ANY_ELEMENT : addElement(rootElementType),
+			documentModel.second));
+
+	subsets.push_back(vector<unsigned int>());
+	finalNfaStates.push_back(0);
+	stateTransitions.push_back(vector<unsigned int>());
+
+	vector<unsigned int> nfaStates(1, documentModel.first);
+	documentState = getClosure(nfaStates, documentModel.second);
+	for (unsigned int element = 0; element < declared.size(); element++) {
+		if (!declared[element]) {
+			contentStates.push_back(INVALID_STATE);
+			continue;
+		}
+		nfaStates.assign(1, contentModels[element].first);
+		contentStates.push_back(getClosure(nfaStates,
+				contentModels[element].second));
+	}
+}
+
+SchemaAutomaton::~SchemaAutomaton(void)
+{
+}
+
+unsigned int SchemaAutomaton::getElementIndex(const string & elementType)
+{
+	map<string, unsigned int>::iterator it = elementIndexes.find(elementType);
+	return it != elementIndexes.end() && declared[it->second]
+			? it->second : NO_ELEMENT;
+}
+
+unsigned int SchemaAutomaton::getNextState(unsigned int state,
+		unsigned int element)
+{
+	if (state == INVALID_STATE || element == NO_ELEMENT) {
+		return INVALID_STATE;
+	}
+
+	vector<unsigned int> & successors = stateTransitions[state];
+	if (successors.empty()) {
+		successors.resize(declared.size(), UNKNOWN_STATE);
+	} else if (successors[element] != UNKNOWN_STATE) {
+		return successors[element];
+	}
+
+	vector<unsigned int> nfaStates;
+	const vector<unsigned int> & subset = subsets[state];
+	for (unsigned int i = 0; i < subset.size(); i++) {
+		const vector<pair<unsigned int, unsigned int> > & outgoing =
+				transitions[subset[i]];
+		for (unsigned int j = 0; j < outgoing.size(); j++) {
+			if (outgoing[j].first == element || outgoing[j].first == ANY_ELEMENT) {
+				nfaStates.push_back(outgoing[j].second);
+			}
+		}
+	}
+
+	// getClosure() may add a state and thereby move the successors
+	unsigned int nextState = getClosure(nfaStates, finalNfaStates[state]);
+	stateTransitions[state][element] = nextState;
+	return nextState;
+}
+
+bool SchemaAutomaton::isFinalState(unsigned int state)
+{
+	return state != INVALID_STATE && binary_search(subsets[state].begin(),
+			subsets[state].end(), finalNfaStates[state]);
+}
+
+SchemaAutomaton::Fragment SchemaAutomaton::parseContentModel(
+		const string & declaration, string::size_type & position)
+{
+	skipWhiteSpace(declaration, position);
+
+	Fragment fragment(addNfaState(), addNfaState());
+	if (declaration.compare(position, 5, "EMPTY") == 0) {
+		position += 5;
+		emptyTransitions[fragment.first].push_back(fragment.second);
+	} else if (declaration.compare(position, 3, "ANY") == 0) {
+		position += 3;
+		transitions[fragment.first].push_back(
+				make_pair(ANY_ELEMENT, fragment.first));
+		emptyTransitions[fragment.first].push_back(fragment.second);
+	} else if (position < declaration.size() && declaration[position] == '(') {
+		fragment = parseParticle(declaration, position);
+	} else {
+		fail("Malformed content model", declaration);
+	}
+
+	return fragment;
+}
+
+SchemaAutomaton::Fragment SchemaAutomaton::parseParticle(
+		const string & declaration, string::size_type & position)
+{
+	skipWhiteSpace(declaration, position);
+
+	Fragment fragment;
+	if (position < declaration.size() && declaration[position] == '(') {
+		position++;
+
+		vector<Fragment> particles;
+		char separator = 0;
+		while (true) {
+			particles.push_back(parseParticle(declaration, position));
+			skipWhiteSpace(declaration, position);
+			if (position >= declaration.size()) {
+				fail("Malformed content model", declaration);
+			}
+
+			char c = declaration[position++];
+			if (c == ')') {
+				break;
+			} else if ((c != ',' && c != '|')
+					|| (separator != 0 && c != separator)) {
+				fail("Malformed content model", declaration);
+			}
+			separator = c;
+		}
+
+		if (separator == '|') {
+			fragment = Fragment(addNfaState(), addNfaState());
+			for (unsigned int i = 0; i < particles.size(); i++) {
+				emptyTransitions[fragment.first].push_back(particles[i].first);
+				emptyTransitions[particles[i].second].push_back(fragment.second);
+			}
+		} else {
+			fragment = particles.front();
+			for (unsigned int i = 1; i < particles.size(); i++) {
+				emptyTransitions[fragment.second].push_back(particles[i].first);
+				fragment.second = particles[i].second;
+			}
+		}
+	} else if (declaration.compare(position, 7, "#PCDATA") == 0) {
+		// character data is not part of the tree
+		position += 7;
+		fragment = Fragment(addNfaState(), addNfaState());
+		emptyTransitions[fragment.first].push_back(fragment.second);
+	} else {
+		string elementType = readName(declaration, position);
+		if (elementType.empty()) {
+			fail("Malformed content model", declaration);
+		}
+		unsigned int element = addElement(elementType);
+		fragment = Fragment(addNfaState(), addNfaState());
+		transitions[fragment.first].push_back(make_pair(element, fragment.second));
+	}
+
+	if (position < declaration.size() && (declaration[position] == '?'
+			|| declaration[position] == '*' || declaration[position] == '+')) {
+		char modifier = declaration[position++];
+		Fragment inner = fragment;
+		fragment = Fragment(addNfaState(), addNfaState());
+		emptyTransitions[fragment.first].push_back(inner.first);
+		emptyTransitions[inner.second].push_back(fragment.second);
+		if (modifier != '+') {
+			emptyTransitions[fragment.first].push_back(fragment.second);
+		}
+		if (modifier != '?') {
+			emptyTransitions[inner.second].push_back(inner.first);
+		}
+	}
+
+	return fragment;
+}
+
+unsigned int SchemaAutomaton::addElement(const string & elementType)
+{
+	map<string, unsigned int>::iterator it = elementIndexes.find(elementType);
+	if (it != elementIndexes.end()) {
+		return it->second;
+	}
+
+	unsigned int element = declared.size();
+	elementIndexes[elementType] = element;
+	declared.push_back(false);
+	contentModels.push_back(Fragment(0, 0));
+	return element;
+}
+
+unsigned int SchemaAutomaton::addNfaState()
+{
+	emptyTransitions.push_back(vector<unsigned int>());
+	transitions.push_back(vector<pair<unsigned int, unsigned int> >());
+	return emptyTransitions.size() - 1;
+}
+
+unsigned int SchemaAutomaton::getClosure(vector<unsigned int> & nfaStates,
+		unsigned int finalNfaState)
+{
+	vector<unsigned int> pending(nfaStates);
+	vector<unsigned int> closure;
+	reached.resize(emptyTransitions.size(), false);
+	nfaStates.clear();
+
+	while (!pending.empty()) {
+		unsigned int nfaState = pending.back();
+		pending.pop_back();
+		if (reached[nfaState]) {
+			continue;
+		}
+		reached[nfaState] = true;
+		closure.push_back(nfaState);
+		pending.insert(pending.end(), emptyTransitions[nfaState].begin(),
+				emptyTransitions[nfaState].end());
+
+		// only the states with labeled transitions and the final state
+		// distinguish the sets (e.g., the states of (a | b)* after
+		// reading a and after reading b are the same)
+		if (!transitions[nfaState].empty() || nfaState == finalNfaState) {
+			nfaStates.push_back(nfaState);
+		}
+	}
+	for (unsigned int i = 0; i < closure.size(); i++) {
+		reached[closure[i]] = false;
+	}
+	sort(nfaStates.begin(), nfaStates.end());
+	if (nfaStates.empty()) {
+		return INVALID_STATE;
+	}
+
+	map<vector<unsigned int>, unsigned int>::iterator it =
+			stateIndexes.find(nfaStates);
+	if (it != stateIndexes.end()) {
+		return it->second;
+	}
+
+	unsigned int state = subsets.size();
+	subsets.push_back(nfaStates);
+	finalNfaStates.push_back(finalNfaState);
+	stateTransitions.push_back(vector<unsigned int>());
+	stateIndexes[nfaStates] = state;
+	return state;
+}
+
+void SchemaAutomaton::fail(const string & message, const string & declaration)
+{
+	cout << "Fatal error: " << message << " in the DTD: " << declaration
+			<< " Exiting ..." << endl;
+	exit(1);
+}
@@ -0,0 +1,202 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * The deterministic automata of the content models of the element type
+ * declarations of a DTD, e.g.,
+ *
+ *   <!ELEMENT site (regions, people?, (item | category)*)>
+ *   <!ELEMENT item EMPTY>
+ *
+ * The content models may be EMPTY, ANY, mixed ((#PCDATA | a)*) or
+ * regular expressions over element types built from sequences (,),
+ * choices (|) and the modifiers ?, * and +. Character data and
+ * attributes are not part of the compressed trees, therefore #PCDATA
+ * matches the empty sequence and attribute list declarations are
+ * ignored. If the DTD contains a document type declaration, the root
+ * element must be of its type, otherwise of any type.
+ *
+ * The content models are read into a nondeterministic automaton which
+ * is determinized on demand. Together they form a deterministic
+ * top-down automaton on the first-child/next-sibling encoding of a
+ * document: the state at a node is the state of the content model of
+ * the parent element after reading the element types of the preceding
+ * siblings, the state at its first child is the initial state of the
+ * content model of its own element type.
+ */
+class SchemaAutomaton
+{
+public:
+	/**
+	 * The constructor reads the element type declarations of the
+	 * specified DTD.
+	 */
+	SchemaAutomaton(const char * pFilePath);
+	~SchemaAutomaton(void);
+
+	/**
+	 * The state reached after reading a sequence which is not the prefix
+	 * of a sequence matching the content model.
+	 */
+	static const unsigned int INVALID_STATE = 0;
+
+	/**
+	 * Indicates that an element type is not declared.
+	 */
+	static const unsigned int NO_ELEMENT = 0xFFFFFFFF;
+
+	/**
+	 * Returns the index of the specified element type or NO_ELEMENT if
+	 * it is not declared.
+	 */
+	unsigned int getElementIndex(const string & elementType);
+
+	/**
+	 * Returns the initial state of the content model of the document
+	 * (which consists of the root element).
+	 */
+	unsigned int getDocumentState() { return documentState; };
+
+	/**
+	 * Returns the initial state of the content model of the specified
+	 * element type (given by its index) or INVALID_STATE for NO_ELEMENT.
+	 */
+	unsigned int getContentState(unsigned int element) {
+		return element != NO_ELEMENT ? contentStates[element] : INVALID_STATE;
+	};
+
+	/**
+	 * Returns the state reached by reading an element of the specified
+	 * type (given by its index) in the specified state.
+	 */
+	unsigned int getNextState(unsigned int state, unsigned int element);
+
+	/**
+	 * Indicates whether the sequence read so far matches the content
+	 * model.
+	 */
+	bool isFinalState(unsigned int state);
+
+	/**
+	 * Returns the number of states created so far.
+	 */
+	unsigned int getNumberOfStates() { return subsets.size(); };
+
+private:
+	/**
+	 * The label of the transitions matching any element type.
+	 */
+	static const unsigned int ANY_ELEMENT = 0xFFFFFFFF;
+
+	/**
+	 * Marks the transitions which were not computed yet.
+	 */
+	static const unsigned int UNKNOWN_STATE = 0xFFFFFFFF;
+
+	/**
+	 * The initial and the final state of a part of the nondeterministic
+	 * automaton.
+	 */
+	typedef pair<unsigned int, unsigned int> Fragment;
+
+	/**
+	 * Parses the content model starting at the specified position of
+	 * the specified declaration and returns its automaton.
+	 */
+	Fragment parseContentModel(const string & declaration,
+			string::size_type & position);
+
+	/**
+	 * Parses a content particle (an element type or a parenthesized
+	 * sequence or choice followed by an optional modifier).
+	 */
+	Fragment parseParticle(const string & declaration,
+			string::size_type & position);
+
+	/**
+	 * Returns the index of the specified element type (which is added if
+	 * it has not been seen before).
+	 */
+	unsigned int addElement(const string & elementType);
+
+	unsigned int addNfaState();
+
+	/**
+	 * Returns the state of the deterministic automaton for the closure of
+	 * the specified nondeterministic states under empty transitions. The
+	 * states belong to the content model with the specified final state.
+	 */
+	unsigned int getClosure(vector<unsigned int> & nfaStates,
+			unsigned int finalNfaState);
+
+	/**
+	 * Exits with an error message referring to the specified declaration.
+	 */
+	void fail(const string & message, const string & declaration);
+
+	map<string, unsigned int> elementIndexes;
+	vector<bool> declared;
+
+	/**
+	 * By element type: the content model.
+	 */
+	vector<Fragment> contentModels;
+
+	/**
+	 * The transitions of the nondeterministic automaton by state: the
+	 * empty transitions and the transitions labeled by element types.
+	 */
+	vector<vector<unsigned int> > emptyTransitions;
+	vector<vector<pair<unsigned int, unsigned int> > > transitions;
+
+	/**
+	 * The states of the deterministic automaton (by index) as sorted sets
+	 * of nondeterministic states together with the final state of their
+	 * content model. Index 0 is INVALID_STATE (the empty set).
+	 */
+	vector<vector<unsigned int> > subsets;
+	vector<unsigned int> finalNfaStates;
+	map<vector<unsigned int>, unsigned int> stateIndexes;
+
+	/**
+	 * Marks the nondeterministic states reached while computing a
+	 * closure.
+	 */
+	vector<bool> reached;
+
+	/**
+	 * The initial states of the content models of the element types and
+	 * of the document.
+	 */
+	vector<unsigned int> contentStates;
+	unsigned int documentState;
+
+	/**
+	 * The transitions of the deterministic automaton by state and element
+	 * type (UNKNOWN_STATE if not computed yet).
+	 */
+	vector<vector<unsigned int> > stateTransitions;
+};
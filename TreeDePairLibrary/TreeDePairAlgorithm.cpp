@@ -24,18 +24,30 @@
 #include "TreeNode.h"
 #include "TreeRePairMode.h"
 #include "TreeRePairConstants.h"
-#include "SymbolReplacer.h"
 #include "TextualGrammarReader.h"
-#include "EdgeCounter.h"
-#include "XmlTreePrinter.h"
 #include "HuffmanSuccinctReader.h"
-#include "TreeDeleter.h"
+#include "GrammarNavigator.h"
+#include "GrammarXmlWriter.h"
 
 #include <fstream>
 #include <time.h>
 #include <cmath>
+#include <cstdio>
 #include <string>
 
+#if defined(__GNUC__)
+#include "AsyncOutputBuffer.h"
+#include "BoundedQueue.h"
+
+#include <pthread.h>
+
+struct TreeDePairAlgorithm::DecoderContext
+{
+	HuffmanSuccinctReader * pReader;
+	BoundedQueue<Symbol *> * pStartProduction;
+};
+#endif
+
 using namespace std;
 
 TreeDePairAlgorithm::TreeDePairAlgorithm(char * pFilePath)
@@ -58,17 +70,67 @@ TreeDePairAlgorithm::TreeDePairAlgorithm(char * pFilePath)
 	// nonterminal of the input file becomes id 1 (instead of 0)
 	Symbol::getStartSymbol();
 
-	if (TreeRePairMode::getInstance()->useTextualGrammar()) {
-		TextualGrammarReader reader(pFilePath, dagGrammar, mainGrammar);
-	}
-	else {
-		HuffmanSuccinctReader reader(pFilePath, dagGrammar, mainGrammar);
-	}
-
-	/* Production::print(cout, dagGrammar[0]);
-	for (unsigned int i = 0; i < mainGrammar.size(); i++) {
-		Production::print(cout, mainGrammar[i]);
-	}*/
+	string filename = Helper::getFilePathForUncompressed(pFilePath);
+	bool formatOutput = TreeRePairMode::getInstance()->isFormatOutput();
+	const char * pSelectedPath = TreeRePairMode::getInstance()->getSelectedPath();
+	bool writeSelection = pSelectedPath != 0
+			|| TreeRePairMode::getInstance()->isRangeSet();
+
+#if defined(__GNUC__)
+	// the parallel writer and the navigator need the whole start
+	// production in advance
+	if (!TreeRePairMode::getInstance()->useTextualGrammar() && !writeSelection
+			&& TreeRePairMode::getInstance()->getNumberOfThreads() == 1) {
+
+		HuffmanSuccinctReader reader(pFilePath, dagGrammar, mainGrammar,
+				false);
+		GrammarXmlWriter grammarXmlWriter(dagGrammar, mainGrammar);
+
+		BoundedQueue<Symbol *> startProduction(START_PRODUCTION_QUEUE_SIZE);
+		DecoderContext context = { &reader, &startProduction };
+		pthread_t decoder;
+		if (pthread_create(&decoder, 0, runDecoder, &context) != 0) {
+			cout << "Fatal error: Could not create thread. Exiting ..." << endl;
+			exit(1);
+		}
+
+		cout << "Writing file " << filename << " ..." << endl;
+
+		AsyncOutputBuffer outputBuffer(filename);
+		ostream fout(&outputBuffer);
+		grammarXmlWriter.writeXml(fout, startProduction, formatOutput);
+		outputBuffer.close();
+		pthread_join(decoder, 0);
+
+		// the decoding thread never exits the process itself
+		if (!reader.getStreamingError().empty()) {
+			remove(filename.c_str());
+			cout << reader.getStreamingError() << endl;
+			exit(1);
+		}
+
+		cout << "Number of edges: " << grammarXmlWriter.getNumberOfEdges() << endl;
+
+		timespec firstWriteTime;
+		if (outputBuffer.getFirstWriteTime(firstWriteTime)) {
+			timespec latency = Helper::diff(time1, firstWriteTime);
+			cout << "Time to first output byte: " << latency.tv_sec * 1000
+					+ latency.tv_nsec / 1000000 << " ms" << endl;
+		}
+	} else
+#endif
+	{
+		if (TreeRePairMode::getInstance()->useTextualGrammar()) {
+			TextualGrammarReader reader(pFilePath, dagGrammar, mainGrammar);
+		}
+		else {
+			HuffmanSuccinctReader reader(pFilePath, dagGrammar, mainGrammar);
+		}
+
+		/* Production::print(cout, dagGrammar[0]);
+		for (unsigned int i = 0; i < mainGrammar.size(); i++) {
+			Production::print(cout, mainGrammar[i]);
+		}*/
 
 //	unsigned int maxRank = 0;
 //	Symbol * pMaxRankSymbol = 0;
@@ -83,30 +145,46 @@ TreeDePairAlgorithm::TreeDePairAlgorithm(char * pFilePath)
 //
 //	cout << "Maximal rank is: " << maxRank << endl;
 
-	SymbolReplacer symbolReplacer(dagGrammar, mainGrammar);
-	SymbolReplacer::replaceNonterminals(symbolReplacer, mainGrammar);
-
-	/*filename = Helper::getFileNamePrefix(pFilePath) + "_debug.xml";
-	 ofstream fout2(filename.c_str());
-	 pXmlTreePrinter->printTree(pRoot, fout2, true);
-	 fout2.close();*/
-
-	cout << "Converting binary tree to unranked tree ..." << endl;
-
-	Production * pRootProduction = dagGrammar[0];
-//	TreeConverter treeConverter(pRootProduction->getRightHandSide());
-//
-//	TreeNode * pOldRightHandSide = pRootProduction->getRightHandSide();
-//	dagGrammar.updateRightHandSide(pRootProduction, treeConverter.getNewRoot());
-//
-//	TreeDeleter treeDeleter;
-//	treeDeleter.deleteTree(pOldRightHandSide);
-
-	Helper::writeUncompressedFile(pRootProduction->getRightHandSide(), (const char*)pFilePath);
-
-	EdgeCounter edgeCounter;
-	edgeCounter.countEdges(pRootProduction->getRightHandSide());
-	cout << "Number of edges: " << edgeCounter.getNumberOfEdges() << endl;
+		// the selection is checked before the output file is created
+		GrammarNavigator * pNavigator = 0;
+		unsigned long long start = TreeRePairMode::getInstance()->getRangeStart();
+		unsigned long long count = TreeRePairMode::getInstance()->getRangeCount();
+		if (writeSelection) {
+			pNavigator = new GrammarNavigator(dagGrammar, mainGrammar);
+			if (pSelectedPath != 0) {
+				GrammarNavigator::Position position;
+				if (!pNavigator->moveToPath(position, pSelectedPath)) {
+					cout << "The specified path does not select an element." << endl;
+					exit(1);
+				}
+				start = pNavigator->getPreorder(position);
+				count = pNavigator->getSubtreeSize(position);
+			} else if (start >= pNavigator->getNumberOfElements()) {
+				cout << "The document consists of only "
+						<< pNavigator->getNumberOfElements() << " elements." << endl;
+				exit(1);
+			}
+		}
+
+		// the productions are expanded while the unranked tree is written,
+		// val(G) is never built in memory
+		cout << "Writing file " << filename << " ..." << endl;
+
+		ofstream fout(filename.c_str());
+		GrammarXmlWriter grammarXmlWriter(dagGrammar, mainGrammar);
+		if (writeSelection) {
+			// only the selected elements are expanded
+			grammarXmlWriter.writeXml(fout, *pNavigator, start, count,
+					formatOutput);
+			delete pNavigator;
+		} else {
+			grammarXmlWriter.writeXml(fout, formatOutput,
+					TreeRePairMode::getInstance()->getNumberOfThreads());
+		}
+		fout.close();
+
+		cout << "Number of edges: " << grammarXmlWriter.getNumberOfEdges() << endl;
+	}
 
 #if !defined(__GNUC__)
 	clock_t finish = clock();
@@ -130,3 +208,12 @@ TreeDePairAlgorithm::~TreeDePairAlgorithm(void)
 	Helper::deleteSymbols();
 	TreeRePairMode::deleteInstance();
 }
+
+#if defined(__GNUC__)
+void * TreeDePairAlgorithm::runDecoder(void * pContextPar)
+{
+	DecoderContext & context = *((DecoderContext *) pContextPar);
+	context.pReader->streamStartProduction(*context.pStartProduction);
+	return 0;
+}
+#endif
@@ -22,14 +22,17 @@
 
 #include <stack>
 
-class SymbolReplacer;
-
 /**
  * This class implements the decompressor for the files generated by
  * the TreeRePair algorithm, i.e., it decompresses the succinct coding
  * to retrieve the contained linear SLCF tree grammar G and after that
  * it computes val(G) (i.e. the tree which is represented by G is
  * obtained).
+ *
+ * If possible, decompression is pipelined: after the productions were
+ * read, one thread decodes the start production and passes its nodes
+ * to the thread expanding them, whose output is written to the file by
+ * a third thread.
  */
 class TreeDePairAlgorithm
 {
@@ -42,4 +45,16 @@ public:
 	TreeDePairAlgorithm(char * pFilePath);
 
 	~TreeDePairAlgorithm(void);
+
+private:
+	/**
+	 * The reader and the queue used by the decoding thread (defined in
+	 * the implementation file).
+	 */
+	struct DecoderContext;
+
+	/**
+	 * The main function of the thread decoding the start production.
+	 */
+	static void * runDecoder(void * pContext);
 };
@@ -0,0 +1,394 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "XPathEvaluator.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+
+const unsigned long long XPathEvaluator::DEAD_STATE;
+
+/**
+ * The maximal number of steps of a location path (the state of the
+ * automaton must fit into 64 bits).
+ */
+static const unsigned int MAX_STEPS = 63;
+
+XPathEvaluator::XPathEvaluator(Grammar & dagGrammar, Grammar & mainGrammar) :
+	index(dagGrammar, mainGrammar), descendantSteps(0), finalState(0),
+	countQuery(false), currentOffset(0), currentParameters(0)
+{
+	unsigned int size = index.size();
+	ranks.resize(size, 0);
+	segmentBegins.resize(size, 0);
+
+	staticSizes.resize(TreeNode::idCounter, 0);
+	firstParameters.resize(TreeNode::idCounter, 0);
+	parameterCounts.resize(TreeNode::idCounter, 0);
+	occurringTerminals.resize(Symbol::counter, false);
+
+	// the referenced productions are traversed first
+	const vector<unsigned int> & order = index.getOrder();
+	for (unsigned int i = order.size(); i > 0; i--) {
+		unsigned int production = order[i - 1];
+		currentOffset = 0;
+		currentParameters = 0;
+		parameterOffsets.clear();
+
+		traverseTree(index.getRightHandSide(production));
+
+		ranks[production] = currentParameters;
+		segmentBegins[production] = segmentLengths.size();
+		unsigned long long previous = 0;
+		for (unsigned int j = 0; j < currentParameters; j++) {
+			segmentLengths.push_back(parameterOffsets[j] - previous);
+			previous = parameterOffsets[j];
+		}
+		segmentLengths.push_back(currentOffset - previous);
+	}
+}
+
+XPathEvaluator::~XPathEvaluator(void)
+{
+}
+
+void XPathEvaluator::preVisit(TreeNode * pNode, unsigned int childIndex,
+		int depth)
+{
+	// the offset and the parameter counter are replaced when leaving the
+	// node
+	unsigned int id = pNode->getId();
+	staticSizes[id] = currentOffset;
+	firstParameters[id] = currentParameters;
+
+	Symbol * pSymbol = pNode->getSymbol();
+	unsigned int referenced = index.getProduction(pSymbol);
+	if (pSymbol == Symbol::getParameterSymbol()) {
+		parameterOffsets.push_back(currentOffset);
+		currentParameters++;
+	} else if (referenced != GrammarIndex::NO_PRODUCTION) {
+		if (ranks[referenced] != pNode->getCurrentChildrenCount()) {
+			cout << "Fatal error: The rank of a nonterminal does not "
+				"match the number of parameters of its production. "
+				"Exiting ..." << endl;
+			exit(1);
+		}
+		currentOffset += segmentLengths[segmentBegins[referenced]];
+	} else {
+		currentOffset++;
+		occurringTerminals[pSymbol->getId()] = true;
+	}
+}
+
+void XPathEvaluator::visitEdge(TreeNode * pParent, unsigned int childIndex,
+		TreeNode * pChild)
+{
+	// the segment between the previous argument and this one
+	unsigned int referenced = index.getProduction(pParent->getSymbol());
+	if (childIndex > 0 && referenced != GrammarIndex::NO_PRODUCTION) {
+		currentOffset += segmentLengths[segmentBegins[referenced] + childIndex];
+	}
+}
+
+void XPathEvaluator::postVisit(TreeNode * pNode, unsigned int childIndex,
+		int depth)
+{
+	// the segment after the last argument
+	unsigned int children = pNode->getCurrentChildrenCount();
+	unsigned int referenced = index.getProduction(pNode->getSymbol());
+	if (children > 0 && referenced != GrammarIndex::NO_PRODUCTION) {
+		currentOffset += segmentLengths[segmentBegins[referenced] + children];
+	}
+
+	unsigned int id = pNode->getId();
+	staticSizes[id] = currentOffset - staticSizes[id];
+	parameterCounts[id] = currentParameters - firstParameters[id];
+}
+
+bool XPathEvaluator::setQuery(const string & query)
+{
+	string path = query;
+	countQuery = path.size() > 7 && path.compare(0, 6, "count(") == 0
+			&& path[path.size() - 1] == ')';
+	if (countQuery) {
+		path = path.substr(6, path.size() - 7);
+	}
+
+	// the steps: bit i of the states stands for the first i steps
+	vector<string> nodeTests;
+	unsigned long long descendants = 0;
+	string::size_type position = 0;
+	while (position < path.size()) {
+		if (path[position] != '/') {
+			return false;
+		}
+		position++;
+		if (position < path.size() && path[position] == '/') {
+			descendants |= 1ULL << nodeTests.size();
+			position++;
+		}
+
+		string::size_type end = path.find('/', position);
+		if (end == string::npos) {
+			end = path.size();
+		}
+		string nodeTest = path.substr(position, end - position);
+		if (nodeTest.empty()
+				|| nodeTest.find_first_of("[]()@:= \t") != string::npos
+				|| nodeTests.size() == MAX_STEPS) {
+			return false;
+		}
+		nodeTests.push_back(nodeTest);
+		position = end;
+	}
+	if (nodeTests.empty()) {
+		return false;
+	}
+
+	descendantSteps = descendants;
+	finalState = 1ULL << nodeTests.size();
+
+	// the node tests are applied to the element types of the terminal
+	// symbols occurring in the grammar
+	matchingSteps.assign(Symbol::counter, 0);
+	for (unsigned int id = 0; id < occurringTerminals.size(); id++) {
+		if (!occurringTerminals[id]) {
+			continue;
+		}
+
+		string elementType = Symbol::getElementTypeById(id);
+		for (unsigned int i = 0; i < nodeTests.size(); i++) {
+			if (nodeTests[i] == "*" || nodeTests[i] == elementType) {
+				matchingSteps[id] |= 1ULL << (i + 1);
+			}
+		}
+	}
+
+	summaryIndexes.assign(index.size(), map<unsigned long long, unsigned int>());
+	numbersOfMatches.clear();
+	parameterStateBegins.clear();
+	parameterStates.clear();
+
+	return true;
+}
+
+unsigned int XPathEvaluator::getSummary(unsigned int production,
+		unsigned long long state)
+{
+	map<unsigned long long, unsigned int>::iterator it =
+			summaryIndexes[production].find(state);
+	if (it != summaryIndexes[production].end()) {
+		return it->second;
+	}
+
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+
+	// the summaries of the referenced productions are computed on demand,
+	// the computation of the referencing one is resumed afterwards
+	vector<PendingSummary> summaries(1);
+	summaries.back().production = production;
+	summaries.back().state = state;
+	summaries.back().numberOfMatches = 0;
+	summaries.back().parameterStates.assign(ranks[production], DEAD_STATE);
+	PendingNode root = { index.getRightHandSide(production), state, 0 };
+	summaries.back().nodes.push_back(root);
+
+	while (!summaries.empty()) {
+		PendingSummary & summary = summaries.back();
+
+		if (summary.nodes.empty()) {
+			summaryIndexes[summary.production][summary.state] =
+					numbersOfMatches.size();
+			numbersOfMatches.push_back(summary.numberOfMatches);
+			parameterStateBegins.push_back(parameterStates.size());
+			parameterStates.insert(parameterStates.end(),
+					summary.parameterStates.begin(),
+					summary.parameterStates.end());
+			summaries.pop_back();
+			continue;
+		}
+
+		PendingNode node = summary.nodes.back();
+		TreeNode * pNode = node.pNode;
+		Symbol * pSymbol = pNode->getSymbol();
+
+		if (pSymbol == pParameterSymbol) {
+			summary.nodes.pop_back();
+			summary.parameterStates[firstParameters[pNode->getId()]] = node.state;
+			continue;
+		}
+
+		unsigned int referenced = index.getProduction(pSymbol);
+		if (referenced != GrammarIndex::NO_PRODUCTION) {
+			it = summaryIndexes[referenced].find(node.state);
+			if (it == summaryIndexes[referenced].end()) {
+				PendingSummary referencedSummary;
+				referencedSummary.production = referenced;
+				referencedSummary.state = node.state;
+				referencedSummary.numberOfMatches = 0;
+				referencedSummary.parameterStates.assign(ranks[referenced],
+						DEAD_STATE);
+				PendingNode referencedRoot = {
+						index.getRightHandSide(referenced), node.state, 0 };
+				referencedSummary.nodes.push_back(referencedRoot);
+				// invalidates the reference to the current summary
+				summaries.push_back(referencedSummary);
+				continue;
+			}
+
+			summary.nodes.pop_back();
+			summary.numberOfMatches += numbersOfMatches[it->second];
+			unsigned int begin = parameterStateBegins[it->second];
+			for (unsigned int j = 0; j < ranks[referenced]; j++) {
+				if (parameterStates[begin + j] != DEAD_STATE) {
+					PendingNode argument = { pNode->getChild(j),
+							parameterStates[begin + j], 0 };
+					summary.nodes.push_back(argument);
+				}
+			}
+			continue;
+		}
+
+		// a terminal node: the left child is the first child and the
+		// right child is the next sibling in the unranked tree
+		summary.nodes.pop_back();
+		unsigned long long nextState = getNextState(node.state, pSymbol);
+		if (isSelected(nextState)) {
+			summary.numberOfMatches++;
+		}
+
+		unsigned int children = pNode->getCurrentChildrenCount();
+		if (pSymbol->hasRightChild()) {
+			PendingNode sibling = { pNode->getChild(children - 1), node.state, 0 };
+			summary.nodes.push_back(sibling);
+		}
+		if (pSymbol->hasLeftChild() && nextState != DEAD_STATE) {
+			PendingNode child = { pNode->getChild(0), nextState, 0 };
+			summary.nodes.push_back(child);
+		}
+	}
+
+	return summaryIndexes[production][state];
+}
+
+unsigned long long XPathEvaluator::getNumberOfMatches()
+{
+	// the document node is the parent of the root element
+	return numbersOfMatches[getSummary(index.getStartProduction(), 1)];
+}
+
+void XPathEvaluator::getMatches(vector<unsigned long long> & preorders)
+{
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+	preorders.clear();
+
+	// an application is only expanded if its own part of the expanded
+	// tree contains a selected element; the arguments are visited in the
+	// application referencing it
+	vector<PendingApplication> applications(1);
+	applications.back().production = index.getStartProduction();
+	applications.back().state = 1;
+	applications.back().preorder = 0;
+	applications.back().argumentSums.push_back(0);
+
+	vector<PendingNode> nodes;
+	vector<unsigned long long> argumentSums;
+
+	while (!applications.empty()) {
+		PendingApplication application;
+		application.argumentSums.swap(applications.back().argumentSums);
+		application.production = applications.back().production;
+		application.state = applications.back().state;
+		application.preorder = applications.back().preorder;
+		applications.pop_back();
+
+		PendingNode root = { index.getRightHandSide(application.production),
+				application.state, application.preorder };
+		nodes.push_back(root);
+
+		while (!nodes.empty()) {
+			PendingNode node = nodes.back();
+			nodes.pop_back();
+
+			TreeNode * pNode = node.pNode;
+			Symbol * pSymbol = pNode->getSymbol();
+			if (pSymbol == pParameterSymbol) {
+				continue;
+			}
+
+			unsigned int referenced = index.getProduction(pSymbol);
+			if (referenced != GrammarIndex::NO_PRODUCTION) {
+				unsigned int summary = getSummary(referenced, node.state);
+
+				argumentSums.assign(1, 0);
+				for (unsigned int j = 0; j < ranks[referenced]; j++) {
+					argumentSums.push_back(argumentSums.back()
+							+ getSize(pNode->getChild(j), application.argumentSums));
+				}
+
+				// the arguments are placed between the segments
+				unsigned long long preorder = node.preorder;
+				unsigned int begin = parameterStateBegins[summary];
+				for (unsigned int j = 0; j < ranks[referenced]; j++) {
+					preorder += segmentLengths[segmentBegins[referenced] + j];
+					if (parameterStates[begin + j] != DEAD_STATE) {
+						PendingNode argument = { pNode->getChild(j),
+								parameterStates[begin + j], preorder };
+						nodes.push_back(argument);
+					}
+					preorder += argumentSums[j + 1] - argumentSums[j];
+				}
+
+				if (numbersOfMatches[summary] > 0) {
+					applications.push_back(PendingApplication());
+					applications.back().production = referenced;
+					applications.back().state = node.state;
+					applications.back().preorder = node.preorder;
+					applications.back().argumentSums.swap(argumentSums);
+				}
+				continue;
+			}
+
+			unsigned long long nextState = getNextState(node.state, pSymbol);
+			if (isSelected(nextState)) {
+				preorders.push_back(node.preorder);
+			}
+
+			unsigned int children = pNode->getCurrentChildrenCount();
+			unsigned long long siblingPreorder = node.preorder + 1;
+			if (pSymbol->hasLeftChild()) {
+				TreeNode * pChild = pNode->getChild(0);
+				if (nextState != DEAD_STATE) {
+					PendingNode child = { pChild, nextState, node.preorder + 1 };
+					nodes.push_back(child);
+				}
+				if (pSymbol->hasRightChild()) {
+					siblingPreorder += getSize(pChild, application.argumentSums);
+				}
+			}
+			if (pSymbol->hasRightChild()) {
+				PendingNode sibling = { pNode->getChild(children - 1),
+						node.state, siblingPreorder };
+				nodes.push_back(sibling);
+			}
+		}
+	}
+
+	sort(preorders.begin(), preorders.end());
+}
@@ -0,0 +1,247 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "Grammar.h"
+#include "GrammarIndex.h"
+#include "StaticTreeTraversal.h"
+#include "Symbol.h"
+#include "TreeNode.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Evaluates XPath queries on the XML document represented by a linear
+ * SLCF tree grammar without decompressing it. Supported are absolute
+ * location paths consisting of steps along the child (/) and the
+ * descendant (//) axis whose node tests are element types or *, e.g.,
+ * "/site//item/name", optionally enclosed in count().
+ *
+ * A location path of k steps is run as a deterministic automaton over
+ * the element types on the path from the root to an element. Its state
+ * is a set of at most k + 1 bits: bit i is set if the first i steps
+ * may be continued by the next step below the current element. The
+ * element is selected if bit k is set after reading its type.
+ *
+ * For every production and state of the automaton at the root of its
+ * right-hand side, the number of selected elements of the expanded
+ * right-hand side (not counting the arguments) and the states at its
+ * parameters are computed at most once. These summaries are combined to
+ * count the selected elements, so the running time depends on the size
+ * of the grammar and on the number of states reached, but not on the
+ * size of the document. The selected elements are enumerated by
+ * expanding only the applications of productions containing some of
+ * them.
+ */
+class XPathEvaluator : public StaticTreeTraversal<XPathEvaluator>
+{
+	friend class StaticTreeTraversal<XPathEvaluator>;
+
+public:
+	/**
+	 * The constructor precomputes the sizes of the right-hand sides.
+	 * @param dagGrammar the grammar containing the start production
+	 * @param mainGrammar the grammar containing the remaining productions
+	 */
+	XPathEvaluator(Grammar & dagGrammar, Grammar & mainGrammar);
+	~XPathEvaluator(void);
+
+	/**
+	 * Sets the query to evaluate. Returns false if the query is not
+	 * supported (see above).
+	 */
+	bool setQuery(const string & query);
+
+	/**
+	 * Indicates whether the query is enclosed in count().
+	 */
+	bool isCountQuery() { return countQuery; };
+
+	/**
+	 * Returns the number of elements selected by the location path of
+	 * the query.
+	 */
+	unsigned long long getNumberOfMatches();
+
+	/**
+	 * Returns the preorder numbers (the root element has number 0) of
+	 * the elements selected by the location path of the query in
+	 * ascending order.
+	 */
+	void getMatches(vector<unsigned long long> & preorders);
+
+protected:
+	/**
+	 * The hooks of the traversal of a right-hand side by the
+	 * constructor: a nonterminal node stands for the segments of the
+	 * referenced production which alternate with its arguments.
+	 */
+	void preVisit(TreeNode * pNode, unsigned int childIndex, int depth);
+	void postVisit(TreeNode * pNode, unsigned int childIndex, int depth);
+	void visitEdge(TreeNode * pParent, unsigned int childIndex,
+			TreeNode * pChild);
+
+private:
+	/**
+	 * A node of a right-hand side which is still to visit together with
+	 * the state of the automaton at its parent element and the preorder
+	 * number of the first element it generates (the latter is only used
+	 * by getMatches()).
+	 */
+	struct PendingNode
+	{
+		TreeNode * pNode;
+		unsigned long long state;
+		unsigned long long preorder;
+	};
+
+	/**
+	 * The computation of a summary which is still in progress.
+	 */
+	struct PendingSummary
+	{
+		unsigned int production;
+		unsigned long long state;
+		vector<PendingNode> nodes;
+		unsigned long long numberOfMatches;
+		vector<unsigned long long> parameterStates;
+	};
+
+	/**
+	 * An application of a production whose selected elements are still
+	 * to enumerate. The prefix sums of the numbers of elements generated
+	 * by the arguments are needed to number the elements.
+	 */
+	struct PendingApplication
+	{
+		unsigned int production;
+		unsigned long long state;
+		unsigned long long preorder;
+		vector<unsigned long long> argumentSums;
+	};
+
+	/**
+	 * The state of the automaton in which no element can be selected
+	 * anymore.
+	 */
+	static const unsigned long long DEAD_STATE = 0;
+
+	/**
+	 * Returns the state of the automaton at an element of the specified
+	 * type (given by the terminal symbol) whose parent is reached in the
+	 * specified state.
+	 */
+	unsigned long long getNextState(unsigned long long state, Symbol * pSymbol) {
+		return (state & descendantSteps)
+				| ((state << 1) & matchingSteps[pSymbol->getId()]);
+	};
+
+	bool isSelected(unsigned long long state) {
+		return (state & finalState) != 0;
+	};
+
+	/**
+	 * Returns the index of the summary of the specified production for
+	 * the specified state at the root of its right-hand side (the summary
+	 * is computed if necessary).
+	 */
+	unsigned int getSummary(unsigned int production, unsigned long long state);
+
+	/**
+	 * Returns the number of elements of the expanded subtree of the
+	 * specified node given the prefix sums of the numbers of elements
+	 * generated by the arguments of the production.
+	 */
+	unsigned long long getSize(TreeNode * pNode,
+			const vector<unsigned long long> & argumentSums) {
+		unsigned int id = pNode->getId();
+		return staticSizes[id]
+				+ argumentSums[firstParameters[id] + parameterCounts[id]]
+				- argumentSums[firstParameters[id]];
+	};
+
+	GrammarIndex index;
+
+	/**
+	 * By production: the number of parameters and the index of the first
+	 * of its segment lengths.
+	 */
+	vector<unsigned int> ranks;
+	vector<unsigned int> segmentBegins;
+
+	/**
+	 * The numbers of elements of the segments of the expanded right-hand
+	 * sides before, between and after the parameters (a production of
+	 * rank r has r + 1 segments).
+	 */
+	vector<unsigned long long> segmentLengths;
+
+	/**
+	 * By node id: the number of elements of the expanded subtree (not
+	 * counting the arguments of parameters), the index of the first
+	 * parameter below the node (or of the parameter itself) and the
+	 * number of these parameters.
+	 */
+	vector<unsigned long long> staticSizes;
+	vector<unsigned int> firstParameters;
+	vector<unsigned int> parameterCounts;
+
+	/**
+	 * By symbol id: whether the symbol is a terminal symbol occurring in
+	 * the grammar.
+	 */
+	vector<bool> occurringTerminals;
+
+	/**
+	 * The automaton of the current query: the bits of the steps along
+	 * the descendant axis, the final bit and, by symbol id, the bits of
+	 * the steps whose node test the element type matches.
+	 */
+	unsigned long long descendantSteps;
+	unsigned long long finalState;
+	vector<unsigned long long> matchingSteps;
+
+	bool countQuery;
+
+	/**
+	 * By production: the indexes of the summaries by state.
+	 */
+	vector<map<unsigned long long, unsigned int> > summaryIndexes;
+
+	/**
+	 * By summary: the number of selected elements and the index of the
+	 * first state at the parameters in parameterStates.
+	 */
+	vector<unsigned long long> numbersOfMatches;
+	vector<unsigned int> parameterStateBegins;
+	vector<unsigned long long> parameterStates;
+
+	/**
+	 * The state of the constructor while traversing a right-hand side:
+	 * the number of elements and of parameters visited and the numbers of
+	 * elements preceding the parameters.
+	 */
+	unsigned long long currentOffset;
+	unsigned int currentParameters;
+	vector<unsigned long long> parameterOffsets;
+};
@@ -0,0 +1,286 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "BinaryTreeConstructor.h"
+#include "GrammarEditor.h"
+#include "HuffmanSuccinctReader.h"
+#include "HuffmanSuccinctWriter.h"
+#include "TextualGrammarReader.h"
+#include "XMLTreeParser.h"
+
+#include "TreeRePairVersion.h"
+#include "TreeRePairMode.h"
+#include "Profiler.h"
+#include "Helper.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * An edit specified on the command line: the switch character, the
+ * preorder number of the element and the element type or the XML file
+ * to insert.
+ */
+struct Edit {
+	char operation;
+	unsigned long long preorder;
+	char * pArgument;
+};
+
+/**
+ * parses the specified XML file and returns the root of its binary
+ * representation; the nodes are not shared
+ */
+static TreeNode * readSubtree(char * pFilePath) {
+	Grammar grammar;
+
+	TreeRePairMode::getInstance()->setUseDag(false);
+	{
+		XMLTreeParser xmlParser(pFilePath, grammar);
+	}
+
+	Production * pProduction = grammar[0];
+	TreeNode * pRoot = pProduction->getRightHandSide();
+	grammar.updateRightHandSide(pProduction, 0);
+	grammar.removeProduction(pProduction);
+	delete pProduction;
+
+	// the parser assumes that the root element has children
+	if (pRoot->getChild(0) == 0) {
+		TreeNode * pLeaf = new TreeNode(BinaryTreeConstructor::retrieveSymbol(
+				Symbol::getElementTypeById(pRoot->getSymbol()->getId()),
+				false, false));
+		delete pRoot;
+		pRoot = pLeaf;
+	}
+
+	return pRoot;
+}
+
+static void printHelp() {
+	string blank = "  ";
+
+	cout << endl;
+	cout << "TreeRePair is an implementation of the Re-pair for Trees algorithm." << endl;
+	cout << "This tool edits trees which were compressed by TreeRePair without" << endl;
+	cout << "decompressing them." << endl;
+	cout << endl;
+	cout << "Copyright (c) 2010 Roy Mennicke, Build date: " << VERSION << endl;
+	cout << endl;
+	cout << "This is free software.  You may redistribute copies of it under the terms of" << endl;
+	cout << "the GNU General Public License Version 3 which is available at the webpage" << endl;
+	cout << "<http://www.gnu.org/licenses/gpl-3.0.txt>. There is NO WARRANTY." << endl;
+	cout << endl;
+	cout << "Usage: TreeEdit [-delete PREORDER] [-insert PREORDER XML_FILE]" << endl;
+	cout << "                [-sibling PREORDER XML_FILE] [-rename PREORDER ELEMENT_TYPE]" << endl;
+	cout << "                [-output OUTPUT_FILE] input_file" << endl;
+	cout << "Parameters:" << endl;
+	cout << blank << "input_file" << endl;
+	cout << blank << blank << "input_file must be a valid TreeRePair result file (with extension" << endl;
+	cout << blank << blank << "\"rep\")." << endl;
+	cout << blank << "-delete PREORDER" << endl;
+	cout << blank << blank << "Deletes the subtree rooted at the element with the specified preorder" << endl;
+	cout << blank << blank << "number (the root element has number 0)." << endl;
+	cout << blank << "-insert PREORDER XML_FILE" << endl;
+	cout << blank << blank << "Inserts the document of the specified XML file as the first child of" << endl;
+	cout << blank << blank << "the element with the specified preorder number." << endl;
+	cout << blank << "-sibling PREORDER XML_FILE" << endl;
+	cout << blank << blank << "Inserts the document of the specified XML file as the next sibling of" << endl;
+	cout << blank << blank << "the element with the specified preorder number." << endl;
+	cout << blank << "-rename PREORDER ELEMENT_TYPE" << endl;
+	cout << blank << blank << "Changes the type of the element with the specified preorder number." << endl;
+	cout << blank << "-output OUTPUT_FILE" << endl;
+	cout << blank << blank << "The file to write the edited tree to (the extension \".rep\" is appended" << endl;
+	cout << blank << blank << "if missing, by default the input file is overwritten)." << endl;
+	cout << endl;
+	cout << "The edits may be specified several times and are applied in the given" << endl;
+	cout << "order, i.e., the preorder numbers refer to the tree edited so far." << endl;
+}
+
+int main (int argc, char* args[]) {
+
+	if (argc == 1) {
+		cout << "Please specify a valid input file, i.e., a file generated by " << endl;
+		cout << "a run of TreeRePair (with file extension .rep)." << endl;
+		printHelp();
+		exit(1);
+	}
+
+	char * pFilePath = 0;
+	char * pOutputFilePath = 0;
+	vector<Edit> edits;
+
+	for (int i = 1; i < argc; i++) {
+		char * arg = args[i];
+		if (arg[0] == '-') {
+			Edit edit;
+			edit.operation = arg[1];
+			edit.pArgument = 0;
+
+			switch(arg[1]) {
+				case 'd': // -delete PREORDER
+					if (i + 1 >= argc) {
+						cout << "Please specify the preorder number of an element." << endl;
+						exit(1);
+					}
+					edit.preorder = strtoull(args[i + 1], 0, 10);
+					edits.push_back(edit);
+					i++;
+					break;
+				case 'i': // -insert PREORDER XML_FILE
+				case 's': // -sibling PREORDER XML_FILE
+				case 'r': // -rename PREORDER ELEMENT_TYPE
+					if (i + 2 >= argc) {
+						cout << "Please specify the preorder number of an element and "
+								<< (arg[1] == 'r' ? "an element type." : "an XML file.")
+								<< endl;
+						exit(1);
+					}
+					edit.preorder = strtoull(args[i + 1], 0, 10);
+					edit.pArgument = args[i + 2];
+					if (arg[1] != 'r' && !Helper::fileExists(edit.pArgument)) {
+						cout << "The specified XML file " << edit.pArgument
+								<< " does not exist." << endl;
+						exit(1);
+					}
+					edits.push_back(edit);
+					i += 2;
+					break;
+				case 'o': // -output OUTPUT_FILE
+					if (i + 1 >= argc) {
+						cout << "Please specify an output file." << endl;
+						exit(1);
+					}
+					pOutputFilePath = args[i + 1];
+					i++;
+					break;
+				case 't': // -textual
+					TreeRePairMode::getInstance()->setUseTextualGrammar(true);
+					break;
+				case '\0':
+					cout << "Unknown switch." << endl;
+				default:
+					cout << "Unknown switch: " << arg << endl;
+
+					printHelp();
+					exit(0);
+					break;
+			}
+		} else {
+			pFilePath = arg;
+		}
+	}
+
+	if (pFilePath == 0) {
+		cout << "Please specify a valid input file, i.e., a file generated by " << endl;
+		cout << "a run of TreeRePair (with file extension .rep)." << endl;
+		exit(1);
+	} else if (!Helper::fileExists(pFilePath)) {
+		cout << "The specified input file does not exist." << endl;
+		exit(1);
+	}
+
+	if (edits.empty()) {
+		cout << "Please specify at least one edit." << endl;
+		printHelp();
+		exit(1);
+	}
+
+	if (pOutputFilePath == 0) {
+		pOutputFilePath = pFilePath;
+	}
+
+	// the writer replaces the extension of the name of an XML file by
+	// the extension ".rep" (like for the input files of TreeRePair)
+	string outputFilePath(pOutputFilePath);
+	string extension = ".rep";
+	if (outputFilePath.size() > extension.size()
+			&& outputFilePath.substr(outputFilePath.size()
+					- extension.size()) == extension) {
+		outputFilePath.erase(outputFilePath.size() - extension.size());
+	}
+	outputFilePath += ".xml";
+
+	// the re-pairing of the start production needs the digram
+	// occurrence lists of the nodes
+	TreeRePairMode::getInstance()->setAlgMode(TreeRePairMode::COMPRESS);
+
+	{
+		Grammar dagGrammar;
+		Grammar mainGrammar;
+
+		// we instantiate the start symbol so that the first
+		// nonterminal of the input file becomes id 1 (instead of 0)
+		Symbol::getStartSymbol();
+
+		if (TreeRePairMode::getInstance()->useTextualGrammar()) {
+			TextualGrammarReader reader(pFilePath, dagGrammar, mainGrammar);
+		} else {
+			HuffmanSuccinctReader reader(pFilePath, dagGrammar, mainGrammar);
+		}
+
+		GrammarEditor editor(dagGrammar, mainGrammar);
+
+		for (unsigned int i = 0; i < edits.size(); i++) {
+			const Edit & edit = edits[i];
+			bool applied;
+
+			switch (edit.operation) {
+				case 'd':
+					applied = editor.deleteSubtree(edit.preorder);
+					break;
+				case 'r':
+					applied = editor.renameElement(edit.preorder, edit.pArgument);
+					break;
+				default:
+					applied = editor.insertSubtree(edit.preorder,
+							readSubtree(edit.pArgument), edit.operation == 'i');
+					break;
+			}
+
+			if (!applied) {
+				cout << "Edit " << (i + 1) << " could not be applied: there is no "
+						"suitable element with preorder number " << edit.preorder
+						<< " (the tree has " << editor.getNumberOfElements()
+						<< " elements)." << endl;
+				exit(1);
+			}
+		}
+
+		editor.recompress();
+
+		{
+			HuffmanSuccinctWriter succinctWriter(dagGrammar, mainGrammar,
+					&outputFilePath[0]);
+		}
+
+		cout << "Applied " << edits.size() << " edit(s), the tree has "
+				<< editor.getNumberOfElements() << " elements (recompressed "
+				<< editor.getNumberOfRecompressions() << " time(s))." << endl;
+	}
+
+	Helper::deleteSymbols();
+	Profiler::deleteInstance();
+	TreeRePairMode::deleteInstance();
+
+	return 0;
+}
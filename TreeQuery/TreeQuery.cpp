@@ -0,0 +1,303 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "GrammarNavigator.h"
+#include "GrammarSummary.h"
+#include "GrammarValidator.h"
+#include "HuffmanSuccinctReader.h"
+#include "SchemaAutomaton.h"
+#include "TextualGrammarReader.h"
+#include "XPathEvaluator.h"
+
+#include "TreeRePairVersion.h"
+#include "TreeRePairMode.h"
+#include "Helper.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * prints the type, the neighbours and the subtree size of the element
+ * with the specified preorder number
+ */
+static void printElement(GrammarNavigator & navigator,
+		unsigned long long preorder) {
+	GrammarNavigator::Position position, neighbour;
+
+	cout << "Element " << preorder << ":" << endl;
+	if (!navigator.moveToPreorder(position, preorder)) {
+		cout << "  does not exist" << endl;
+		return;
+	}
+
+	cout << "  Element type: " << navigator.getElementType(position) << endl;
+	cout << "  Subtree size: " << navigator.getSubtreeSize(position) << endl;
+
+	neighbour = position;
+	cout << "  Parent: ";
+	if (navigator.moveToParent(neighbour)) {
+		cout << navigator.getPreorder(neighbour) << endl;
+	} else {
+		cout << "none" << endl;
+	}
+
+	neighbour = position;
+	cout << "  First child: ";
+	if (navigator.moveToFirstChild(neighbour)) {
+		cout << navigator.getPreorder(neighbour) << endl;
+	} else {
+		cout << "none" << endl;
+	}
+
+	neighbour = position;
+	cout << "  Next sibling: ";
+	if (navigator.moveToNextSibling(neighbour)) {
+		cout << navigator.getPreorder(neighbour) << endl;
+	} else {
+		cout << "none" << endl;
+	}
+}
+
+/**
+ * prints the help screen to the standard output
+ */
+static void printHelp() {
+	string blank = "  ";
+
+	cout << endl;
+	cout << "TreeRePair is an implementation of the Re-pair for Trees algorithm." << endl;
+	cout << "This tool answers aggregate queries about trees which were compressed by" << endl;
+	cout << "TreeRePair without decompressing them." << endl;
+	cout << endl;
+	cout << "Copyright (c) 2010 Roy Mennicke, Build date: " << VERSION << endl;
+	cout << endl;
+	cout << "This is free software.  You may redistribute copies of it under the terms of" << endl;
+	cout << "the GNU General Public License Version 3 which is available at the webpage" << endl;
+	cout << "<http://www.gnu.org/licenses/gpl-3.0.txt>. There is NO WARRANTY." << endl;
+	cout << endl;
+	cout << "Usage: TreeQuery [-count ELEMENT_TYPE] [-depth] [-element PREORDER] [-histogram]" << endl;
+	cout << "                 [-nodes] [-validate DTD] [-xpath QUERY] input_file" << endl;
+	cout << "Parameters:" << endl;
+	cout << blank << "input_file" << endl;
+	cout << blank << blank << "input_file must be a valid TreeRePair result file (with extension" << endl;
+	cout << blank << blank << "\"rep\")." << endl;
+	cout << blank << "-count ELEMENT_TYPE" << endl;
+	cout << blank << blank << "Prints the number of elements of the specified type (may be" << endl;
+	cout << blank << blank << "specified several times)." << endl;
+	cout << blank << "-depth" << endl;
+	cout << blank << blank << "Prints the maximal depth of an element (the root element has" << endl;
+	cout << blank << blank << "depth 1)." << endl;
+	cout << blank << "-element PREORDER" << endl;
+	cout << blank << blank << "Prints the element type, the subtree size, the parent, the first child" << endl;
+	cout << blank << blank << "and the next sibling of the element with the specified preorder number" << endl;
+	cout << blank << blank << "(the root element has number 0, may be specified several times)." << endl;
+	cout << blank << "-histogram" << endl;
+	cout << blank << blank << "Prints the number of elements of every element type." << endl;
+	cout << blank << "-nodes" << endl;
+	cout << blank << blank << "Prints the number of elements." << endl;
+	cout << blank << "-validate DTD" << endl;
+	cout << blank << blank << "Checks whether the tree is valid with respect to the element type" << endl;
+	cout << blank << blank << "declarations of the specified DTD (character data and attributes" << endl;
+	cout << blank << blank << "are not part of the tree and are therefore not validated)." << endl;
+	cout << blank << "-xpath QUERY" << endl;
+	cout << blank << blank << "Prints the preorder numbers of the elements selected by an absolute" << endl;
+	cout << blank << blank << "location path with child (/) and descendant (//) steps whose node" << endl;
+	cout << blank << blank << "tests are element types or *, e.g., /a//b/*. Prints only their" << endl;
+	cout << blank << blank << "number if the path is enclosed in count() (may be specified several" << endl;
+	cout << blank << blank << "times)." << endl;
+	cout << blank << blank << "All of the above except -count, -element, -validate and -xpath are" << endl;
+	cout << blank << blank << "printed if no query is specified." << endl;
+}
+
+int main (int argc, char* args[]) {
+
+	if (argc == 1) {
+		cout << "Please specify a valid input file, i.e., a file generated by " << endl;
+		cout << "a run of TreeRePair (with file extension .rep)." << endl;
+		printHelp();
+		exit(1);
+	}
+
+	char * pFilePath = 0;
+	vector<string> elementTypes;
+	vector<unsigned long long> preorders;
+	vector<string> queries;
+	char * pSchemaPath = 0;
+	bool printDepth = false, printHistogram = false, printNodes = false;
+
+	for (int i = 1; i < argc; i++) {
+		char * arg = args[i];
+		if (arg[0] == '-') {
+			switch(arg[1]) {
+				case 'c': // -count ELEMENT_TYPE
+					if (i + 1 >= argc) {
+						cout << "Please specify an element type to count." << endl;
+						exit(1);
+					}
+					elementTypes.push_back(args[i + 1]);
+					i++;
+					break;
+				case 'd': // -depth
+					printDepth = true;
+					break;
+				case 'e': // -element PREORDER
+					if (i + 1 >= argc) {
+						cout << "Please specify the preorder number of an element." << endl;
+						exit(1);
+					}
+					preorders.push_back(strtoull(args[i + 1], 0, 10));
+					i++;
+					break;
+				case 'h': // -histogram
+					printHistogram = true;
+					break;
+				case 'n': // -nodes
+					printNodes = true;
+					break;
+				case 't': // -textual
+					TreeRePairMode::getInstance()->setUseTextualGrammar(true);
+					break;
+				case 'v': // -validate DTD
+					if (i + 1 >= argc) {
+						cout << "Please specify a DTD." << endl;
+						exit(1);
+					}
+					pSchemaPath = args[i + 1];
+					i++;
+					break;
+				case 'x': // -xpath QUERY
+					if (i + 1 >= argc) {
+						cout << "Please specify an XPath query." << endl;
+						exit(1);
+					}
+					queries.push_back(args[i + 1]);
+					i++;
+					break;
+				case '\0':
+					cout << "Unknown switch." << endl;
+				default:
+					cout << "Unknown switch: " << arg << endl;
+
+					printHelp();
+					exit(0);
+					break;
+			}
+		} else {
+			pFilePath = arg;
+		}
+	}
+
+	if (pFilePath == 0) {
+		cout << "Please specify a valid input file, i.e., a file generated by " << endl;
+		cout << "a run of TreeRePair (with file extension .rep)." << endl;
+		exit(1);
+	} else if (!Helper::fileExists(pFilePath)) {
+		cout << "The specified input file does not exist." << endl;
+		exit(1);
+	}
+
+	if (pSchemaPath != 0 && !Helper::fileExists(pSchemaPath)) {
+		cout << "The specified DTD does not exist." << endl;
+		exit(1);
+	}
+
+	if (elementTypes.empty() && preorders.empty() && queries.empty()
+			&& pSchemaPath == 0
+			&& !printDepth && !printHistogram && !printNodes) {
+		printDepth = printHistogram = printNodes = true;
+	}
+
+	TreeRePairMode::getInstance()->setAlgMode(TreeRePairMode::DECOMPRESS);
+
+	{
+		Grammar dagGrammar;
+		Grammar mainGrammar;
+
+		// we instantiate the start symbol so that the first
+		// nonterminal of the input file becomes id 1 (instead of 0)
+		Symbol::getStartSymbol();
+
+		if (TreeRePairMode::getInstance()->useTextualGrammar()) {
+			TextualGrammarReader reader(pFilePath, dagGrammar, mainGrammar);
+		} else {
+			HuffmanSuccinctReader reader(pFilePath, dagGrammar, mainGrammar);
+		}
+
+		GrammarSummary summary(dagGrammar, mainGrammar);
+
+		if (printNodes) {
+			cout << "Number of elements: " << summary.getNumberOfElements() << endl;
+		}
+		if (printDepth) {
+			cout << "Maximal depth: " << summary.getMaximalDepth() << endl;
+		}
+		for (unsigned int i = 0; i < elementTypes.size(); i++) {
+			cout << "Number of " << elementTypes[i] << " elements: "
+					<< summary.getNumberOfElements(elementTypes[i]) << endl;
+		}
+		if (printHistogram) {
+			const map<string, unsigned long long> & histogram =
+					summary.getElementTypeHistogram();
+			cout << "Element types:" << endl;
+			for (map<string, unsigned long long>::const_iterator it =
+					histogram.begin(); it != histogram.end(); it++) {
+				cout << "  " << it->first << " " << it->second << endl;
+			}
+		}
+
+		if (!preorders.empty()) {
+			GrammarNavigator navigator(dagGrammar, mainGrammar);
+			for (unsigned int i = 0; i < preorders.size(); i++) {
+				printElement(navigator, preorders[i]);
+			}
+		}
+
+		if (!queries.empty()) {
+			XPathEvaluator evaluator(dagGrammar, mainGrammar);
+			for (unsigned int i = 0; i < queries.size(); i++) {
+				if (!evaluator.setQuery(queries[i])) {
+					cout << "Unsupported XPath query: " << queries[i] << endl;
+				} else if (evaluator.isCountQuery()) {
+					cout << queries[i] << ": " << evaluator.getNumberOfMatches() << endl;
+				} else {
+					vector<unsigned long long> matches;
+					evaluator.getMatches(matches);
+					cout << queries[i] << ": " << matches.size() << " elements" << endl;
+					for (unsigned int j = 0; j < matches.size(); j++) {
+						cout << "  " << matches[j] << endl;
+					}
+				}
+			}
+		}
+
+		if (pSchemaPath != 0) {
+			SchemaAutomaton automaton(pSchemaPath);
+			GrammarValidator validator(dagGrammar, mainGrammar, automaton);
+			cout << "Valid: " << (validator.isValid() ? "yes" : "no") << endl;
+		}
+	}
+
+	Helper::deleteSymbols();
+	TreeRePairMode::deleteInstance();
+
+	return 0;
+}
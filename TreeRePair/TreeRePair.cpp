@@ -39,7 +39,10 @@ static void printHelp() {
 	cout << endl << "Parameters:" << endl;
 
 	cout << blank << "input_file" << endl;
-	cout << blank << blank << "input_file must be a well-formed XML file." << endl;
+	cout << blank << blank << "input_file must be a well-formed XML file, a file generated by " << endl;
+	cout << blank << blank << "TreeRePair (extension \"rep\") or a grammar in BPLEX-like format " << endl;
+	cout << blank << blank << "(extension \"g\"). A grammar is recompressed without " << endl;
+	cout << blank << blank << "decompressing it, the result is written to input_file.rep." << endl;
 
 	cout << blank << "-optimize MODE" << endl;
 	cout << blank << blank << "Optimizes either the file size (\"filesize\") or the number of " << endl;
@@ -63,6 +66,15 @@ static void printHelp() {
 	cout << blank << "-p" << endl;
 	cout << blank << blank << "Shows progress of the digram replacement process." << endl;
 
+	cout << blank << "-profile FILE" << endl;
+	cout << blank << blank << "Writes the wall time, CPU time and memory usage of each phase" << endl;
+	cout << blank << blank << "of the algorithm together with some counters in JSON format" << endl;
+	cout << blank << blank << "to FILE." << endl;
+
+	cout << blank << "-trace FILE" << endl;
+	cout << blank << blank << "Writes one CSV line per iteration of the digram replacement" << endl;
+	cout << blank << blank << "loop to FILE. Use TreeRePairTraceAnalyzer to summarize it." << endl;
+
 	cout << blank << "-max_rank MAX_RANK" << endl;
 	cout << blank << blank << "MAX_RANK specifies the maximal rank of any nonterminal. It " << endl;
 	cout << blank << blank << "must be of type Integer. Default is " << MAX_RANK << "." << endl;
@@ -116,8 +128,21 @@ static char * processTreeRePairArgs(int argc, char * args[])
 				TreeRePairMode::getInstance()->setMaxRank(maxRank);
 				i++;
 				break;
-			case 't': // textual
-				TreeRePairMode::getInstance()->setUseTextualGrammar(true);
+			case 't':
+				if (arg[2] == 'r')
+				{ // trace
+					if (i + 1 >= argc)
+					{
+						cout << "Please specify a trace output file." << endl;
+						exit(1);
+					}
+					TreeRePairMode::getInstance()->setTraceFilePath(args[i + 1]);
+					i++;
+				}
+				else
+				{ // textual
+					TreeRePairMode::getInstance()->setUseTextualGrammar(true);
+				}
 				break;
 			case 'n': // no_dag
 				TreeRePairMode::getInstance()->setUseDag(false);
@@ -157,7 +182,20 @@ static char * processTreeRePairArgs(int argc, char * args[])
 				//					TreeRePairMode::getInstance()->setUseDag(true);
 				//					break;
 			case 'p':
-				TreeRePairMode::getInstance()->setShowProgress(true);
+				if (arg[2] == 'r')
+				{ // profile
+					if (i + 1 >= argc)
+					{
+						cout << "Please specify a profile output file." << endl;
+						exit(1);
+					}
+					TreeRePairMode::getInstance()->setProfileFilePath(args[i + 1]);
+					i++;
+				}
+				else
+				{
+					TreeRePairMode::getInstance()->setShowProgress(true);
+				}
 				break;
 			case 'v':
 				TreeRePairMode::getInstance()->setVerboseMode(true);
@@ -0,0 +1,285 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "TreeRePairAlgorithm.h"
+#include "TreeGenerator.h"
+#include "TreeRePairMode.h"
+#include "TreeRePairVersion.h"
+#include "Profiler.h"
+#include "Helper.h"
+#include "TablePrinter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+/**
+ * The results of compressing one synthetic tree.
+ */
+struct SizePointResult
+{
+	unsigned long long numberOfNodes;
+	double generationTimeInMs;
+	double compressionTimeInMs;
+	unsigned long long outputSizeInBytes;
+	long long peakMemoryInKb;
+};
+
+static void printHelp() {
+	string blank = Helper::getBlankCharacters(1);
+
+	cout << endl;
+	cout << "TreeRePair is an implementation of the Re-pair for Trees algorithm." << endl;
+	cout << "This tool compresses synthetic trees of geometrically increasing" << endl;
+	cout << "sizes and reports how time, memory and output size scale." << endl;
+	cout << endl;
+	cout << "Copyright (c) 2010 Roy Mennicke, Build date: " << VERSION << endl;
+	cout << endl;
+	cout << "Usage: TreeRePairBenchmark [-from N] [-to N] [-factor F] [-depth D]" << endl;
+	cout << "           [-fanout F] [-vocabulary V] [-repetitiveness R] [-seed S]" << endl;
+	cout << "           [-max_rank MAX_RANK]" << endl;
+
+	cout << endl << "Parameters:" << endl;
+
+	cout << blank << "-from N, -to N" << endl;
+	cout << blank << blank << "The number of nodes of the smallest and of the largest tree." << endl;
+	cout << blank << blank << "Defaults are 10000 and 1280000." << endl;
+
+	cout << blank << "-factor F" << endl;
+	cout << blank << blank << "The factor by which the size grows from one tree to the next." << endl;
+	cout << blank << blank << "Default is 2." << endl;
+
+	cout << blank << "-depth D" << endl;
+	cout << blank << blank << "The maximal depth of the trees. Default is 6." << endl;
+
+	cout << blank << "-fanout F" << endl;
+	cout << blank << blank << "The maximal number of children of a node except the root." << endl;
+	cout << blank << blank << "Default is 8." << endl;
+
+	cout << blank << "-vocabulary V" << endl;
+	cout << blank << blank << "The number of different element names. Default is 32." << endl;
+
+	cout << blank << "-repetitiveness R" << endl;
+	cout << blank << blank << "The probability (between 0 and 1) that a subtree is a copy of" << endl;
+	cout << blank << blank << "a previously generated subtree. Default is 0.5." << endl;
+
+	cout << blank << "-seed S" << endl;
+	cout << blank << blank << "The seed of the pseudo random number generator. Default is 1." << endl;
+
+	cout << blank << "-max_rank MAX_RANK" << endl;
+	cout << blank << blank << "The maximal rank of any nonterminal." << endl;
+
+	cout << endl;
+}
+
+static char * getParameter(int argc, char * args[], int i)
+{
+	if (i + 1 >= argc)
+	{
+		cout << "Missing value for switch " << args[i] << "." << endl;
+		exit(1);
+	}
+	return args[i + 1];
+}
+
+/**
+ * Compresses the synthetic tree specified by the parameters in a child
+ * process. Running each size point in its own process makes the peak
+ * memory usage of the size points independent of each other.
+ */
+static bool runSizePoint(const SyntheticTreeParameters & parameters,
+		unsigned int maxRank, SizePointResult & result)
+{
+	int fds[2];
+	if (pipe(fds) != 0)
+	{
+		cout << "Could not create pipe. Exiting ..." << endl;
+		exit(1);
+	}
+
+	cout << flush;
+
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		close(fds[0]);
+
+		if (maxRank > 0)
+		{
+			TreeRePairMode::getInstance()->setMaxRank(maxRank);
+		}
+
+		string filePath = "TreeRePairBenchmark_"
+				+ Helper::stringify((size_t) parameters.numberOfNodes) + ".xml";
+
+		TreeRePairAlgorithm * pAlg = new TreeRePairAlgorithm(
+				(char *) filePath.c_str(), parameters);
+
+		Profiler * pProfiler = Profiler::getInstance();
+		SizePointResult childResult;
+		childResult.numberOfNodes = pProfiler->getCounter("nodes_parsed");
+		childResult.generationTimeInMs = pProfiler->getTotalWallTime() -
+				pProfiler->getTotalWallTime("parse");
+		childResult.compressionTimeInMs = pProfiler->getTotalWallTime("parse");
+		childResult.outputSizeInBytes = pProfiler->getCounter("bytes_written");
+		childResult.peakMemoryInKb = 0;
+
+		delete pAlg;
+		remove(Helper::getFilePathForBinary(filePath.c_str()).c_str());
+
+		ssize_t written = write(fds[1], &childResult, sizeof(childResult));
+		close(fds[1]);
+		_exit(written == sizeof(childResult) ? 0 : 1);
+	}
+	else if (pid < 0)
+	{
+		cout << "Could not fork. Exiting ..." << endl;
+		exit(1);
+	}
+
+	close(fds[1]);
+	ssize_t bytesRead = read(fds[0], &result, sizeof(result));
+	close(fds[0]);
+
+	int status;
+	rusage usage;
+	wait4(pid, &status, 0, &usage);
+
+	if (bytesRead != sizeof(result) || !WIFEXITED(status)
+			|| WEXITSTATUS(status) != 0)
+	{
+		return false;
+	}
+
+	result.peakMemoryInKb = usage.ru_maxrss;
+	return true;
+}
+
+static string formatDouble(double value, const char * format)
+{
+	char buf[32];
+	snprintf(buf, sizeof(buf), format, value);
+	return buf;
+}
+
+int main (int argc, char* args[]) {
+
+	SyntheticTreeParameters parameters;
+	unsigned int from = 10000, to = 1280000, maxRank = 0;
+	double factor = 2;
+
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = args[i];
+		if (arg == "-from") {
+			from = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-to") {
+			to = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-factor") {
+			factor = atof(getParameter(argc, args, i++));
+		} else if (arg == "-depth") {
+			parameters.maxDepth = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-fanout") {
+			parameters.fanOut = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-vocabulary") {
+			parameters.vocabularySize = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-repetitiveness") {
+			parameters.repetitiveness = atof(getParameter(argc, args, i++));
+		} else if (arg == "-seed") {
+			parameters.seed = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-max_rank") {
+			maxRank = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-help") {
+			printHelp();
+			exit(0);
+		} else {
+			cout << "Unknown switch: " << arg << endl;
+			exit(1);
+		}
+	}
+
+	if (factor <= 1 || from == 0 || to < from)
+	{
+		cout << "Invalid range of sizes. Use the -help switch to show the help screen." << endl;
+		exit(1);
+	}
+
+	cout << "depth: " << parameters.maxDepth << ", fan-out: " << parameters.fanOut
+			<< ", vocabulary: " << parameters.vocabularySize
+			<< ", repetitiveness: " << parameters.repetitiveness
+			<< ", seed: " << parameters.seed << endl << endl;
+
+	unsigned int widths[] = { 10, 12, 14, 9, 9, 14, 13, 10 };
+	TablePrinter tablePrinter;
+	tablePrinter.init(8, widths);
+	tablePrinter.addColumnData("Nodes");
+	tablePrinter.addColumnData("Gen. [ms]");
+	tablePrinter.addColumnData("Compr. [ms]");
+	tablePrinter.addColumnData("ns/node");
+	tablePrinter.addColumnData("Exponent");
+	tablePrinter.addColumnData("Peak mem [MB]");
+	tablePrinter.addColumnData("Output [B]");
+	tablePrinter.addColumnData("Bits/node");
+	tablePrinter.printRowAsHeader();
+
+	SizePointResult lastResult;
+	lastResult.numberOfNodes = 0;
+	lastResult.compressionTimeInMs = 0;
+
+	for (double size = from; size <= to * 1.0001; size *= factor)
+	{
+		parameters.numberOfNodes = (unsigned int) size;
+
+		SizePointResult result;
+		if (!runSizePoint(parameters, maxRank, result))
+		{
+			cout << "Compression of " << parameters.numberOfNodes
+					<< " nodes failed." << endl;
+			return 1;
+		}
+
+		// the exponent e with time ~ nodes^e between two size points
+		string exponent = "-";
+		if (lastResult.compressionTimeInMs > 0
+				&& result.numberOfNodes > lastResult.numberOfNodes)
+		{
+			exponent = formatDouble(log(result.compressionTimeInMs
+					/ lastResult.compressionTimeInMs)
+					/ log((double) result.numberOfNodes
+							/ lastResult.numberOfNodes), "%.2f");
+		}
+
+		tablePrinter.addColumnData(Helper::stringify((size_t) result.numberOfNodes));
+		tablePrinter.addColumnData(formatDouble(result.generationTimeInMs, "%.1f"));
+		tablePrinter.addColumnData(formatDouble(result.compressionTimeInMs, "%.1f"));
+		tablePrinter.addColumnData(formatDouble(result.compressionTimeInMs
+				* 1000000.0 / result.numberOfNodes, "%.0f"));
+		tablePrinter.addColumnData(exponent);
+		tablePrinter.addColumnData(formatDouble(result.peakMemoryInKb / 1024.0, "%.1f"));
+		tablePrinter.addColumnData(Helper::stringify((size_t) result.outputSizeInBytes));
+		tablePrinter.addColumnData(formatDouble(result.outputSizeInBytes * 8.0
+				/ result.numberOfNodes, "%.3f"));
+		tablePrinter.printRow();
+
+		lastResult = result;
+	}
+
+	return 0;
+}
@@ -44,12 +44,14 @@ public:
 	void endElement(string & name);
 	void endDocument();
 
-private:
 	/**
 	 * This method retrieves the terminal symbol with the specified element type and
-	 * children characteristic from a hash map and returns it.
+	 * children characteristic from a hash map and returns it. The symbol is created
+	 * if it does not exist yet.
 	 */
-	Symbol * retrieveSymbol(string elementType, bool hasLeftChild, bool hasRightChild);
+	static Symbol * retrieveSymbol(string elementType, bool hasLeftChild, bool hasRightChild);
+
+private:
 
 	/**
 	 * The root of the tree constructed.
@@ -19,9 +19,11 @@
 #include "BplexGrammarReader.h"
 
 #include "TreeRePairConstants.h"
+#include "TreeRePairMode.h"
 #include "Symbol.h"
 #include "Digram.h"
 #include "Production.h"
+#include "BinaryTreeConstructor.h"
 
 #include <vector>
 
@@ -31,7 +33,9 @@ BplexGrammarReader::BplexGrammarReader(char * pFilePath,
 		Grammar & dagGrammarPar, Grammar & mainGrammarPar) :
 	dagGrammar(dagGrammarPar), mainGrammar(mainGrammarPar) {
 
-	cout << "Grammar file: " << pFilePath << endl;
+	if (TreeRePairMode::getInstance()->isVerboseMode()) {
+		cout << "Grammar file: " << pFilePath << endl;
+	}
 
 	ifstream ifs;
 	ifs.open(pFilePath);
@@ -45,6 +49,11 @@ BplexGrammarReader::BplexGrammarReader(char * pFilePath,
 
 	ifs.close();
 
+	if (lines.empty()) {
+		cout << "Fatal error: The grammar file is empty. Exiting ..." << endl;
+		exit(1);
+	}
+
 	for (unsigned int i = lines.size() - 1; i > 0; i--) {
 		retrieveProduction(mainGrammar, lines[i]);
 	}
@@ -214,9 +223,8 @@ Symbol * BplexGrammarReader::createTerminalSymbol(string & strName) {
 
 		pSymbol = Symbol::getParameterSymbol();
 	} else {
-		pSymbol = new Symbol();
-		pSymbol->setRank(2);
-		pSymbol->addSymbolToHashMaps(strName);
+		// every terminal has two children (which may be the placeholder)
+		pSymbol = BinaryTreeConstructor::retrieveSymbol(strName, true, true);
 	}
 	nameSymbolsHashMap[strName] = pSymbol;
 	return pSymbol;
@@ -75,7 +75,9 @@ private:
 	/**
 	 * Creates a Symbol instance to use for the specified symbol name. If
 	 * the specified name starts with an "y" the unique parameter symbol
-	 * is returned (see Symbol::getParameterSymbol()).
+	 * is returned (see Symbol::getParameterSymbol()). Otherwise, the
+	 * terminal symbol of rank 2 with both children of
+	 * BinaryTreeConstructor is returned.
 	 */
 	Symbol * createTerminalSymbol(string & strName);
 
@@ -36,14 +36,15 @@ void DefaultTreePrinter::printTree(TreeNode * pNode) {
 	TreePrinter::printTree(pNode);
 }
 
-void DefaultTreePrinter::processNode(TreeNode * pParent, unsigned int index, int depth, bool closing) {
+void DefaultTreePrinter::preVisit(TreeNode * pNode, unsigned int index, int depth) {
+	printNode(pNode, false);
+}
 
-	TreeNode * pNode;
-	if (index != UINT_MAX) {
-		pNode = pParent->getChild(index);
-	} else {
-		pNode = pParent;
-	}
+void DefaultTreePrinter::postVisit(TreeNode * pNode, unsigned int index, int depth) {
+	printNode(pNode, true);
+}
+
+void DefaultTreePrinter::printNode(TreeNode * pNode, bool closing) {
 
 	// TODO implementation working for dag mode?
 	if (grammar != 0 && grammar->isNonTerminal(pNode->getSymbol())) {
@@ -27,8 +27,10 @@
  * TextualGrammarWriter class.
  */
 class DefaultTreePrinter :
-	public TreePrinter
+	public TreePrinter<DefaultTreePrinter>
 {
+	friend class StaticTreeTraversal<DefaultTreePrinter>;
+
 public:
 	/**
 	 * The constructor of the class.
@@ -53,9 +55,15 @@ public:
 	void printTree(TreeNode * pNode);
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
+	void postVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
+	/**
+	 * Prints the opening (or closing) part of the specified node.
+	 */
+	void printNode(TreeNode * pNode, bool closing);
+
 	/**
 	 * The grammar representing the tree which shall
 	 * be printed. If, during the printing, a nonterminal of this
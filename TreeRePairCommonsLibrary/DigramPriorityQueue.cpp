@@ -28,7 +28,7 @@ using namespace std;
 
 DigramPriorityQueue::DigramPriorityQueue(const unsigned int n,
 		HASH_D_D * pDigramHashMapPar) :
-	pDigramHashMap(pDigramHashMapPar) {
+	pDigramHashMap(pDigramHashMapPar), lastScanLength(0) {
 
 	numberOfDigramLists = (int) sqrt((float) n);
 	currentDigramListIndex = numberOfDigramLists - 1;
@@ -60,6 +60,7 @@ Digram * DigramPriorityQueue::top() {
 	// unsigned int bound = TreeRePairMode::getInstance()->getBound();
 
 	Digram * pTopDigram = 0;
+	unsigned int scanLength = 0;
 
 	if (currentDigramListIndex == numberOfDigramLists - 1) {
 		if (pDigramLists[numberOfDigramLists - 1] != 0) {
@@ -68,6 +69,7 @@ Digram * DigramPriorityQueue::top() {
 					&& (pDigram->getRankOfTreePattern() > TreeRePairMode::getInstance()->getMaxRank()
 							|| pDigram->getNumberOfOccs() < 2)) {
 				pDigram = pDigram->getFollowingDigram();
+				scanLength++;
 			}
 
 			if (pDigram != 0) {
@@ -83,6 +85,7 @@ Digram * DigramPriorityQueue::top() {
 						pDigram = pCurDigram;
 					}
 					pCurDigram = pCurDigram->getFollowingDigram();
+					scanLength++;
 				}
 				pTopDigram = pDigram;
 			}
@@ -99,6 +102,7 @@ Digram * DigramPriorityQueue::top() {
 		// this restriction had no negative consequences on the compression
 		// results concerning the test files
 		for (int i = beginWithDigramListIndex; i >= 0; i--) {
+			scanLength++;
 			if (pDigramLists[i] != 0) {
 				Digram * pDigram = pDigramLists[i];
 
@@ -106,6 +110,7 @@ Digram * DigramPriorityQueue::top() {
 						&& (pDigram->getRankOfTreePattern() > TreeRePairMode::getInstance()->getMaxRank()
 								|| pDigram->getNumberOfOccs() < 2)) {
 					pDigram = pDigram->getFollowingDigram();
+					scanLength++;
 				}
 
 				if (pDigram == 0) {
@@ -123,6 +128,8 @@ Digram * DigramPriorityQueue::top() {
 		// cout << "found digram in top digram list ..." << endl;
 	}
 
+	lastScanLength = scanLength;
+
 	return pTopDigram;
 }
 
@@ -78,6 +78,12 @@ public:
 	 */
 	Digram * top();
 
+	/**
+	 * Returns the number of digram lists and digrams which were
+	 * inspected during the last call of top().
+	 */
+	unsigned int getLastScanLength() { return lastScanLength; };
+
 #ifdef DEBUG
 	/**
 	 * Prints the current contents of the digram priority queue.
@@ -146,4 +152,10 @@ private:
 	 * to retrieve the most frequent digram.
 	 */
 	unsigned int currentDigramListIndex;
+
+	/**
+	 * The number of digram lists and digrams inspected during the
+	 * last call of top().
+	 */
+	unsigned int lastScanLength;
 };
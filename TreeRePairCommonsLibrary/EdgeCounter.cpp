@@ -22,17 +22,21 @@
 #include "Production.h"
 
 EdgeCounter::EdgeCounter(Grammar * pDagGrammarPar, bool countParametersPar)
-: TreeTraversal(0), pDagGrammar(pDagGrammarPar), numberOfEdges(0), countParameters(countParametersPar)
+: pDagGrammar(pDagGrammarPar), pExpandedEdgeCounter(0),
+  numberOfEdges(0), countParameters(countParametersPar)
 {
+	if (pDagGrammar != 0) {
+		pExpandedEdgeCounter = new ExpandedEdgeCounter(*pDagGrammar);
+	}
 }
 
 EdgeCounter::~EdgeCounter(void)
 {
+	delete pExpandedEdgeCounter;
 }
 
 void EdgeCounter::countEdges(TreeNode * pRoot) {
-	this->pRoot = pRoot;
-	traverseTree();
+	traverseTree(pRoot);
 }
 
 void EdgeCounter::countEdges(Grammar & grammar) {
@@ -48,34 +52,26 @@ void EdgeCounter::countEdges(Grammar & grammar) {
 //		}
 //#endif
 
-		pRoot = pProduction->getRightHandSide();
-		traverseTree();
+		traverseTree(pProduction->getRightHandSide());
 	}
 }
 
-void EdgeCounter::processNode(TreeNode * pNode, unsigned int index, int depth, bool closing) {
-
-	if (index == UINT_MAX || closing == true) {
-		return;
-	}
+void EdgeCounter::visitEdge(TreeNode * pParent, unsigned int index, TreeNode * pChild) {
 
-	if (pNode->getChild(index)->getSymbol() == Symbol::getPlaceholderSymbol()) {
+	if (pChild->getSymbol() == Symbol::getPlaceholderSymbol()) {
 		return;
 	}
 
 	// count edges to parameters
 	if (!countParameters
-			&& pNode->getChild(index)->getSymbol()->getId() == Symbol::getParameterSymbol()->getId()) {
+			&& pChild->getSymbol()->getId() == Symbol::getParameterSymbol()->getId()) {
 		return;
 	}
 
 	numberOfEdges++;
 
-	TreeNode * pChild = pNode->getChild(index);
 	if (pDagGrammar != 0 && pDagGrammar->isNonTerminal(pChild->getSymbol())) {
 		Production * pProduction = pDagGrammar->getProductionBySymbol(pChild->getSymbol());
-		EdgeCounter edgeCounter(pDagGrammar);
-		edgeCounter.countEdges(pProduction->getRightHandSide());
-		numberOfEdges += edgeCounter.getNumberOfEdges();
+		numberOfEdges += pExpandedEdgeCounter->getExpandedEdges(pProduction);
 	}
 }
@@ -18,27 +18,32 @@
  */
 #pragma once
 
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "TreeNode.h"
 #include "TreeRePairMacros.h"
 #include "Grammar.h"
+#include "ExpandedEdgeCounter.h"
 
 /**
  * This class is used to count the edges of a tree.
  */
-class EdgeCounter : public TreeTraversal
+class EdgeCounter : public StaticTreeTraversal<EdgeCounter>
 {
+	friend class StaticTreeTraversal<EdgeCounter>;
+
 public:
 	/**
 	 * The constructor of the class.
 	 * @param pDagGrammar Can contain an optional DAG grammar. If specified,
 	 *  every encountered nonterminal of it is substituted by the subtree
 	 *  representing it (i.e., the edges of the subtrees are considered too).
+	 *  The sizes of these subtrees are determined only once using an
+	 *  ExpandedEdgeCounter.
 	 * @param countParameters Specifies if edges to parameter nodes shall
 	 *  be counted too (default).
 	 */
 	EdgeCounter(Grammar * pDagGrammar = 0, bool countParameters = true);
-	virtual ~EdgeCounter(void);
+	~EdgeCounter(void);
 
 	/**
 	 * This method initiates the counting of the edges.
@@ -56,10 +61,10 @@ public:
 	 * This method returns the number of edges counted.
 	 * @returns the number of edges counted
 	 */
-	unsigned int getNumberOfEdges() { return numberOfEdges; };
+	unsigned long long getNumberOfEdges() { return numberOfEdges; };
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void visitEdge(TreeNode * pParent, unsigned int index, TreeNode * pChild);
 
 private:
 	/**
@@ -69,10 +74,16 @@ private:
 	 */
 	Grammar * pDagGrammar;
 
+	/**
+	 * Provides the sizes of the subtrees represented by the nonterminals
+	 * of the DAG grammar (null if no DAG grammar was specified).
+	 */
+	ExpandedEdgeCounter * pExpandedEdgeCounter;
+
 	/**
 	 * Keeps track of the number of edges counted so far.
 	 */
-	unsigned int numberOfEdges;
+	unsigned long long numberOfEdges;
 
 	/**
 	 * Indicates if edges to parameter nodes shall be counted too.
@@ -0,0 +1,165 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "ExpandedEdgeCounter.h"
+
+#include "Production.h"
+
+#include <deque>
+
+ExpandedEdgeCounter::ExpandedEdgeCounter(Grammar & dagGrammar, Grammar * pMainGrammar) :
+	currentUnit(0), numberOfEdges(0), countParameters(false)
+{
+	addUnits(dagGrammar);
+	if (pMainGrammar != 0) {
+		addUnits(*pMainGrammar);
+	}
+
+	unsigned int size = unitRoots.size();
+	expandedEdges.assign(size, 0);
+	referencedUnits.resize(size);
+	vector<unsigned int> pendingReferences(size, 0);
+
+	// count the edges of every right-hand side itself and remember
+	// the units it references
+	for (currentUnit = 0; currentUnit < size; currentUnit++) {
+		numberOfEdges = 0;
+		traverseTree(unitRoots[currentUnit]);
+		expandedEdges[currentUnit] = numberOfEdges;
+
+		vector<unsigned int> & units = referencedUnits[currentUnit];
+		for (unsigned int i = 0; i < units.size(); i++) {
+			pendingReferences[units[i]]++;
+		}
+	}
+
+	// determine a topological order, i.e., a unit is placed after
+	// all units referencing it
+	vector<unsigned int> order;
+	order.reserve(size);
+	deque<unsigned int> readyUnits;
+	for (unsigned int i = 0; i < size; i++) {
+		if (pendingReferences[i] == 0) {
+			readyUnits.push_back(i);
+		}
+	}
+
+	while (!readyUnits.empty()) {
+		unsigned int unit = readyUnits.front();
+		readyUnits.pop_front();
+		order.push_back(unit);
+
+		vector<unsigned int> & units = referencedUnits[unit];
+		for (unsigned int i = 0; i < units.size(); i++) {
+			if (--pendingReferences[units[i]] == 0) {
+				readyUnits.push_back(units[i]);
+			}
+		}
+	}
+
+	// in reverse topological order, the referenced units are complete
+	// when a unit is processed
+	for (unsigned int i = order.size(); i > 0; i--) {
+		unsigned int unit = order[i - 1];
+		vector<unsigned int> & units = referencedUnits[unit];
+		for (unsigned int j = 0; j < units.size(); j++) {
+			expandedEdges[unit] += expandedEdges[units[j]];
+		}
+	}
+
+	vector<vector<unsigned int> >().swap(referencedUnits);
+	currentUnit = UINT_MAX;
+}
+
+ExpandedEdgeCounter::~ExpandedEdgeCounter(void)
+{
+}
+
+void ExpandedEdgeCounter::addUnits(Grammar & grammar)
+{
+	for (unsigned int i = 0; i < grammar.size(); i++) {
+		Production * pProduction = grammar[i];
+		unitIndexes[pProduction->getLeftHandSide()->getId()] = unitRoots.size();
+		unitRoots.push_back(pProduction->getRightHandSide());
+	}
+}
+
+unsigned long long ExpandedEdgeCounter::countEdges(TreeNode * pRootPar, bool countParametersPar)
+{
+	numberOfEdges = 0;
+	countParameters = countParametersPar;
+	traverseTree(pRootPar);
+	return numberOfEdges;
+}
+
+unsigned long long ExpandedEdgeCounter::countEdges(Grammar & grammar, bool countParametersPar)
+{
+	unsigned long long edges = 0;
+	for (unsigned int i = 0; i < grammar.size(); i++) {
+		edges += countEdges(grammar[i]->getRightHandSide(), countParametersPar);
+	}
+	return edges;
+}
+
+unsigned long long ExpandedEdgeCounter::getExpandedEdges(Production * pProduction)
+{
+	HASH_I_I::iterator it = unitIndexes.find(pProduction->getLeftHandSide()->getId());
+	if (it == unitIndexes.end()) {
+		return 0;
+	}
+	return expandedEdges[it->second];
+}
+
+unsigned int ExpandedEdgeCounter::getUnitIndex(TreeNode * pNode)
+{
+	HASH_I_I::iterator it = unitIndexes.find(pNode->getSymbol()->getId());
+	if (it == unitIndexes.end()) {
+		return UINT_MAX;
+	}
+	return it->second;
+}
+
+void ExpandedEdgeCounter::visitEdge(TreeNode * pParent, unsigned int index, TreeNode * pChild)
+{
+	if (pChild->getSymbol() == Symbol::getPlaceholderSymbol()) {
+		return;
+	}
+
+	// the edges to parameters of a right-hand side are replaced
+	// by the edges to the children of the referencing node
+	if (!countParameters
+			&& pChild->getSymbol()->getId() == Symbol::getParameterSymbol()->getId()) {
+		return;
+	}
+
+	numberOfEdges++;
+}
+
+void ExpandedEdgeCounter::preVisit(TreeNode * pNode, unsigned int index, int depth)
+{
+	unsigned int unit = getUnitIndex(pNode);
+	if (unit == UINT_MAX) {
+		return;
+	}
+
+	if (currentUnit == UINT_MAX) {
+		numberOfEdges += expandedEdges[unit];
+	} else {
+		referencedUnits[currentUnit].push_back(unit);
+	}
+}
@@ -0,0 +1,130 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "StaticTreeTraversal.h"
+#include "TreeNode.h"
+#include "TreeRePairTypes.h"
+#include "Grammar.h"
+
+/**
+ * This class determines the number of edges of the trees represented
+ * by the productions of a DAG grammar (and, optionally, of a main grammar).
+ * The size of the expanded right-hand side of every production is computed
+ * exactly once when constructing an instance, in reverse topological order
+ * and using 64-bit counters. Afterwards, the size of any tree referencing
+ * these productions can be determined in time linear in the size of the
+ * tree itself.
+ */
+class ExpandedEdgeCounter : public StaticTreeTraversal<ExpandedEdgeCounter>
+{
+	friend class StaticTreeTraversal<ExpandedEdgeCounter>;
+
+public:
+	/**
+	 * The constructor.
+	 * @param dagGrammar the grammar whose nonterminals are expanded
+	 * @param pMainGrammar an optional second grammar whose nonterminals
+	 *  are expanded too (i.e., the edges of the tree represented by the
+	 *  whole grammar are counted)
+	 */
+	ExpandedEdgeCounter(Grammar & dagGrammar, Grammar * pMainGrammar = 0);
+	~ExpandedEdgeCounter(void);
+
+	/**
+	 * Returns the number of edges of the specified tree in which every
+	 * nonterminal of the expanded grammars is replaced by the tree it
+	 * represents. Edges to placeholder nodes are never counted.
+	 * @param pRoot the root of the tree to count
+	 * @param countParameters specifies if edges to parameter nodes shall
+	 *  be counted too
+	 */
+	unsigned long long countEdges(TreeNode * pRoot, bool countParameters = true);
+
+	/**
+	 * Returns the sum of countEdges() over the right-hand sides of the
+	 * productions of the specified grammar.
+	 */
+	unsigned long long countEdges(Grammar & grammar, bool countParameters = true);
+
+	/**
+	 * Returns the number of edges contributed by a node labeled by the
+	 * left-hand side of the specified production (i.e., the number of edges
+	 * of its expanded right-hand side without the edges to parameters).
+	 * @param pProduction a production of one of the expanded grammars
+	 */
+	unsigned long long getExpandedEdges(Production * pProduction);
+
+protected:
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
+	void visitEdge(TreeNode * pParent, unsigned int index, TreeNode * pChild);
+
+private:
+	/**
+	 * Adds the productions of the specified grammar to the units.
+	 */
+	void addUnits(Grammar & grammar);
+
+	/**
+	 * Returns the index of the unit of the production whose left-hand side
+	 * labels the specified node, or UINT_MAX if the node is not labeled by
+	 * a nonterminal of the expanded grammars.
+	 */
+	unsigned int getUnitIndex(TreeNode * pNode);
+
+	/**
+	 * The right-hand sides of the productions of the expanded grammars.
+	 */
+	vector<TreeNode *> unitRoots;
+
+	/**
+	 * Maps the ids of the left-hand sides of the productions of the
+	 * expanded grammars to the indexes of their units.
+	 */
+	HASH_I_I unitIndexes;
+
+	/**
+	 * For each unit, the number of edges of its expanded right-hand side
+	 * without the edges to parameters.
+	 */
+	vector<unsigned long long> expandedEdges;
+
+	/**
+	 * For each unit, the indexes of the units referenced by it (one entry
+	 * per referencing node). It is only used while constructing an instance.
+	 */
+	vector<vector<unsigned int> > referencedUnits;
+
+	/**
+	 * The unit currently traversed, or UINT_MAX if a tree is counted
+	 * via countEdges().
+	 */
+	unsigned int currentUnit;
+
+	/**
+	 * The number of edges counted by the traversal currently running.
+	 */
+	unsigned long long numberOfEdges;
+
+	/**
+	 * Indicates if the traversal currently running counts edges to
+	 * parameter nodes.
+	 */
+	bool countParameters;
+};
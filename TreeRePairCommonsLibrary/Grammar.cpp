@@ -34,6 +34,11 @@ Grammar::Grammar(void)
 }
 
 Grammar::~Grammar(void)
+{
+	deleteProductions();
+}
+
+void Grammar::deleteProductions()
 {
 	TreeDeleter treeDeleter;
 	Production * pProduction = 0;
@@ -44,6 +49,8 @@ Grammar::~Grammar(void)
 	}
 
 	productions.clear();
+	productionBySymbolIdHashMap.clear();
+	productionByRightHandSideHashMap.clear();
 }
 
 Grammar * Grammar::copy() {
@@ -142,6 +149,24 @@ void Grammar::removeProduction(Production * pProduction) {
 	return;
 }
 
+void Grammar::removeProductions(const vector<bool> & isRemoved) {
+
+	unsigned int newSize = 0;
+	for (unsigned int i = 0; i < productions.size(); i++) {
+		Production * pProduction = productions[i];
+
+		if (i < isRemoved.size() && isRemoved[i]) {
+			if (pProduction->getRightHandSide() != 0) {
+				productionByRightHandSideHashMap.erase(pProduction->getRightHandSide());
+			}
+			productionBySymbolIdHashMap.erase(pProduction->getLeftHandSide()->getId());
+		} else {
+			productions[newSize++] = pProduction;
+		}
+	}
+
+	productions.resize(newSize);
+}
 
 Production * Grammar::getProductionBySymbol(Symbol * pSymbol)
 {
@@ -150,7 +175,13 @@ Production * Grammar::getProductionBySymbol(Symbol * pSymbol)
 
 Production * Grammar::getProductionByRightHandSide(TreeNode * pRightHandSide)
 {
-	return productionByRightHandSideHashMap[pRightHandSide];
+	// operator[] would insert the node as a key, which becomes dangling
+	// as soon as the caller deletes the node
+	HASH_N_P::iterator result = productionByRightHandSideHashMap.find(pRightHandSide);
+	if (result == productionByRightHandSideHashMap.end()) {
+		return 0;
+	}
+	return result->second;
 }
 
 bool Grammar::isNonTerminal(Symbol * pSymbol) {
@@ -39,6 +39,13 @@ public:
 	Grammar(void);
 	~Grammar(void);
 
+	/**
+	 * Deletes all productions of the grammar together with their
+	 * right-hand sides. It must be called before the Symbol instances
+	 * are deleted (see Helper::deleteSymbols()).
+	 */
+	void deleteProductions();
+
 	/**
 	 * This operator allows constant time access to the productions of the
 	 * grammar.
@@ -89,6 +96,15 @@ public:
 	 */
 	void removeProduction(Production * pProduction);
 
+	/**
+	 * Removes all productions whose index is marked in the specified
+	 * vector in a single pass. The order of the remaining productions
+	 * is preserved. The productions themselves are not deleted.
+	 * @param isRemoved isRemoved[i] specifies if the i-th production
+	 *  shall be removed
+	 */
+	void removeProductions(const vector<bool> & isRemoved);
+
 	/**
 	 * Updates the right-hand side of a production.
 	 * @param pProduction the production to be updated
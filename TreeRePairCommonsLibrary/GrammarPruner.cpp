@@ -23,6 +23,7 @@
 #include "SymbolReplacer.h"
 #include "EdgeCounter.h"
 #include "RefCountUpdater.h"
+#include "ReferenceCollector.h"
 #include "Helper.h"
 
 #ifdef DEBUG
@@ -123,81 +124,79 @@ void GrammarPruner::pruneGrammar() {
 	// roll back inefficient replacements
 	if (!pruneDagGrammar) {
 
-		unsigned int counter = 0;
-		SymbolReplacer symbolReplacer(dagGrammar, mainGrammar);
+		unsigned int counter = rollBackInefficientReplacements();
 
-		int limit = 0;
-		if (TreeRePairMode::getInstance()->getOptimizationMode() == TreeRePairMode::OPTIMIZE_FILE_SIZE) {
-			limit = 2;
+		if (TreeRePairMode::getInstance()->isVerboseMode()) {
+			cout << "Eliminated " << counter << " inefficient production(s)."
+					<< endl;
 		}
+	}
+}
 
-		//		if (TreeRePairMode::getInstance()->isVerboseMode()) {
-		//			cout << "Rolling back inefficient replacements ..." << endl;
-		//		}
-
-		// cout << "size of grammar: " << grammar->size() << endl;
-		// unsigned int t = 0;
-
-		for (it = grammar->end() - 1; it >= grammar->begin();) {
-			itTemp = it;
-
-			// needed for MSVC++ compiler
-			bool stop = false;
-			if (it != grammar->begin()) {
-				it--;
-			} else {
-				stop = true;
-			}
-
-
-			Production * pProduction = *itTemp;
-
-			EdgeCounter edgeCounter(0, false);
-			edgeCounter.countEdges(pProduction->getRightHandSide());
-			unsigned int edges = edgeCounter.getNumberOfEdges();
+unsigned int GrammarPruner::rollBackInefficientReplacements() {
 
-			int savValue = (int)pProduction->getRefCount() * (int)edges - (int)pProduction->getLeftHandSide()->getRank() - (int)edges;
+	int limit = 0;
+	if (TreeRePairMode::getInstance()->getOptimizationMode() == TreeRePairMode::OPTIMIZE_FILE_SIZE) {
+		limit = 2;
+	}
 
-			//Production::print(cout, pProduction);
-			//cout << "refCount: " << pProduction->getRefCount() << ", ";
-			//cout << "sav-value:" << savValue << endl;
+	// the right-hand side of a production only refers to productions
+	// which were introduced before it; thus, the reference count of a
+	// production is final as soon as all productions introduced after it
+	// are decided, and its right-hand side does not change before it is
+	// inlined itself
+	unsigned int size = mainGrammar.size();
+	vector<bool> isEliminated(size, false);
+	unsigned int counter = 0;
 
-			if (savValue <= limit) {
+	ReferenceCollector referenceCollector(mainGrammar);
+	vector<TreeNode *> references;
 
-				//cout << "Eliminating production ..." << endl;
-//				cout << "refCount: " << pProduction->getRefCount() << ", ";
-//				Production::print(cout, pProduction);
+	for (unsigned int i = size; i > 0; i--) {
+		Production * pProduction = mainGrammar[i - 1];
 
-				symbolReplacer.replaceNonterminal(pProduction);
+		EdgeCounter edgeCounter(0, false);
+		edgeCounter.countEdges(pProduction->getRightHandSide());
+		unsigned int edges = edgeCounter.getNumberOfEdges();
 
-				RefCountUpdater updater(mainGrammar,
-						pProduction->getRightHandSide(),
-						pProduction->getRefCount() - 1);
+		int savValue = (int)pProduction->getRefCount() * (int)edges - (int)pProduction->getLeftHandSide()->getRank() - (int)edges;
 
-				grammar->removeProduction(itTemp);
-				Production::deleteProduction(pProduction);
+		if (savValue <= limit) {
+			isEliminated[i - 1] = true;
+			counter++;
 
-				counter++;
+			// every reference of the right-hand side is copied
+			// (refCount - 1) times when inlining the production
+			if (pProduction->getRefCount() > 0) {
+				references.clear();
+				referenceCollector.collectReferences(pProduction->getRightHandSide(), references);
 
-//				cout << "after pruning: " << endl;
-//				for (unsigned int i = 0; i < grammar->size(); i++) {
-//					Production * pProduction = (*grammar)[i];
-//					Production::print(cout, pProduction);
-//				}
-//				cout << ".................." << endl;
+				for (unsigned int j = 0; j < references.size(); j++) {
+					Production * pOtherProduction = mainGrammar.getProductionBySymbol(references[j]->getSymbol());
+					pOtherProduction->setRefCount(pOtherProduction->getRefCount() + pProduction->getRefCount() - 1);
+				}
 			}
-
-			if (stop) break;
 		}
+	}
 
-		if (TreeRePairMode::getInstance()->isVerboseMode()) {
-			cout << "Eliminated " << counter << " inefficient production(s)."
-					<< endl;
+	SymbolReplacer symbolReplacer(dagGrammar, mainGrammar);
+	vector<Production *> eliminatedProductions;
+
+	for (unsigned int i = size; i > 0; i--) {
+		if (isEliminated[i - 1]) {
+			Production * pProduction = mainGrammar[i - 1];
+			symbolReplacer.inlineProduction(pProduction);
+			eliminatedProductions.push_back(pProduction);
 		}
+	}
 
-		// cout << "processed " << t << " productions" << endl;
+	mainGrammar.removeProductions(isEliminated);
 
+	for (unsigned int i = 0; i < eliminatedProductions.size(); i++) {
+		delete eliminatedProductions[i];
 	}
+
+	return counter;
 }
 
 GrammarPruner::~GrammarPruner(void) {
@@ -52,6 +52,17 @@ public:
 #endif
 
 private:
+	/**
+	 * Eliminates the productions of the main grammar whose
+	 * sav-value is too small. All eliminations are decided in a single
+	 * pass from the last production to the first one (i.e., in
+	 * topological order) before any right-hand side is changed.
+	 * Afterwards, the eliminated productions are inlined in the same
+	 * order and removed from the grammar at once.
+	 * @returns the number of eliminated productions
+	 */
+	unsigned int rollBackInefficientReplacements();
+
 	/**
 	 * The grammar containing the start production of the linear
 	 * SLCF tree grammar to generate.
@@ -0,0 +1,245 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "Profiler.h"
+
+#include <fstream>
+#include <time.h>
+
+#if defined(__GNUC__)
+#include <sys/resource.h>
+#include <unistd.h>
+#include <stdio.h>
+#endif
+
+Profiler::Profiler() :
+	phaseRunning(false), phaseWallStart(0), phaseCpuStart(0), phaseRssStart(0)
+{
+	wallStart = getWallTime();
+	cpuStart = getCpuTime();
+}
+
+Profiler * Profiler::getInstance()
+{
+	if (pSingleton == 0)
+	{
+		pSingleton = new Profiler();
+	}
+	return pSingleton;
+}
+
+void Profiler::deleteInstance()
+{
+	delete pSingleton;
+	pSingleton = 0;
+}
+
+void Profiler::startPhase(const char * name)
+{
+	if (phaseRunning)
+	{
+		stopPhase();
+	}
+
+	Phase phase;
+	phase.name = name;
+	phase.wallTimeInMs = 0;
+	phase.cpuTimeInMs = 0;
+	phase.rssDeltaInKb = 0;
+	phases.push_back(phase);
+
+	phaseRunning = true;
+	phaseRssStart = getResidentSetSize();
+	phaseCpuStart = getCpuTime();
+	phaseWallStart = getWallTime();
+}
+
+void Profiler::stopPhase()
+{
+	if (!phaseRunning)
+	{
+		return;
+	}
+
+	Phase & phase = phases.back();
+	phase.wallTimeInMs = getWallTime() - phaseWallStart;
+	phase.cpuTimeInMs = getCpuTime() - phaseCpuStart;
+	phase.rssDeltaInKb = getResidentSetSize() - phaseRssStart;
+
+	phaseRunning = false;
+}
+
+void Profiler::addToCounter(const char * name, unsigned long long value)
+{
+	counterValues[getCounterIndex(name)] += value;
+}
+
+void Profiler::setCounter(const char * name, unsigned long long value)
+{
+	counterValues[getCounterIndex(name)] = value;
+}
+
+unsigned long long Profiler::getCounter(const char * name)
+{
+	for (unsigned int i = 0; i < counterNames.size(); i++)
+	{
+		if (counterNames[i] == name)
+		{
+			return counterValues[i];
+		}
+	}
+	return 0;
+}
+
+double Profiler::getTotalWallTime(const char * pExcludedPhase)
+{
+	stopPhase();
+
+	double wallTime = 0;
+	for (unsigned int i = 0; i < phases.size(); i++)
+	{
+		if (pExcludedPhase == 0 || phases[i].name != pExcludedPhase)
+		{
+			wallTime += phases[i].wallTimeInMs;
+		}
+	}
+	return wallTime;
+}
+
+unsigned int Profiler::getCounterIndex(const char * name)
+{
+	// there are only a handful of counters, a linear search suffices
+	for (unsigned int i = 0; i < counterNames.size(); i++)
+	{
+		if (counterNames[i] == name)
+		{
+			return i;
+		}
+	}
+
+	counterNames.push_back(name);
+	counterValues.push_back(0);
+	return counterNames.size() - 1;
+}
+
+void Profiler::writeJson(ostream & out)
+{
+	stopPhase();
+
+	streamsize oldPrecision = out.precision();
+	ios_base::fmtflags oldFlags = out.flags();
+	out.setf(ios::fixed, ios::floatfield);
+	out.precision(3);
+
+	out << "{" << endl;
+	out << "  \"wall_time_ms\": " << getWallTime() - wallStart << "," << endl;
+	out << "  \"cpu_time_ms\": " << getCpuTime() - cpuStart << "," << endl;
+	out << "  \"peak_rss_kb\": " << getPeakResidentSetSize() << "," << endl;
+
+	out << "  \"phases\": [";
+	for (unsigned int i = 0; i < phases.size(); i++)
+	{
+		out << (i == 0 ? "" : ",") << endl;
+		out << "    { \"name\": \"" << phases[i].name << "\""
+				<< ", \"wall_time_ms\": " << phases[i].wallTimeInMs
+				<< ", \"cpu_time_ms\": " << phases[i].cpuTimeInMs
+				<< ", \"rss_delta_kb\": " << phases[i].rssDeltaInKb << " }";
+	}
+	out << endl << "  ]," << endl;
+
+	out << "  \"counters\": {";
+	for (unsigned int i = 0; i < counterNames.size(); i++)
+	{
+		out << (i == 0 ? "" : ",") << endl;
+		out << "    \"" << counterNames[i] << "\": " << counterValues[i];
+	}
+	out << endl << "  }" << endl;
+	out << "}" << endl;
+
+	out.precision(oldPrecision);
+	out.flags(oldFlags);
+}
+
+void Profiler::writeJsonFile(const char * pFilePath)
+{
+	ofstream fout(pFilePath);
+	if (!fout.is_open())
+	{
+		cout << "Could not open profile file " << pFilePath << "." << endl;
+		return;
+	}
+	writeJson(fout);
+	fout.close();
+}
+
+double Profiler::getWallTime()
+{
+#if !defined(__GNUC__)
+	return ((double) clock()) / (CLOCKS_PER_SEC / 1000);
+#else
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+#endif
+}
+
+double Profiler::getCpuTime()
+{
+#if !defined(__GNUC__)
+	return ((double) clock()) / (CLOCKS_PER_SEC / 1000);
+#else
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0
+			+ (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+#endif
+}
+
+long long Profiler::getResidentSetSize()
+{
+#if !defined(__GNUC__)
+	return 0;
+#else
+	// the second field of /proc/self/statm is the number of resident pages
+	long long pages = 0, residentPages = 0;
+	FILE * pFile = fopen("/proc/self/statm", "r");
+	if (pFile == 0)
+	{
+		return 0;
+	}
+	if (fscanf(pFile, "%lld %lld", &pages, &residentPages) != 2)
+	{
+		residentPages = 0;
+	}
+	fclose(pFile);
+	return residentPages * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+}
+
+long long Profiler::getPeakResidentSetSize()
+{
+#if !defined(__GNUC__)
+	return 0;
+#else
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+#endif
+}
+
+Profiler * Profiler::pSingleton = 0;
@@ -0,0 +1,177 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+using namespace std;
+
+/**
+ * An instance of this (singleton) class measures the wall time, the
+ * CPU time and the change of the resident set size of the phases
+ * of a run of one of the tools of the TreeRePair distribution. In
+ * addition, it keeps a list of named counters. The collected data
+ * can be written out in JSON format.
+ */
+class Profiler
+{
+public:
+	~Profiler(void) {};
+
+	/**
+	 * Returns the singleton instance of the Profiler class.
+	 */
+	static Profiler * getInstance(void);
+
+	/**
+	 * Deallocates the memory used by the singleton instance
+	 * of the Profiler class.
+	 */
+	static void deleteInstance();
+
+	/**
+	 * Starts the measurement of a new phase. A phase which is
+	 * still running is stopped first.
+	 * @param name the name of the phase
+	 */
+	void startPhase(const char * name);
+
+	/**
+	 * Stops the measurement of the phase currently running.
+	 */
+	void stopPhase();
+
+	/**
+	 * Adds the specified value to the counter with the specified
+	 * name. The counter is created if it does not exist yet.
+	 */
+	void addToCounter(const char * name, unsigned long long value);
+
+	/**
+	 * Sets the counter with the specified name to the specified
+	 * value.
+	 */
+	void setCounter(const char * name, unsigned long long value);
+
+	/**
+	 * Returns the value of the counter with the specified name (0 if
+	 * there is no such counter).
+	 */
+	unsigned long long getCounter(const char * name);
+
+	/**
+	 * Returns the sum of the wall times of all phases measured so far
+	 * in milliseconds.
+	 * @param pExcludedPhase the name of a phase which shall not be
+	 *  taken into account (may be 0)
+	 */
+	double getTotalWallTime(const char * pExcludedPhase = 0);
+
+	/**
+	 * Writes the collected data in JSON format to the specified
+	 * output stream.
+	 */
+	void writeJson(ostream & out);
+
+	/**
+	 * Writes the collected data in JSON format to the specified
+	 * file.
+	 */
+	void writeJsonFile(const char * pFilePath);
+
+private:
+	Profiler(void);
+
+	/**
+	 * The measurements of one phase.
+	 */
+	struct Phase
+	{
+		string name;
+		double wallTimeInMs;
+		double cpuTimeInMs;
+		long long rssDeltaInKb;
+	};
+
+	/**
+	 * Returns the wall clock time in milliseconds.
+	 */
+	static double getWallTime();
+
+	/**
+	 * Returns the CPU time (user and system) consumed by this
+	 * process in milliseconds.
+	 */
+	static double getCpuTime();
+
+	/**
+	 * Returns the current resident set size of this process in KB.
+	 */
+	static long long getResidentSetSize();
+
+	/**
+	 * Returns the peak resident set size of this process in KB.
+	 */
+	static long long getPeakResidentSetSize();
+
+	/**
+	 * Returns the index of the counter with the specified name. The
+	 * counter is created if it does not exist yet.
+	 */
+	unsigned int getCounterIndex(const char * name);
+
+	/**
+	 * The singleton instance of the Profiler class.
+	 */
+	static Profiler * pSingleton;
+
+	/**
+	 * The phases measured so far.
+	 */
+	vector<Phase> phases;
+
+	/**
+	 * The names of the counters.
+	 */
+	vector<string> counterNames;
+
+	/**
+	 * The values of the counters.
+	 */
+	vector<unsigned long long> counterValues;
+
+	/**
+	 * Indicates if a phase is running.
+	 */
+	bool phaseRunning;
+
+	/**
+	 * The wall time, CPU time and resident set size at the start
+	 * of the phase currently running.
+	 */
+	double phaseWallStart, phaseCpuStart;
+	long long phaseRssStart;
+
+	/**
+	 * The wall time and CPU time at the creation of the profiler.
+	 */
+	double wallStart, cpuStart;
+};
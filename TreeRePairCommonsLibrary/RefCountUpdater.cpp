@@ -21,24 +21,16 @@
 #include "Production.h"
 
 RefCountUpdater::RefCountUpdater(Grammar & mainGrammarPar, TreeNode * pNodePar, int addPar)
-: TreeTraversal(pNodePar), mainGrammar(mainGrammarPar), add(addPar)
+: mainGrammar(mainGrammarPar), add(addPar)
 {
-	traverseTree();
+	traverseTree(pNodePar);
 }
 
 RefCountUpdater::~RefCountUpdater() {
 
 }
 
-void RefCountUpdater::processNode(TreeNode * pNode, unsigned int index, int depth, bool closing) {
-
-	if (closing) {
-		return;
-	}
-
-	if (index != UINT_MAX) {
-		pNode = pNode->getChild(index);
-	}
+void RefCountUpdater::preVisit(TreeNode * pNode, unsigned int index, int depth) {
 
 	if (mainGrammar.isNonTerminal(pNode->getSymbol())) {
 		Production * pOtherProduction = mainGrammar.getProductionBySymbol(pNode->getSymbol());
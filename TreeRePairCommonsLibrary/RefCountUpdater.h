@@ -18,7 +18,7 @@
  */
 #pragma once
 
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "Grammar.h"
 #include "TreeNode.h"
 
@@ -27,21 +27,23 @@
  * sets containing the referencing nodes of the productions of the
  * specified grammar.
  */
-class RefCountUpdater : TreeTraversal
+class RefCountUpdater : public StaticTreeTraversal<RefCountUpdater>
 {
+	friend class StaticTreeTraversal<RefCountUpdater>;
+
 public:
 	/**
 	 * The constructor.
 	 * @param mainGrammar the grammar to update
 	 * @param pNode the node which shall be added or removed from the
 	 *  hashed sets of referencing nodes
-	 * @param add (please see the implementation of the processNode method)
+	 * @param add (please see the implementation of the preVisit method)
 	 */
 	RefCountUpdater(Grammar & mainGrammar, TreeNode * pNode, int add);
 	~RefCountUpdater();
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
 	/**
@@ -50,7 +52,7 @@ private:
 	Grammar & mainGrammar;
 
 	/**
-	 * (please see the implementation of the processNode method)
+	 * (please see the implementation of the preVisit method)
 	 */
 	int add;
 };
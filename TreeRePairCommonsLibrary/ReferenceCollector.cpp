@@ -1,42 +1,41 @@
-/*
- * TreeRePair is an implementation of the Re-pair for Trees algorithm.
- *
- * Copyright (C) 2010  Roy Mennicke
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License Version 3 as
- * published by the Free Software Foundation.
- *
- * This program is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU General Public License Version 3 for more details.
- *
- * You should have received a copy of the GNU General Public License
- * along with this program.  If not,
- * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
- */
-#include "TreePrinter.h"
-
-#include <vector>
-
-TreePrinter::TreePrinter(ostream & out, bool rawModePar) :
-	TreeTraversal(0), out(&out), rawMode(rawModePar)
-{
-}
-
-TreePrinter::~TreePrinter(void)
-{
-}
-
-void TreePrinter::printTree(TreeNode * pNode)
-{
-	this->pRoot = pNode;
-
-	traverseTree();
-
-	if (out == &cout)
-	{
-		*out << endl;
-	}
-}
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "ReferenceCollector.h"
+
+ReferenceCollector::ReferenceCollector(Grammar & grammarPar)
+: grammar(grammarPar), pReferences(0)
+{
+}
+
+ReferenceCollector::~ReferenceCollector(void)
+{
+}
+
+void ReferenceCollector::collectReferences(TreeNode * pRoot, vector<TreeNode *> & references) {
+	pReferences = &references;
+	traverseTree(pRoot);
+	pReferences = 0;
+}
+
+void ReferenceCollector::preVisit(TreeNode * pNode, unsigned int index, int depth) {
+
+	if (grammar.isNonTerminal(pNode->getSymbol())) {
+		pReferences->push_back(pNode);
+	}
+}
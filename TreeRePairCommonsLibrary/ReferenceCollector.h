@@ -0,0 +1,66 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "StaticTreeTraversal.h"
+#include "TreeNode.h"
+#include "Grammar.h"
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * This class is used to collect the nodes of a tree which are labeled
+ * by a nonterminal of a given grammar.
+ */
+class ReferenceCollector : public StaticTreeTraversal<ReferenceCollector>
+{
+	friend class StaticTreeTraversal<ReferenceCollector>;
+
+public:
+	/**
+	 * The constructor.
+	 * @param grammar the grammar whose nonterminals shall be collected
+	 */
+	ReferenceCollector(Grammar & grammar);
+	~ReferenceCollector(void);
+
+	/**
+	 * Appends the nodes of the specified tree which are labeled by a
+	 * nonterminal of the grammar (in preorder) to the specified vector.
+	 * @param pRoot the root of the tree to search
+	 * @param references the vector to append the nodes to
+	 */
+	void collectReferences(TreeNode * pRoot, vector<TreeNode *> & references);
+
+protected:
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
+
+private:
+	/**
+	 * The grammar whose nonterminals are collected.
+	 */
+	Grammar & grammar;
+
+	/**
+	 * The vector the nodes found are appended to.
+	 */
+	vector<TreeNode *> * pReferences;
+};
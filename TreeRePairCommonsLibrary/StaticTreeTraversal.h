@@ -0,0 +1,113 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "TreeNode.h"
+#include "TreeRePairMacros.h"
+#include "TreeRePairTypes.h"
+
+/**
+ * This class template is the base class of all classes executing a
+ * preorder traversal of a tree. In contrast to the TreeTraversal class,
+ * the hooks of the subclass are bound at compile time (the subclass
+ * passes itself as template argument), i.e., they can be inlined and
+ * there is no virtual call per node. The traversal follows the parent
+ * pointers of the nodes and therefore does not need a stack.
+ *
+ * A subclass hides those of the following hooks it is interested in:
+ * <ul>
+ * <li>preVisit() is called when a node is visited for the first time
+ *  (i.e., before its children are visited),</li>
+ * <li>postVisit() is called when a node is visited for the second and
+ *  last time (i.e., after its children have been visited),</li>
+ * <li>visitEdge() is called for every edge before descending into
+ *  the child.</li>
+ * </ul>
+ * The parent and the index of a node are determined before postVisit()
+ * is called on it, i.e., postVisit() may delete or replace the node. A
+ * subclass which declares its hooks protected or private has to declare
+ * StaticTreeTraversal<Subclass> a friend.
+ */
+template <class Derived>
+class StaticTreeTraversal
+{
+protected:
+	/**
+	 * Traverses the tree rooted at the specified node. The traversal
+	 * does not leave this tree even if the root has a parent.
+	 * @param pRoot the root of the tree to be traversed
+	 */
+	void traverseTree(TreeNode * pRoot)
+	{
+		Derived * pDerived = static_cast<Derived *>(this);
+		TreeNode * pCurrentNode = pRoot;
+		unsigned int index = 0;
+		int depth = 0;
+
+		pDerived->preVisit(pRoot, UINT_MAX, depth);
+
+		while (true) {
+			if (pCurrentNode->getSymbol()->getRank() > index) {
+				TreeNode * pChild = pCurrentNode->getChild(index);
+				depth++;
+				pDerived->visitEdge(pCurrentNode, index, pChild);
+				pDerived->preVisit(pChild, index, depth);
+				pCurrentNode = pChild;
+				index = 0;
+			} else if (pCurrentNode != pRoot) {
+				TreeNode * pParent = pCurrentNode->getParent();
+				unsigned int childIndex = pCurrentNode->getIndex();
+				pDerived->postVisit(pCurrentNode, childIndex, depth);
+				pCurrentNode = pParent;
+				depth--;
+				index = childIndex + 1;
+			} else {
+				break;
+			}
+		}
+
+		pDerived->postVisit(pRoot, UINT_MAX, depth);
+	}
+
+	/**
+	 * Is called when a node is visited for the first time.
+	 * @param pNode the current node
+	 * @param index the index of the current node (UINT_MAX if it is
+	 *  the root of the traversed tree)
+	 * @param depth the depth of the current node
+	 */
+	void preVisit(TreeNode * pNode, unsigned int index, int depth) {};
+
+	/**
+	 * Is called when a node is visited for the second and last time.
+	 * @param pNode the current node
+	 * @param index the index of the current node (UINT_MAX if it is
+	 *  the root of the traversed tree)
+	 * @param depth the depth of the current node
+	 */
+	void postVisit(TreeNode * pNode, unsigned int index, int depth) {};
+
+	/**
+	 * Is called for every edge before descending into the child.
+	 * @param pParent the parent node
+	 * @param index the index of the child
+	 * @param pChild the child node
+	 */
+	void visitEdge(TreeNode * pParent, unsigned int index, TreeNode * pChild) {};
+};
@@ -59,6 +59,19 @@ Symbol * Symbol::getPlaceholderSymbol() {
 	return pPlaceholderSymbol;
 }
 
+void Symbol::reset() {
+
+	hashMaps.symbolByIdHashMap.clear();
+	hashMaps.symbolsBySicHashMap.clear();
+	hashMaps.terminalSymbols.clear();
+	hashMaps.idElementTypeHashMap.clear();
+
+	pParameterSymbol = 0;
+	pPlaceholderSymbol = 0;
+	pStartSymbol = 0;
+	counter = 0;
+}
+
 string Symbol::getElementTypeById(unsigned int id)
 {
 	HASH_I_S::iterator result = hashMaps.idElementTypeHashMap.find(id);
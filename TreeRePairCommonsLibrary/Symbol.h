@@ -97,6 +97,12 @@ public:
 	 */
 	static Symbol * getStartSymbol();
 
+	/**
+	 * Forgets all symbols so that another grammar can be read. The
+	 * symbols must have been deleted by Helper::deleteSymbols() before.
+	 */
+	static void reset();
+
 	/**
 	 * Returns the element type of a symbol.
 	 * @param id the ID of the symbol
@@ -107,10 +113,13 @@ public:
 	/**
 	 * Returns the symbol with the specified ID.
 	 * @param id the ID of the symbol which shall be returned
-	 * @returns the symbol with the specified ID
+	 * @returns the symbol with the specified ID (0 if there is none)
 	 */
 	static Symbol * getSymbolById(unsigned int id) {
-		return hashMaps.symbolByIdHashMap[id];
+		// operator[] would insert the missing id, which must not happen
+		// while another thread is reading the hash map
+		HASH_U_S::const_iterator result = hashMaps.symbolByIdHashMap.find(id);
+		return result != hashMaps.symbolByIdHashMap.end() ? result->second : 0;
 	}
 
 	/**
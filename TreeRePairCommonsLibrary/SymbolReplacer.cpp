@@ -23,11 +23,12 @@
 #include "Production.h"
 #include "TreeCopier.h"
 #include "RefCountUpdater.h"
+#include "TreeDeleter.h"
 #include "Helper.h"
 
 SymbolReplacer::SymbolReplacer(Grammar & dagGrammarPar,
 		Grammar & mainGrammarPar) :
-	TreeTraversal(0), dagGrammar(dagGrammarPar), mainGrammar(mainGrammarPar)
+	dagGrammar(dagGrammarPar), mainGrammar(mainGrammarPar)
 {
 }
 
@@ -82,8 +83,7 @@ void SymbolReplacer::replaceNonterminal(Production * pProduction) {
 
 	pCurrentProduction = pProduction;
 
-	pRoot = dagGrammar[0]->getRightHandSide();
-	traverseTree();
+	traverseTree(dagGrammar[0]->getRightHandSide());
 	processQueue();
 }
 #else
@@ -93,8 +93,7 @@ void SymbolReplacer::replaceNonterminal(Production * pProduction) {
 
 	if (TreeRePairMode::getInstance()->getAlgMode() == TreeRePairMode::DECOMPRESS) {
 
-		pRoot = dagGrammar[0]->getRightHandSide();
-		traverseTree();
+		traverseTree(dagGrammar[0]->getRightHandSide());
 		processQueue();
 
 	} else { // COMPRESS MODE
@@ -111,20 +110,8 @@ void SymbolReplacer::replaceNonterminal(Production * pProduction) {
 }
 #endif
 
-void SymbolReplacer::processNode(TreeNode * pNode, unsigned int index,
-		int depth, bool closing)
+void SymbolReplacer::preVisit(TreeNode * pNode, unsigned int index, int depth)
 {
-
-	if (closing == true)
-	{
-		return;
-	}
-
-	if (index != UINT_MAX)
-	{
-		pNode = pNode->getChild(index);
-	}
-
 	if (pNode->getSymbol() == pCurrentProduction->getLeftHandSide())
 	{
 		pair<set<TreeNode *>::iterator, bool> ret = occurrencesSet.insert(
@@ -159,22 +146,7 @@ void SymbolReplacer::processQueue()
 		occurrencesQueue.pop_back();
 
 		TreeNode * pUpperNode = replaceTreeNode(pNode);
-
-		// if (pNode->getId() == pRoot->getId())
-		if (pNode->getParent() == 0)
-		{
-			// pRoot = pUpperNode;
-			Production * pProduction = dagGrammar.getProductionByRightHandSide(pNode);
-			if (pProduction != 0) {
-				dagGrammar.updateRightHandSide(pProduction, pUpperNode);
-			} else {
-				pProduction = mainGrammar.getProductionByRightHandSide(pNode);
-				mainGrammar.updateRightHandSide(pProduction, pUpperNode);
-			}
-		} else {
-			TreeNode * pParent = pNode->getParent();
-			pParent->setChild(pNode->getIndex(), pUpperNode);
-		}
+		substituteNode(pNode, pUpperNode);
 
 		delete pNode;
 	}
@@ -187,6 +159,55 @@ void SymbolReplacer::processQueue()
 //	}
 }
 
+void SymbolReplacer::substituteNode(TreeNode * pNode, TreeNode * pNewNode)
+{
+	// if (pNode->getId() == pRoot->getId())
+	if (pNode->getParent() == 0)
+	{
+		// pRoot = pUpperNode;
+		Production * pProduction = dagGrammar.getProductionByRightHandSide(pNode);
+		if (pProduction != 0) {
+			dagGrammar.updateRightHandSide(pProduction, pNewNode);
+		} else {
+			pProduction = mainGrammar.getProductionByRightHandSide(pNode);
+			mainGrammar.updateRightHandSide(pProduction, pNewNode);
+		}
+	} else {
+		TreeNode * pParent = pNode->getParent();
+		pParent->setChild(pNode->getIndex(), pNewNode);
+	}
+}
+
+void SymbolReplacer::inlineProduction(Production * pProduction) {
+
+	pCurrentProduction = pProduction;
+	TreeNode * pRightHandSide = pProduction->getRightHandSide();
+
+	HASH_N * refNodesHashSet = pProduction->getReferencingNodes();
+	if (refNodesHashSet->empty()) {
+		RefCountUpdater updater(mainGrammar, pRightHandSide, 0);
+		mainGrammar.updateRightHandSide(pProduction, 0);
+		TreeDeleter treeDeleter;
+		treeDeleter.deleteTree(pRightHandSide);
+		return;
+	}
+
+	HASH_N::iterator it = refNodesHashSet->begin();
+	TreeNode * pLastNode = *it;
+	for (it++; it != refNodesHashSet->end(); it++) {
+		occurrencesQueue.push_back(*it);
+	}
+
+	processQueue();
+
+	mainGrammar.updateRightHandSide(pProduction, 0);
+	Grammar::applyProduction(pLastNode, pProduction);
+	substituteNode(pLastNode, pRightHandSide);
+
+	delete pLastNode;
+	refNodesHashSet->clear();
+}
+
 TreeNode * SymbolReplacer::replaceTreeNode(TreeNode * pNode)
 {
 	Production * pProduction = pCurrentProduction->copy();
@@ -18,7 +18,7 @@
  */
 #pragma once
 
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "TreeNode.h"
 
 #include <set>
@@ -31,8 +31,10 @@
  * right-hand sides.
  */
 class SymbolReplacer :
-	public TreeTraversal
+	public StaticTreeTraversal<SymbolReplacer>
 {
+	friend class StaticTreeTraversal<SymbolReplacer>;
+
 public:
 	/**
 	 * The constructor.
@@ -59,8 +61,18 @@ public:
 	 */
 	void replaceNonterminal(Production * pProduction);
 
+	/**
+	 * Replaces all referencing nodes of the specified production (see
+	 * Production::getReferencingNodes()) by its right-hand side. Only
+	 * the referencing nodes except one are replaced by copies, the
+	 * remaining one is replaced by the right-hand side itself, whose
+	 * nodes are already registered as referencing nodes. Afterwards, the
+	 * production does not have a right-hand side anymore.
+	 */
+	void inlineProduction(Production * pProduction);
+
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
 	/**
@@ -76,6 +88,12 @@ private:
 	 */
 	void processQueue();
 
+	/**
+	 * Puts the specified new node at the position of the specified
+	 * node in the tree or in the grammar.
+	 */
+	void substituteNode(TreeNode * pNode, TreeNode * pNewNode);
+
 	/**
 	 * The grammar containing the start production of the
 	 * linear SLCF tree grammar.
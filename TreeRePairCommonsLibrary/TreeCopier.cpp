@@ -21,35 +21,17 @@
 #include "Production.h"
 
 TreeCopier::TreeCopier(Grammar * grammarPar, TreeNode * pRootPar) :
-	TreeTraversal(pRootPar), grammar(grammarPar)
+	grammar(grammarPar)
 {
-	traverseTree();
+	traverseTree(pRootPar);
 }
 
 TreeCopier::~TreeCopier(void)
 {
 }
 
-void TreeCopier::processNode(TreeNode * pParent, unsigned int index,
-		int depth, bool closing)
+void TreeCopier::preVisit(TreeNode * pNode, unsigned int index, int depth)
 {
-
-	TreeNode * pNode;
-	if (index != UINT_MAX)
-	{
-		pNode = pParent->getChild(index);
-	}
-	else
-	{
-		pNode = pParent;
-	}
-
-	if (closing)
-	{
-		parents.pop();
-		return;
-	}
-
 	TreeNode * pNewNode = 0;
 
 	if (grammar != 0 && grammar->isNonTerminal(pNode->getSymbol())) {
@@ -69,3 +51,8 @@ void TreeCopier::processNode(TreeNode * pParent, unsigned int index,
 
 	parents.push(pNewNode);
 }
+
+void TreeCopier::postVisit(TreeNode * pNode, unsigned int index, int depth)
+{
+	parents.pop();
+}
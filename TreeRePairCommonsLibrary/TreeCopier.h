@@ -18,7 +18,7 @@
  */
 #pragma once
 
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "Grammar.h"
 
 #include <stack>
@@ -26,8 +26,10 @@
 /**
  * This class creates a deep copy of a tree.
  */
-class TreeCopier : TreeTraversal
+class TreeCopier : public StaticTreeTraversal<TreeCopier>
 {
+	friend class StaticTreeTraversal<TreeCopier>;
+
 public:
 	/**
 	 * The constructor.
@@ -46,7 +48,8 @@ public:
 	TreeNode * getNewRoot() { return pNewRoot; };
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
+	void postVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
 	/**
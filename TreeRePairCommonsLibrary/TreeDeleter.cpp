@@ -18,7 +18,7 @@
  */
 #include "TreeDeleter.h"
 
-TreeDeleter::TreeDeleter(void) : TreeTraversal(0)
+TreeDeleter::TreeDeleter(void)
 {
 }
 
@@ -28,22 +28,11 @@ TreeDeleter::~TreeDeleter(void)
 
 void TreeDeleter::deleteTree(TreeNode * pRootPar) {
 
-	this->pRoot = pRootPar;
-	traverseTree();
+	traverseTree(pRootPar);
 }
 
 
-void TreeDeleter::processNode(TreeNode * pParent, unsigned int index, int depth, bool closing) {
+void TreeDeleter::postVisit(TreeNode * pNode, unsigned int index, int depth) {
 
-	TreeNode * pNode;
-	if (index != UINT_MAX) {
-		pNode = pParent->getChild(index);
-	} else {
-		pNode = pParent;
-	}
-
-
-	if (closing) {
-		delete pNode;
-	}
+	delete pNode;
 }
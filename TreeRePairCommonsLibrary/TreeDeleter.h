@@ -18,7 +18,7 @@
  */
 #pragma once
 
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "TreeNode.h"
 #include "TreeRePairMacros.h"
 
@@ -26,8 +26,10 @@
  * This class is used to deallocate the memory used by a tree.
  */
 class TreeDeleter :
-	public TreeTraversal
+	public StaticTreeTraversal<TreeDeleter>
 {
+	friend class StaticTreeTraversal<TreeDeleter>;
+
 public:
 	TreeDeleter(void);
 	~TreeDeleter(void);
@@ -39,5 +41,5 @@ public:
 	void deleteTree(TreeNode * pRoot);
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void postVisit(TreeNode * pNode, unsigned int index, int depth);
 };
@@ -22,9 +22,21 @@
 #include "Production.h"
 #include "TreeRePairConstants.h"
 #include "Helper.h"
+#include "BinaryTreeConstructor.h"
 
 #define NUM_SYMBOLS 3
 
+/**
+ * The maximal number of nodes of a subtree which may be copied by the
+ * SyntheticTreeGenerator.
+ */
+#define SYNTHETIC_MAX_TEMPLATE_NODES 64
+
+/**
+ * The maximal number of subtrees remembered by the SyntheticTreeGenerator.
+ */
+#define SYNTHETIC_MAX_TEMPLATES 32
+
 TreeGenerator::TreeGenerator(Grammar & dagGrammarPar) : dagGrammar(dagGrammarPar)
 {
 }
@@ -166,3 +178,154 @@ TreeNode * BinaryTreeGenerator2::createBinaryTreeAux(unsigned int curDepth, unsi
 
 	}
 }
+
+/**
+ * Generates the elements of a synthetic tree and reports them to a
+ * content handler (see SyntheticTreeGenerator::generate()).
+ */
+class SyntheticTreeBuilder
+{
+public:
+	SyntheticTreeBuilder(const SyntheticTreeParameters & parametersPar,
+			XmlContentHandler & handlerPar) :
+		parameters(parametersPar), handler(handlerPar), nodeCount(0)
+	{
+		// xorshift does not work with a state of 0
+		state = parameters.seed != 0 ? parameters.seed : 1;
+
+		unsigned int vocabularySize = max(parameters.vocabularySize, 1u);
+		for (unsigned int i = 0; i < vocabularySize; i++) {
+			names.push_back("e" + Helper::stringify((size_t) i));
+		}
+	}
+
+	unsigned int build()
+	{
+		string rootName = "root";
+		handler.startElement(rootName);
+		nodeCount++;
+
+		while (nodeCount < parameters.numberOfNodes) {
+			generateSubtree(1, 0);
+		}
+
+		handler.endElement(rootName);
+		handler.endDocument();
+
+		return nodeCount;
+	}
+
+private:
+	/**
+	 * Returns the next pseudo random number (xorshift32).
+	 */
+	unsigned int nextRandom()
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	/**
+	 * Returns a pseudo random number in the range [0, 1).
+	 */
+	double nextDouble()
+	{
+		return (nextRandom() >> 8) / 16777216.0;
+	}
+
+	/**
+	 * Generates a subtree whose root has the specified depth. The
+	 * elements are appended to the specified record (if not 0). A label
+	 * is encoded by its index, a closing tag by -1.
+	 */
+	void generateSubtree(unsigned int depth, vector<int> * pRecord)
+	{
+		if (!templates.empty() && nextDouble() < parameters.repetitiveness) {
+			vector<int> & tree = templates[nextRandom() % templates.size()];
+			replay(tree);
+			if (pRecord != 0) {
+				pRecord->insert(pRecord->end(), tree.begin(), tree.end());
+			}
+			return;
+		}
+
+		vector<int> record;
+
+		int label = nextRandom() % names.size();
+		handler.startElement(names[label]);
+		record.push_back(label);
+		nodeCount++;
+
+		if (depth < parameters.maxDepth) {
+			unsigned int numberOfChildren = nextRandom() % (parameters.fanOut + 1);
+			for (unsigned int i = 0; i < numberOfChildren
+					&& nodeCount < parameters.numberOfNodes; i++) {
+				generateSubtree(depth + 1, &record);
+			}
+		}
+
+		handler.endElement(names[label]);
+		record.push_back(-1);
+
+		unsigned int size = record.size() / 2;
+		if (size >= 3 && size <= SYNTHETIC_MAX_TEMPLATE_NODES) {
+			if (templates.size() < SYNTHETIC_MAX_TEMPLATES) {
+				templates.push_back(record);
+			} else {
+				templates[nextRandom() % templates.size()] = record;
+			}
+		}
+
+		if (pRecord != 0) {
+			pRecord->insert(pRecord->end(), record.begin(), record.end());
+		}
+	}
+
+	/**
+	 * Reports the elements of a previously generated subtree once again.
+	 */
+	void replay(const vector<int> & tree)
+	{
+		vector<int> labels;
+		for (unsigned int i = 0; i < tree.size(); i++) {
+			if (tree[i] >= 0) {
+				handler.startElement(names[tree[i]]);
+				labels.push_back(tree[i]);
+				nodeCount++;
+			} else {
+				handler.endElement(names[labels.back()]);
+				labels.pop_back();
+			}
+		}
+	}
+
+	const SyntheticTreeParameters & parameters;
+
+	XmlContentHandler & handler;
+
+	vector<string> names;
+
+	vector<vector<int> > templates;
+
+	unsigned int nodeCount;
+
+	unsigned int state;
+};
+
+SyntheticTreeGenerator::SyntheticTreeGenerator(Grammar & dagGrammarPar,
+		const SyntheticTreeParameters & parameters) :
+	TreeGenerator(dagGrammarPar)
+{
+	BinaryTreeConstructor treeConstructor(dagGrammar);
+	nodeCount = generate(parameters, treeConstructor);
+}
+
+unsigned int SyntheticTreeGenerator::generate(
+		const SyntheticTreeParameters & parameters,
+		XmlContentHandler & handler)
+{
+	SyntheticTreeBuilder builder(parameters, handler);
+	return builder.build();
+}
@@ -20,10 +20,12 @@
 
 #include "Grammar.h"
 #include "TreeNode.h"
+#include "XmlContentHandler.h"
 
 class Symbol;
 
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -161,3 +163,87 @@ private:
 	 */
 	unsigned int counter;
 };
+
+/**
+ * The parameters of a tree generated by the SyntheticTreeGenerator.
+ */
+struct SyntheticTreeParameters
+{
+	SyntheticTreeParameters() :
+		numberOfNodes(100000), maxDepth(6), fanOut(8), vocabularySize(32),
+		repetitiveness(0.5), seed(1) {};
+
+	/**
+	 * The number of nodes of the tree to generate (it may be exceeded
+	 * by the size of the last subtree generated).
+	 */
+	unsigned int numberOfNodes;
+
+	/**
+	 * The maximal depth of the tree to generate.
+	 */
+	unsigned int maxDepth;
+
+	/**
+	 * The maximal number of children of a node (except the root).
+	 */
+	unsigned int fanOut;
+
+	/**
+	 * The number of different element names.
+	 */
+	unsigned int vocabularySize;
+
+	/**
+	 * The probability (between 0 and 1) that a subtree is a copy of a
+	 * previously generated subtree instead of a random one.
+	 */
+	double repetitiveness;
+
+	/**
+	 * The seed of the pseudo random number generator. The same
+	 * parameters always lead to the same tree.
+	 */
+	unsigned int seed;
+};
+
+/**
+ * A tree generator generating XML document trees of controllable size,
+ * depth, fan-out, vocabulary size and repetitiveness. The root has as many
+ * children as needed to reach the requested number of nodes. The tree is
+ * constructed in the same way as by the XMLTreeParser, i.e., the binary
+ * representation of the XML document tree is constructed as a DAG.
+ */
+class SyntheticTreeGenerator : public TreeGenerator
+{
+public:
+	/**
+	 * The constructor.
+	 * @param dagGrammar the grammar which serves as a container for the
+	 *  tree
+	 * @param parameters the parameters of the tree to generate
+	 */
+	SyntheticTreeGenerator(Grammar & dagGrammar,
+			const SyntheticTreeParameters & parameters);
+	~SyntheticTreeGenerator() {};
+
+	/**
+	 * Returns the number of nodes of the generated tree.
+	 */
+	unsigned int getNodeCount() const { return nodeCount; };
+
+	/**
+	 * Generates the tree specified by the parameters and reports its
+	 * elements to the specified content handler (like an XMLParser
+	 * would do).
+	 * @returns the number of nodes generated
+	 */
+	static unsigned int generate(const SyntheticTreeParameters & parameters,
+			XmlContentHandler & handler);
+
+private:
+	/**
+	 * The number of nodes of the generated tree.
+	 */
+	unsigned int nodeCount;
+};
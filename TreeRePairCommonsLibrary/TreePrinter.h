@@ -18,15 +18,18 @@
  */
 #pragma once
 
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "Grammar.h"
 #include "TreeRePairTypes.h"
 
 /**
- * The base class for all tree printers.
+ * The base class for all tree printers. A tree printer passes itself
+ * as template argument and implements the preVisit() and postVisit()
+ * hooks of the StaticTreeTraversal class.
  */
+template <class Derived>
 class TreePrinter :
-	public TreeTraversal
+	public StaticTreeTraversal<Derived>
 {
 public:
 	/**
@@ -35,18 +38,25 @@ public:
 	 * @param rawMode specifies if the printer shall work in
 	 *  raw mode (implementation of this mode is printer dependend)
 	 */
-	TreePrinter(ostream & out = cout, bool rawMode = true);
-	~TreePrinter(void);
+	TreePrinter(ostream & out = cout, bool rawMode = true) :
+		out(&out), rawMode(rawMode) {};
+	~TreePrinter(void) {};
 
 	/**
 	 * Initiate the printing of the tree.
 	 * @param pNode the root of the tree to be printed
 	 */
-	void printTree(TreeNode * pNode);
+	void printTree(TreeNode * pNode)
+	{
+		this->traverseTree(pNode);
 
-protected:
-	virtual void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing) = 0;
+		if (out == &cout)
+		{
+			*out << endl;
+		}
+	};
 
+protected:
 	/**
 	 * The output stream to use.
 	 */
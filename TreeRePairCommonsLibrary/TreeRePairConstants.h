@@ -34,3 +34,13 @@
 #define RLC_MAX_RUN_LENGTH 3
 
 #define COL_SEP 1
+
+#define TRACE_BUFFER_SIZE 65536
+#define BIT_WRITER_BUFFER_SIZE 65536
+#define BIT_READER_BUFFER_SIZE 65536
+#define XML_WRITER_BUFFER_SIZE 65536
+#define DECOMPRESSION_JOBS_PER_THREAD 16
+#define MIN_DECOMPRESSION_JOB_SIZE 16384
+#define ASYNC_OUTPUT_BUFFER_SIZE 1048576
+#define START_PRODUCTION_QUEUE_SIZE 65536
+#define HUFFMAN_LOOKUP_BITS 10
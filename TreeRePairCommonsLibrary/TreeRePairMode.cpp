@@ -33,11 +33,20 @@ TreeRePairMode::TreeRePairMode()
 	useDag = true;
 	binaryStatistics = false;
 	showStatistics = false;
+	formatOutput = false;
+	numberOfThreads = 1;
+	rangeSet = false;
+	rangeStart = 0;
+	rangeCount = 0;
+	pSelectedPath = 0;
 
 	algMode = COMPRESS;
 	optimizationMode = OPTIMIZE_FILE_SIZE;
 
 	maxRank = MAX_RANK;
+
+	pProfileFilePath = 0;
+	pTraceFilePath = 0;
 }
 
 TreeRePairMode * TreeRePairMode::getInstance()
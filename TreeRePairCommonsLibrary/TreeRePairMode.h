@@ -221,6 +221,42 @@ public:
 	 */
 	bool isShowStatistics() { return showStatistics; };
 
+	/**
+	 * Indicates whether the decompressed XML document shall be written
+	 * with a line break after every tag.
+	 */
+	bool isFormatOutput() { return formatOutput; };
+
+	/**
+	 * Returns the number of threads writing the decompressed XML
+	 * document.
+	 */
+	unsigned int getNumberOfThreads() { return numberOfThreads; };
+
+	/**
+	 * Indicates whether only a range of elements (given by their
+	 * preorder numbers) of the decompressed XML document shall be
+	 * written.
+	 */
+	bool isRangeSet() { return rangeSet; };
+
+	/**
+	 * Returns the preorder number of the first element to write.
+	 */
+	unsigned long long getRangeStart() { return rangeStart; };
+
+	/**
+	 * Returns the number of elements to write.
+	 */
+	unsigned long long getRangeCount() { return rangeCount; };
+
+	/**
+	 * Returns the path of the element whose subtree shall be written
+	 * instead of the whole decompressed XML document (0 if the whole
+	 * document shall be written).
+	 */
+	const char * getSelectedPath() { return pSelectedPath; };
+
 	/**
 	 * Returns either COMPRESS or DECOMPRESS.
 	 */
@@ -237,6 +273,18 @@ public:
 	 */
 	unsigned int getMaxRank() { return maxRank; };
 
+	/**
+	 * Returns the file to which the profile of the run shall be
+	 * written (0 if profiling is disabled).
+	 */
+	const char * getProfileFilePath() { return pProfileFilePath; };
+
+	/**
+	 * Returns the file to which the trace of the digram replacement
+	 * loop shall be written (0 if tracing is disabled).
+	 */
+	const char * getTraceFilePath() { return pTraceFilePath; };
+
 	/**
 	 * Enables or disables the verbose mode.
 	 */
@@ -278,6 +326,32 @@ public:
 	 */
 	void setShowStatistics(bool showStatisticsPar) { showStatistics = showStatisticsPar; };
 
+	/**
+	 * Enables or disables the line breaks after every tag of the
+	 * decompressed XML document.
+	 */
+	void setFormatOutput(bool formatOutputPar) { formatOutput = formatOutputPar; };
+
+	/**
+	 * Sets the number of threads writing the decompressed XML document.
+	 */
+	void setNumberOfThreads(unsigned int numberOfThreadsPar) { numberOfThreads = numberOfThreadsPar; };
+
+	/**
+	 * Sets the range of elements of the decompressed XML document to
+	 * write.
+	 */
+	void setRange(unsigned long long start, unsigned long long count) {
+		rangeStart = start;
+		rangeCount = count;
+		rangeSet = true;
+	};
+
+	/**
+	 * Sets the path of the element whose subtree shall be written.
+	 */
+	void setSelectedPath(const char * pPath) { pSelectedPath = pPath; };
+
 	/**
 	 * Sets the algorithm mode (either COMPRESS or DECOMPRESS).
 	 */
@@ -300,6 +374,17 @@ public:
 		maxRankSet = true;
 	};
 
+	/**
+	 * Sets the file to which the profile of the run shall be written.
+	 */
+	void setProfileFilePath(const char * pFilePath) { pProfileFilePath = pFilePath; };
+
+	/**
+	 * Sets the file to which the trace of the digram replacement loop
+	 * shall be written.
+	 */
+	void setTraceFilePath(const char * pFilePath) { pTraceFilePath = pFilePath; };
+
 private:
 	TreeRePairMode(void);
 
@@ -341,6 +426,32 @@ private:
 	 */
 	bool showStatistics;
 
+	/**
+	 * Indicates whether the decompressed XML document shall be written
+	 * with a line break after every tag.
+	 */
+	bool formatOutput;
+
+	/**
+	 * The number of threads writing the decompressed XML document.
+	 */
+	unsigned int numberOfThreads;
+
+	/**
+	 * Indicates if only a range of elements of the decompressed XML
+	 * document shall be written, the preorder number of the first of
+	 * them and their number.
+	 */
+	bool rangeSet;
+	unsigned long long rangeStart;
+	unsigned long long rangeCount;
+
+	/**
+	 * The path of the element whose subtree shall be written (0 if the
+	 * whole document shall be written).
+	 */
+	const char * pSelectedPath;
+
 	/**
 	 * Indicates if we are told to show progress information
 	 * during a run of our algorithm.
@@ -375,4 +486,15 @@ private:
 	 * The maximal rank allowed for a nonterminal.
 	 */
 	unsigned int maxRank;
+
+	/**
+	 * The file to which the profile of the run shall be written.
+	 */
+	const char * pProfileFilePath;
+
+	/**
+	 * The file to which the trace of the digram replacement loop shall
+	 * be written.
+	 */
+	const char * pTraceFilePath;
 };
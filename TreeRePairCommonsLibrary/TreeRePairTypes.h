@@ -33,7 +33,6 @@ class Digram;
 class Symbol;
 class TreeNode;
 class ProductionTreeContainer;
-class HuffmanTreeNode;
 class ProductionReference;
 class Production;
 struct NodeHasher;
@@ -52,7 +51,6 @@ typedef boost::unordered_set<TreeNode*, NodeHasher, NodeEqualityTester> HASH_N;
 typedef boost::unordered_set<unsigned int> HASH_U;
 typedef boost::unordered_map<unsigned int, Production *> HASH_I_P;
 typedef boost::unordered_map<unsigned int, unsigned int> HASH_I_I;
-typedef boost::unordered_map<unsigned int, HuffmanTreeNode*> HASH_S_H;
 typedef boost::unordered_map<int, string> HASH_I_S;
 typedef boost::unordered_map<unsigned int, Symbol*> HASH_U_S;
 typedef boost::unordered_map<string, vector<Symbol*> * > HASH_ST_VS;
@@ -24,7 +24,8 @@
 
 /**
  * This class is the base class of all classes executing a preorder
- * traversal of a tree.
+ * traversal of a tree. The traversals of the TreeRePair distribution
+ * use the statically dispatched StaticTreeTraversal class instead.
  */
 class TreeTraversal
 {
@@ -23,27 +23,15 @@
 
 UniversalTreeTraverser::UniversalTreeTraverser(
 		Grammar * pGrammarPar, TreeNode * pRootPar) :
-	TreeTraversal(pRootPar), pGrammar(pGrammarPar) {
+	pGrammar(pGrammarPar) {
 
-	traverseTree();
+	traverseTree(pRootPar);
 }
 
 UniversalTreeTraverser::~UniversalTreeTraverser() {
 }
 
-void UniversalTreeTraverser::processNode(TreeNode * pParent, unsigned int index,
-		int depth, bool closing) {
-
-	TreeNode * pNode;
-	if (index != UINT_MAX) {
-		pNode = pParent->getChild(index);
-	} else {
-		pNode = pParent;
-	}
-
-	if (closing) {
-		return;
-	}
+void UniversalTreeTraverser::preVisit(TreeNode * pNode, unsigned int index, int depth) {
 
 	if (pGrammar != 0 && pGrammar->isNonTerminal(pNode->getSymbol())) {
 		Production * pProduction = pGrammar->getProductionBySymbol(pNode->getSymbol());
@@ -18,7 +18,7 @@
  */
 #pragma once
 
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "TreeNode.h"
 #include "TreeRePairMacros.h"
 #include "Grammar.h"
@@ -27,17 +27,19 @@
  * This class is used for testing purposes only. It traverses
  * a tree and can execute custom actions.
  */
-class UniversalTreeTraverser : public TreeTraversal
+class UniversalTreeTraverser : public StaticTreeTraversal<UniversalTreeTraverser>
 {
+	friend class StaticTreeTraversal<UniversalTreeTraverser>;
+
 public:
 	/**
 	 * The constructor of the class.
 	 */
 	UniversalTreeTraverser(Grammar * pGrammar, TreeNode * pRoot);
-	virtual ~UniversalTreeTraverser(void);
+	~UniversalTreeTraverser(void);
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
 	/**
@@ -0,0 +1,95 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "XmlSerializer.h"
+
+#include <cstdlib>
+#include <string>
+
+XmlSerializer::XmlSerializer(ostream & out, bool useFormatting) :
+	pOut(&out), pTarget(0)
+{
+	init(useFormatting);
+}
+
+XmlSerializer::XmlSerializer(string & target, bool useFormatting) :
+	pOut(0), pTarget(&target)
+{
+	init(useFormatting);
+}
+
+void XmlSerializer::init(bool useFormatting)
+{
+	lineBreakLength = useFormatting ? 1 : 0;
+	buffer.resize(XML_WRITER_BUFFER_SIZE);
+	bufferPos = 0;
+
+	tagInfos.resize(Symbol::counter);
+	for (unsigned int i = 0; i < tagInfos.size(); i++) {
+		tagInfos[i].offset = NO_TAGS;
+	}
+}
+
+XmlSerializer::~XmlSerializer(void)
+{
+	flushBuffer();
+}
+
+void XmlSerializer::flush()
+{
+	flushBuffer();
+	if (pOut != 0) {
+		pOut->flush();
+	}
+}
+
+void XmlSerializer::computeTags(unsigned int id)
+{
+	if (id >= tagInfos.size()) {
+		TagInfo noTags = { NO_TAGS, 0 };
+		tagInfos.resize(id + 1, noTags);
+	}
+
+	string name = Symbol::getElementTypeById(id);
+	string lineBreak = lineBreakLength > 0 ? "\n" : "";
+	string tags = "<" + name + ">" + lineBreak
+			+ "<" + name + " />" + lineBreak
+			+ "</" + name + ">" + lineBreak;
+
+	if (tags.size() > buffer.size()) {
+		cout << "Fatal error: The element type " << name
+				<< " is too long to be written. Exiting ..." << endl;
+		exit(1);
+	}
+
+	tagInfos[id].offset = tagBytes.size();
+	tagInfos[id].nameLength = name.size();
+	tagBytes.insert(tagBytes.end(), tags.begin(), tags.end());
+}
+
+void XmlSerializer::flushBuffer()
+{
+	if (bufferPos > 0) {
+		if (pOut != 0) {
+			pOut->write(&buffer[0], bufferPos);
+		} else {
+			pTarget->append(&buffer[0], bufferPos);
+		}
+		bufferPos = 0;
+	}
+}
@@ -0,0 +1,157 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "Symbol.h"
+#include "TreeRePairConstants.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Writes the tags of terminal symbols to an output stream. The opening,
+ * empty-element and closing tags of a terminal are computed once and
+ * stored next to each other in a contiguous table. Writing a tag copies
+ * its bytes from this table to a large output buffer which is handed to
+ * the output stream (or appended to a string) whenever it is full.
+ */
+class XmlSerializer
+{
+public:
+	/**
+	 * The constructor.
+	 * @param out the output stream to write to
+	 * @param useFormatting specifies if every tag shall be followed by
+	 *  a line break
+	 */
+	XmlSerializer(ostream & out, bool useFormatting = false);
+
+	/**
+	 * Constructs a serializer which appends the tags to a string.
+	 * @param target the string to append to
+	 * @param useFormatting specifies if every tag shall be followed by
+	 *  a line break
+	 */
+	XmlSerializer(string & target, bool useFormatting = false);
+
+	/**
+	 * The destructor flushes the output buffer.
+	 */
+	~XmlSerializer(void);
+
+	void writeOpeningTag(Symbol * pSymbol) {
+		const TagInfo & info = getTagInfo(pSymbol->getId());
+		append(&tagBytes[info.offset], info.nameLength + 2 + lineBreakLength);
+	};
+
+	void writeEmptyTag(Symbol * pSymbol) {
+		const TagInfo & info = getTagInfo(pSymbol->getId());
+		append(&tagBytes[info.offset + info.nameLength + 2 + lineBreakLength],
+				info.nameLength + 4 + lineBreakLength);
+	};
+
+	void writeClosingTag(Symbol * pSymbol) {
+		const TagInfo & info = getTagInfo(pSymbol->getId());
+		append(&tagBytes[info.offset + 2 * info.nameLength + 6 + 2 * lineBreakLength],
+				info.nameLength + 3 + lineBreakLength);
+	};
+
+	/**
+	 * Hands the content of the output buffer to the output stream (or
+	 * the target string).
+	 */
+	void flush();
+
+private:
+	/**
+	 * The position of the tags of a symbol in the tag table. The
+	 * opening tag, the empty-element tag and the closing tag are
+	 * stored one after the other.
+	 */
+	struct TagInfo
+	{
+		unsigned int offset;
+		unsigned int nameLength;
+	};
+
+	/**
+	 * Indicates that the tags of a symbol were not computed yet.
+	 */
+	static const unsigned int NO_TAGS = 0xFFFFFFFF;
+
+	const TagInfo & getTagInfo(unsigned int id) {
+		if (id >= tagInfos.size() || tagInfos[id].offset == NO_TAGS) {
+			computeTags(id);
+		}
+		return tagInfos[id];
+	};
+
+	/**
+	 * Appends the tags of the symbol with the specified id to the
+	 * tag table.
+	 */
+	void computeTags(unsigned int id);
+
+	void append(const char * pBytes, size_t length) {
+		if (bufferPos + length > buffer.size()) {
+			flushBuffer();
+		}
+		memcpy(&buffer[bufferPos], pBytes, length);
+		bufferPos += length;
+	};
+
+	void flushBuffer();
+
+	/**
+	 * Initializes the tag table and the output buffer.
+	 */
+	void init(bool useFormatting);
+
+	/**
+	 * The output stream or the string to write to (exactly one of
+	 * them is not 0).
+	 */
+	ostream * pOut;
+	string * pTarget;
+
+	/**
+	 * The length of the line break following every tag (0 or 1).
+	 */
+	unsigned int lineBreakLength;
+
+	/**
+	 * The tags of all symbols seen so far.
+	 */
+	vector<char> tagBytes;
+
+	/**
+	 * The positions of the tags in the tag table by symbol id.
+	 */
+	vector<TagInfo> tagInfos;
+
+	/**
+	 * The output buffer and the number of bytes used.
+	 */
+	vector<char> buffer;
+	size_t bufferPos;
+};
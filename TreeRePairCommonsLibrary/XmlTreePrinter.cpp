@@ -22,13 +22,14 @@
 #include "TreeRePairConstants.h"
 #include "TreeRePairTypes.h"
 #include "Helper.h"
+#include "XmlSerializer.h"
 
 #include <iostream>
 
 using namespace std;
 
 XmlTreePrinter::XmlTreePrinter(ostream & out) :
-	TreePrinter(out), useFormatting(false), convert(false)
+	TreePrinter(out), useFormatting(false), convert(false), pSerializer(0)
 {
 }
 
@@ -43,35 +44,39 @@ void XmlTreePrinter::printTree(TreeNode * pRoot, bool useFormatting, bool conver
 	bool tempUseFormatting = this->useFormatting;
 	this->useFormatting = useFormatting;
 
-	TreePrinter::printTree(pRoot);
+	if (convert) {
+		XmlSerializer serializer(*out, useFormatting);
+		pSerializer = &serializer;
+		TreePrinter::printTree(pRoot);
+		pSerializer = 0;
+	} else {
+		TreePrinter::printTree(pRoot);
+	}
 
 	this->useFormatting = tempUseFormatting;
 }
 
-void XmlTreePrinter::processNode(TreeNode * pParent, unsigned int index,
-		int depth, bool closing)
+void XmlTreePrinter::preVisit(TreeNode * pNode, unsigned int index, int depth)
 {
 	if (convert) {
-		return processNodeConvert(pParent, index, depth, closing);
+		processNodeConvert(pNode, index, depth, false);
 	} else {
-		return processNodeDontConvert(pParent, index, depth, closing);
+		processNodeDontConvert(pNode, index, depth, false);
 	}
 }
 
-void XmlTreePrinter::processNodeDontConvert(TreeNode * pParent, unsigned int index,
-		int depth, bool closing)
+void XmlTreePrinter::postVisit(TreeNode * pNode, unsigned int index, int depth)
 {
-
-	TreeNode * pNode;
-	if (index != UINT_MAX)
-	{
-		pNode = pParent->getChild(index);
-	}
-	else
-	{
-		pNode = pParent;
+	if (convert) {
+		processNodeConvert(pNode, index, depth, true);
+	} else {
+		processNodeDontConvert(pNode, index, depth, true);
 	}
+}
 
+void XmlTreePrinter::processNodeDontConvert(TreeNode * pNode, unsigned int index,
+		int depth, bool closing)
+{
 	std::string blank = "";
 	if (useFormatting)
 	{
@@ -109,54 +114,45 @@ void XmlTreePrinter::processNodeDontConvert(TreeNode * pParent, unsigned int ind
 //#endif
 }
 
-void XmlTreePrinter::processNodeConvert(TreeNode * pParent, unsigned int index,
+void XmlTreePrinter::processNodeConvert(TreeNode * pNode, unsigned int index,
 		int depth, bool closing)
 {
-	std::string blank = "";
-//	if (useFormatting)
-//	{
-//		blank = Helper::getBlankCharacters(depth);
-//	}
-	string endLine = Helper::getEndLine(useFormatting);
+	Symbol * pSymbol = pNode->getSymbol();
 
-	TreeNode * pNode;
 	if (index != UINT_MAX)
 	{
-		pNode = pParent->getChild(index);
-
-		string name = Symbol::getElementTypeById(pNode->getSymbol()->getId());
 		if (!closing) {
 			if (isRightChild(pNode) && pNode->getParent()->getSymbol()->hasLeftChild()) {
-				*out << blank << "</"
-					<< Symbol::getElementTypeById(pNode->getParent()->getSymbol()->getId())
-					<< ">" << endLine;
+				pSerializer->writeClosingTag(pNode->getParent()->getSymbol());
 			}
 
-			if (pNode->getSymbol()->hasLeftChild()) {
-				*out << blank << "<" << name << ">" << endLine;
+			if (pSymbol->hasLeftChild()) {
+				pSerializer->writeOpeningTag(pSymbol);
 			} else {
-				*out << blank << "<" << name << " />" << endLine;
+				pSerializer->writeEmptyTag(pSymbol);
 			}
 		} else { // closing
-			if (pNode->getSymbol()->hasLeftChild() && !pNode->getSymbol()->hasRightChild()) {
-				*out << blank << "</" << name << ">" << endLine;
+			if (pSymbol->hasLeftChild() && !pSymbol->hasRightChild()) {
+				pSerializer->writeClosingTag(pSymbol);
 			}
 
 		}
 	}
 	else
 	{
-		string name = Symbol::getElementTypeById(pParent->getSymbol()->getId());
 		if (!closing) {
-			if (pParent->getSymbol()->hasLeftChild()) {
-				*out << blank << "<" << name << ">" << endLine;
+			if (pSymbol->hasLeftChild()) {
+				pSerializer->writeOpeningTag(pSymbol);
 			} else {
-				*out << blank << "<" << name << " />" << endLine;
+				pSerializer->writeEmptyTag(pSymbol);
 			};
 		} else {
-			if (pParent->getSymbol()->hasLeftChild()) {
-				*out << blank << "</" << name << ">" << endLine;
+			if (pSymbol->hasLeftChild()) {
+				pSerializer->writeClosingTag(pSymbol);
 			}
+			// the root is done, the tree printer may write to the
+			// output stream itself now
+			pSerializer->flush();
 		}
 	}
 
@@ -23,12 +23,16 @@
 
 #include <sstream>
 
+class XmlSerializer;
+
 /**
  * Implements a XML tree printer, i.e., a given tree is transformed
  * into a XML document.
  */
-class XmlTreePrinter : public TreePrinter
+class XmlTreePrinter : public TreePrinter<XmlTreePrinter>
 {
+	friend class StaticTreeTraversal<XmlTreePrinter>;
+
 public:
 	/**
 	 * The constructor.
@@ -49,7 +53,8 @@ public:
 	void printTree(TreeNode * pRoot, bool useFormatting, bool convert);
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
+	void postVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
 	/**
@@ -60,7 +65,8 @@ private:
 
 	/**
 	 * Used to print the tree when converting from a binary
-	 * representation of a unranked tree.
+	 * representation of a unranked tree. The tags are written
+	 * by XmlTreePrinter::pSerializer.
 	 */
 	void processNodeConvert(TreeNode * pNode, unsigned int index, int depth, bool closing);
 
@@ -89,4 +95,9 @@ private:
 	 * tree is written to the output file).
 	 */
 	bool convert;
+
+	/**
+	 * The serializer used while converting the tree.
+	 */
+	XmlSerializer * pSerializer;
 };
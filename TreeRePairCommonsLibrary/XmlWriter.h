@@ -0,0 +1,68 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "XmlContentHandler.h"
+
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+/**
+ * This class writes the events emitted by a SAX-like parser (or by a
+ * tree generator) as XML document to an output stream. An element
+ * without children is written as empty-element tag.
+ */
+class XmlWriter : public XmlContentHandler
+{
+public:
+	/**
+	 * The constructor.
+	 * @param out the output stream to write the XML document to
+	 */
+	XmlWriter(ostream & out);
+	virtual ~XmlWriter();
+
+	void startElement(string & name);
+	void endElement(string & name);
+	void endDocument();
+
+private:
+	/**
+	 * Writes the start-tag which is still pending.
+	 */
+	void writePendingStartTag();
+
+	/**
+	 * The output stream to write to.
+	 */
+	ostream & out;
+
+	/**
+	 * The element type of the last start-tag. It is written as soon
+	 * as we know whether the element has children.
+	 */
+	string pendingName;
+
+	/**
+	 * Indicates if there is a start-tag which was not written yet.
+	 */
+	bool startTagPending;
+};
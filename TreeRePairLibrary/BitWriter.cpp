@@ -18,8 +18,12 @@
  */
 #include "BitWriter.h"
 
+#include "TreeRePairConstants.h"
+
 BitWriter::BitWriter(ofstream & foutPar, bool unencodedPar) :
-	fout(foutPar), buf(0x00), pos(7), unencoded(unencodedPar)
+	fout(foutPar), accumulator(0), accumulatorBits(0), buffer(
+			BIT_WRITER_BUFFER_SIZE), bufferPos(0), empty(true), unencoded(
+			unencodedPar)
 {
 }
 
@@ -27,33 +31,119 @@ BitWriter::~BitWriter()
 {
 }
 
-void BitWriter::writeBitString(const string str)
+void BitWriter::writeBits(uint64_t value, unsigned int n)
 {
 	if (unencoded)
 	{
-		fout << "[" << str << "]";
+		fout << "[";
+		for (int i = n - 1; i >= 0; i--)
+		{
+			fout << (((value >> i) & 1) ? '1' : '0');
+		}
+		fout << "]";
+		return;
+	}
+
+	if (n == 0)
+	{
+		return;
+	}
+
+	empty = false;
+
+	if (n < 64)
+	{
+		value &= (((uint64_t) 1) << n) - 1;
+	}
+
+	unsigned int freeBits = 64 - accumulatorBits;
+	if (n < freeBits)
+	{
+		accumulator = (accumulator << n) | value;
+		accumulatorBits += n;
+		return;
+	}
+
+	// the accumulator is full, the remaining bits are kept
+	unsigned int remainingBits = n - freeBits;
+	if (accumulatorBits > 0)
+	{
+		accumulator = (accumulator << freeBits) | (value >> remainingBits);
 	}
 	else
 	{
-		for (unsigned int i = 0; i < str.size(); i++)
+		accumulator = value;
+	}
+	writeWord(accumulator);
+
+	accumulatorBits = remainingBits;
+	accumulator = remainingBits == 0 ? 0 : value
+			& ((((uint64_t) 1) << remainingBits) - 1);
+}
+
+void BitWriter::writeBitString(const string & str)
+{
+	if (unencoded)
+	{
+		fout << "[" << str << "]";
+		return;
+	}
+
+	uint64_t value = 0;
+	unsigned int n = 0;
+	for (unsigned int i = 0; i < str.size(); i++)
+	{
+		value = (value << 1) | (str[i] == '1' ? 1 : 0);
+		if (++n == 64)
 		{
-			if (pos < 0)
-			{
-				fout.write(&buf, 1);
-				buf = 0x00;
-				pos = 7;
-			}
-
-			if (str.at(i) == '1')
-			{
-				buf |= (0x01 << pos);
-			}
-			pos--;
+			writeBits(value, n);
+			value = 0;
+			n = 0;
 		}
 	}
+	writeBits(value, n);
+}
+
+void BitWriter::writeWord(uint64_t word)
+{
+	if (bufferPos + 8 > buffer.size())
+	{
+		flushOutputBuffer();
+	}
+
+	for (int shift = 56; shift >= 0; shift -= 8)
+	{
+		buffer[bufferPos++] = (char) (word >> shift);
+	}
+}
+
+void BitWriter::flushOutputBuffer()
+{
+	fout.write(&buffer[0], bufferPos);
+	bufferPos = 0;
 }
 
 void BitWriter::flushBuffer()
 {
-	fout.write(&buf, 1);
+	// pad the last byte with zero bits
+	unsigned int padding = (8 - accumulatorBits % 8) % 8;
+	if (empty)
+	{
+		padding = 8;
+	}
+	if (padding > 0)
+	{
+		accumulator <<= padding;
+		accumulatorBits += padding;
+	}
+
+	flushOutputBuffer();
+	for (int shift = (int) accumulatorBits - 8; shift >= 0; shift -= 8)
+	{
+		char byte = (char) (accumulator >> shift);
+		fout.write(&byte, 1);
+	}
+
+	accumulator = 0;
+	accumulatorBits = 0;
 }
@@ -20,11 +20,16 @@
 
 #include <fstream>
 #include <string>
+#include <vector>
+#include <stdint.h>
 
 using namespace std;
 
 /**
- * This class writes bitwise to an input stream.
+ * This class writes bitwise to an output stream. The bits are collected
+ * in a 64-bit accumulator (most significant bit first) which is moved
+ * to a large output buffer whenever it is full. The output buffer is
+ * written to the output stream in one go.
  */
 class BitWriter
 {
@@ -32,44 +37,81 @@ public:
 	/**
 	 * The constructor of the class.
 	 * @param fout the output stream to write to
-	 * @param unencoded If true, the strings supplied are directly
-	 *  written to the file (i.e., they are not regarded as bit strings).
+	 * @param unencoded If true, the bits supplied are directly
+	 *  written to the file as a string of '0' and '1' characters.
 	 *  This option is used for debugging purposes only.
 	 */
 	BitWriter(ofstream & fout, bool unencoded);
 	virtual ~BitWriter();
 
 	/**
-	 * Writes the specified bits to the output stream.
+	 * Writes the n least significant bits of the specified value to the
+	 * output stream, beginning with the most significant one of them.
+	 * @param value the bits to write
+	 * @param n the number of bits to write (at most 64)
 	 */
-	void writeBitString(const string str);
+	void writeBits(uint64_t value, unsigned int n);
+
+	/**
+	 * Writes the specified bits to the output stream. This is a
+	 * convenience wrapper around BitWriter::writeBits().
+	 * @param str a string consisting of '0' and '1' characters
+	 */
+	void writeBitString(const string & str);
 
 	/**
 	 * Flushes the buffer. This method needs to be called before
-	 * destruction of the BitWriter instance.
+	 * destruction of the BitWriter instance. The last byte is padded
+	 * with zero bits. If no bits were written at all, a single zero
+	 * byte is written.
 	 */
 	void flushBuffer();
 
 private:
+	/**
+	 * Appends the specified 64 bits to the output buffer.
+	 */
+	void writeWord(uint64_t word);
+
+	/**
+	 * Writes the content of the output buffer to the output stream.
+	 */
+	void flushOutputBuffer();
+
 	/**
 	 * The output stream to write to.
 	 */
 	ofstream & fout;
 
 	/**
-	 * This 1 byte large buffer is used to write the bits to
-	 * the output stream.
+	 * Collects the bits which were not moved to the output buffer yet.
+	 * They are kept in the accumulatorBits least significant bits.
+	 */
+	uint64_t accumulator;
+
+	/**
+	 * The number of bits in the accumulator (always less than 64).
+	 */
+	unsigned int accumulatorBits;
+
+	/**
+	 * The output buffer.
+	 */
+	vector<char> buffer;
+
+	/**
+	 * The number of bytes in the output buffer.
 	 */
-	char buf;
+	unsigned int bufferPos;
 
 	/**
-	 * The current position within the buffer.
+	 * Indicates whether any bits were written so far.
 	 */
-	int pos;
+	bool empty;
 
 	/**
-	 * If true, the strings supplied are directly
-	 * written to the file (i.e., they are not regarded as bit strings).
+	 * If true, the bits supplied are directly written to the file as a
+	 * string of '0' and '1' characters.
 	 * This option is used for debugging purposes only.
 	 */
 	bool unencoded;
@@ -27,9 +27,9 @@ BplexTreePrinter::BplexTreePrinter(Grammar & dagGrammarPar,
 		Grammar & mainGrammarPar, TreeNode * pRootPar,
 		ostream & outPar) :
 	dagGrammar(dagGrammarPar), mainGrammar(mainGrammarPar),
-	pRoot(pRootPar), out(outPar) {
+	out(outPar) {
 
-	traverseTree();
+	traverseTree(pRootPar);
 
 	if (out.rdbuf() == cout.rdbuf()) {
 		out << endl;
@@ -39,14 +39,21 @@ BplexTreePrinter::BplexTreePrinter(Grammar & dagGrammarPar,
 BplexTreePrinter::~BplexTreePrinter() {
 }
 
-void BplexTreePrinter::processNode(TreeNode * pParent, unsigned int index,
-		int depth, bool closing) {
+void BplexTreePrinter::preVisit(TreeNode * pNode, unsigned int index, int depth) {
+	printNode(pNode, index, false);
+}
+
+void BplexTreePrinter::postVisit(TreeNode * pNode, unsigned int index, int depth) {
+	printNode(pNode, index, true);
+}
+
+void BplexTreePrinter::printNode(TreeNode * pNode, unsigned int index, bool closing) {
 
-	TreeNode * pNode;
+	TreeNode * pParent;
 	if (index != UINT_MAX) {
-		pNode = pParent->getChild(index);
+		pParent = pNode->getParent();
 	} else {
-		pNode = pParent;
+		pParent = pNode;
 	}
 
 	Symbol * pSymbol = pNode->getSymbol();
@@ -97,35 +104,3 @@ void BplexTreePrinter::processNode(TreeNode * pParent, unsigned int index,
 		}
 	}
 }
-
-// traverse: root, then children from left to right
-void BplexTreePrinter::traverseTree() {
-	TreeNode * pCurrentNode = pRoot;
-	unsigned int index = 0;
-	int depth = 0;
-
-	processNode(pCurrentNode, UINT_MAX, depth, false);
-	depth++;
-
-	while (true) {
-		if (pCurrentNode->getSymbol()->getRank() > index) {
-			processNode(pCurrentNode, index, depth, false);
-			pCurrentNode = pCurrentNode->getChild(index);
-			depth++;
-			index = 0;
-		} else {
-			if (pCurrentNode->getParent() != 0) {
-				index = pCurrentNode->getIndex() + 1;
-				TreeNode * pTemp = pCurrentNode;
-				pCurrentNode = pCurrentNode->getParent();
-				depth--;
-				processNode(pCurrentNode, pTemp->getIndex(), depth, true);
-			} else {
-				break;
-			}
-		}
-	}
-
-	depth--;
-	processNode(pCurrentNode, UINT_MAX, depth, true);
-}
@@ -20,12 +20,15 @@
 
 #include "TreeRePairMacros.h"
 #include "TreeNode.h"
+#include "StaticTreeTraversal.h"
 
 /**
  * Prints the right-hand side of a production of a linear SLCF tree
  * grammar in BPLEX-like format.
  */
-class BplexTreePrinter {
+class BplexTreePrinter : public StaticTreeTraversal<BplexTreePrinter> {
+	friend class StaticTreeTraversal<BplexTreePrinter>;
+
 public:
 	/**
 	 * The constructor.
@@ -39,25 +42,22 @@ public:
 			TreeNode * pRoot, ostream & out = cout);
 	~BplexTreePrinter(void);
 
-private:
-	/**
-	 * Initiates the printing process.
-	 */
-	void traverseTree(void);
+protected:
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
+	void postVisit(TreeNode * pNode, unsigned int index, int depth);
 
+private:
 	/**
-	 * This method is called twice for each node of the tree during a
-	 * preorder traversal of it. It must be implemented by the super classes.
+	 * Prints the opening (or closing) part of the specified node.
 	 * @param pNode the current node
-	 * @param index the index of the current node
-	 * @param depth the depth of the current node
+	 * @param index the index of the current node (UINT_MAX if it
+	 *  is the root of the printed tree)
 	 * @param closing indicates if the current node is visited on the
 	 *  way down to the leafs of the tree (i.e., it is visited for the first
 	 *  time) or if it is visited after its children have been visited
 	 *  (thats the second and last time it is visited)
 	 */
-	void processNode(TreeNode * pNode, unsigned int index, int depth,
-			bool closing);
+	void printNode(TreeNode * pNode, unsigned int index, bool closing);
 
 	/**
 	 * The grammar containing the start production of generated linear SLCF tree
@@ -71,11 +71,6 @@ private:
 	 */
 	Grammar & mainGrammar;
 
-	/**
-	 * The root of the tree to print.
-	 */
-	TreeNode * pRoot;
-
 	/**
 	 * The output stream used to write to the output file.
 	 */
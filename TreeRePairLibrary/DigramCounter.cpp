@@ -27,21 +27,21 @@
 
 DigramCounter::DigramCounter(Grammar & dagGrammarPar,
 		HASH_D_D * pDigramHashMapPar, DigramPriorityQueue * pPriorityQueuePar) :
-	TreeTraversal(0), pDigramHashMap(pDigramHashMapPar), pPriorityQueue(
-			pPriorityQueuePar), dagGrammar(dagGrammarPar) {
+	pDigramHashMap(pDigramHashMapPar), pPriorityQueue(
+			pPriorityQueuePar), dagGrammar(dagGrammarPar),
+			numberOfCreatedDigrams(0), numberOfRegistrations(0),
+			numberOfDeregistrations(0) {
 
 	for (unsigned int i = 0; i < dagGrammar.size(); i++) {
 		pProduction = dagGrammar[i];
-		pRoot = pProduction->getRightHandSide();
-		traverseTree();
+		traverseTree(pProduction->getRightHandSide());
 	}
 }
 
 DigramCounter::~DigramCounter(void) {
 }
 
-void DigramCounter::processNode(TreeNode * pNode, unsigned int index, int depth,
-		bool closing) {
+void DigramCounter::postVisit(TreeNode * pNode, unsigned int index, int depth) {
 
 	unsigned int transitiveRefCount = pProduction->getTransitiveRefCount();
 
@@ -53,19 +53,17 @@ void DigramCounter::processNode(TreeNode * pNode, unsigned int index, int depth,
 #endif
 
 	// we traverse the tree in postorder
-	if (!closing) {
-		return;
-	}
-
-	pNode->setTransitiveRefCount(transitiveRefCount);
-
 	if (index == UINT_MAX) {
+		pNode->setTransitiveRefCount(transitiveRefCount);
 		return;
 	}
 
-	registerOccurrence(pNode, index);
+	TreeNode * pParent = pNode->getParent();
+	pParent->setTransitiveRefCount(transitiveRefCount);
+
+	registerOccurrence(pParent, index);
 
-	TreeNode * pChildNode = pNode->getChild(index);
+	TreeNode * pChildNode = pNode;
 	pChildNode->setTransitiveRefCount(transitiveRefCount);
 
 //	if (dagGrammar.isNonTerminal(pChildNode->getSymbol())) {
@@ -155,9 +153,11 @@ void DigramCounter::registerOccurrence(TreeNode * pNode, unsigned int childIndex
 		}
 	} else { // not found
 		(*pDigramHashMap)[pDigram] = pDigram;
+		numberOfCreatedDigrams++;
 	}
 
 	pPriorityQueue->incrementQuantity(pDigram, refCount);
+	numberOfRegistrations++;
 }
 
 bool DigramCounter::isNonOverlapping(TreeNode * pNode, unsigned int index) {
@@ -201,14 +201,17 @@ void DigramCounter::deregisterOccurrence(TreeNode * pNode, unsigned int index,
 
 		Digram * pDigram = Helper::getDigram(pDigramHashMap, dagGrammar, pNode, index);
 
+		updateOccurrencesList(pDigram, pNode);
+
+		// the digram is deleted if its quantity drops to zero, so its
+		// occurrences list has to be updated first
 		if (pDigram != pSkipDigram) {
 			pPriorityQueue->decrementQuantity(pDigram, pNode->getTransitiveRefCount());
 		}
 
-		updateOccurrencesList(pDigram, pNode);
-
 		pNode->setNextDigramOccurrence(index, 0);
 		pNode->setPreviousDigramOccurrence(index, 0);
+		numberOfDeregistrations++;
 	} else {
 #ifdef DEBUG
 		if (pNode->getPreviousDigramOccurrence(index) != 0 || pNode->getNextDigramOccurrence(index)
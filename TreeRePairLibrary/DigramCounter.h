@@ -18,7 +18,7 @@
  */
 #pragma once
 
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "TreeNode.h"
 #include "DigramPriorityQueue.h"
 #include "Grammar.h"
@@ -30,7 +30,9 @@
  * digram. It allows occurrences to be added and removed from the
  * sets occ_t.
  */
-class DigramCounter: public TreeTraversal {
+class DigramCounter: public StaticTreeTraversal<DigramCounter> {
+	friend class StaticTreeTraversal<DigramCounter>;
+
 public:
 	/**
 	 * The constructor of the class. It initiates the initial construction
@@ -75,9 +77,26 @@ public:
 	 */
 	void deregisterOccurrence(TreeNode * pNode, unsigned int index, Digram * pSkipDigram);
 
+	/**
+	 * Returns the number of Digram instances which were added to the
+	 * digram hash map so far.
+	 */
+	unsigned int getNumberOfCreatedDigrams() { return numberOfCreatedDigrams; };
+
+	/**
+	 * Returns the number of occurrences which were added to the
+	 * sets occ_t so far.
+	 */
+	unsigned int getNumberOfRegistrations() { return numberOfRegistrations; };
+
+	/**
+	 * Returns the number of occurrences which were removed from the
+	 * sets occ_t so far.
+	 */
+	unsigned int getNumberOfDeregistrations() { return numberOfDeregistrations; };
+
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth,
-				bool closing);
+	void postVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
 	/**
@@ -115,4 +134,19 @@ private:
 	 * counter in order to register the occurrences of the occurring digrams.
 	 */
 	Production * pProduction;
+
+	/**
+	 * The number of Digram instances added to the digram hash map.
+	 */
+	unsigned int numberOfCreatedDigrams;
+
+	/**
+	 * The number of occurrences added to the sets occ_t.
+	 */
+	unsigned int numberOfRegistrations;
+
+	/**
+	 * The number of occurrences removed from the sets occ_t.
+	 */
+	unsigned int numberOfDeregistrations;
 };
@@ -24,6 +24,8 @@
 #include "TreeDeleter.h"
 #include "UniversalTreeTraverser.h"
 #include "Production.h"
+#include "Profiler.h"
+#include "ReplacementTracer.h"
 
 #include <sstream>
 #include <iostream>
@@ -35,7 +37,8 @@ DigramReplacer::DigramReplacer(DigramPriorityQueue * pPriorityQueue,
 		Grammar & dagGrammar, Grammar & mainGrammar) :
 	pPriorityQueue(pPriorityQueue), pDigramCounter(pDigramCounter),
 					pDigramHashMap(pDigramHashMap), dagGrammar(dagGrammar),
-					mainGrammar(mainGrammar), counter(1) {
+					mainGrammar(mainGrammar), counter(1),
+					numberOfReplacements(0) {
 
 	replaceDigrams();
 }
@@ -48,6 +51,14 @@ void DigramReplacer::replaceDigrams()
 	Symbol * pSymbol = 0;
 	Production * pProduction = 0;
 
+	ReplacementTracer * pTracer = 0;
+	if (TreeRePairMode::getInstance()->getTraceFilePath() != 0)
+	{
+		pTracer = new ReplacementTracer(
+				TreeRePairMode::getInstance()->getTraceFilePath());
+		pTracer->start();
+	}
+
 	Digram * pCurrentDigram = pPriorityQueue->top();
 
 	unsigned int lastQuantity = 0;
@@ -75,6 +86,9 @@ void DigramReplacer::replaceDigrams()
 	while (pCurrentDigram != 0) {
 
 		lastQuantity = pCurrentDigram->getNumberOfOccs();
+		unsigned int scanLength = pPriorityQueue->getLastScanLength();
+		unsigned int registrations = pDigramCounter->getNumberOfRegistrations();
+		unsigned int deregistrations = pDigramCounter->getNumberOfDeregistrations();
 
 		if (pSymbol == 0) {
 			pSymbol = createNewNonterminal(pCurrentDigram);
@@ -104,6 +118,15 @@ void DigramReplacer::replaceDigrams()
 
 		pProduction = replaceDigramOccurrences(pCurrentDigram, pSymbol, counter);
 
+		if (pTracer != 0)
+		{
+			pTracer->recordIteration(pCurrentDigram, lastQuantity,
+					numberOfReplacements,
+					pDigramCounter->getNumberOfDeregistrations() - deregistrations,
+					pDigramCounter->getNumberOfRegistrations() - registrations,
+					scanLength);
+		}
+
 		if (pProduction != 0)
 		{
 			mainGrammar.addProduction(pProduction);
@@ -116,6 +139,8 @@ void DigramReplacer::replaceDigrams()
 
 		pCurrentDigram = pPriorityQueue->top();
 	}
+
+	delete pTracer;
 }
 
 Production* DigramReplacer::replaceDigramOccurrences(Digram * pDigram, Symbol * pNonterminal,
@@ -129,10 +154,12 @@ Production* DigramReplacer::replaceDigramOccurrences(Digram * pDigram, Symbol *
 	Production * pProduction = Production::createProduction(pNonterminal, pDigram);
 
 	unsigned int counter = 0;
+	numberOfReplacements = 0;
 
 	while (pOccurrence != 0)
 	{
 		counter += pOccurrence->getTransitiveRefCount();
+		numberOfReplacements++;
 
 #ifdef DEBUG
 		Helper::isValidOccurrence(dagGrammar, pOccurrence, pDigram, counter);
@@ -177,6 +204,9 @@ Production* DigramReplacer::replaceDigramOccurrences(Digram * pDigram, Symbol *
 		cout << endl;
 	}
 
+	Profiler::getInstance()->addToCounter("occurrences_replaced",
+			numberOfReplacements);
+
 	return pProduction;
 }
 
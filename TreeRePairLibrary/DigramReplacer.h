@@ -171,4 +171,10 @@ private:
 	 * Keeps track of how many digrams where replaced so far.
 	 */
 	int counter;
+
+	/**
+	 * The number of occurrences replaced by the last call of
+	 * replaceDigramOccurrences().
+	 */
+	unsigned int numberOfReplacements;
 };
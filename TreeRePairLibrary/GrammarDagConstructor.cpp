@@ -0,0 +1,419 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "GrammarDagConstructor.h"
+
+#include "BinaryTreeConstructor.h"
+#include "EdgeCounter.h"
+#include "Production.h"
+#include "TreeRePairMode.h"
+
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+
+const unsigned int GrammarDagConstructor::EMPTY_TREE;
+const unsigned int GrammarDagConstructor::MINIMAL_MEMOIZED_SIZE;
+const unsigned int GrammarDagConstructor::MAXIMAL_GROWTH;
+const unsigned int GrammarDagConstructor::MINIMAL_WARNING_SIZE;
+
+GrammarDagConstructor::GrammarDagConstructor(Grammar & inputDagGrammar,
+		Grammar & inputMainGrammar, Grammar & dagGrammarPar) :
+	index(checkStartProduction(inputDagGrammar), inputMainGrammar),
+	dagGrammar(dagGrammarPar), nodeCount(0), inputSize(0), warningSize(0)
+{
+	binarySymbols.assign(4 * Symbol::counter, 0);
+
+	// every right-hand side has one node more than edges
+	EdgeCounter edgeCounter;
+	edgeCounter.countEdges(inputDagGrammar);
+	edgeCounter.countEdges(inputMainGrammar);
+	inputSize = edgeCounter.getNumberOfEdges() + index.size();
+	warningSize = max(inputSize * MAXIMAL_GROWTH,
+			(unsigned long long) MINIMAL_WARNING_SIZE);
+
+	initializeMemoization();
+	unsigned int root = evaluate();
+	if (root == EMPTY_TREE) {
+		cout << "Fatal error: The input grammar represents an empty tree. "
+			"Exiting ..." << endl;
+		exit(1);
+	}
+
+	// the hash maps are not needed anymore
+	ClassMap().swap(classes);
+	NumberMap().swap(sequences);
+	NumberMap().swap(applications);
+
+	construct(root);
+}
+
+GrammarDagConstructor::~GrammarDagConstructor(void)
+{
+}
+
+Grammar & GrammarDagConstructor::checkStartProduction(Grammar & inputDagGrammar)
+{
+	if (inputDagGrammar.size() == 0) {
+		cout << "Fatal error: The input grammar has no start production. "
+			"Exiting ..." << endl;
+		exit(1);
+	}
+	return inputDagGrammar;
+}
+
+void GrammarDagConstructor::initializeMemoization()
+{
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+	Symbol * pPlaceholderSymbol = Symbol::getPlaceholderSymbol();
+
+	// bottom-up: the numbers of nodes generated by the productions (not
+	// counting the arguments) are only needed up to MINIMAL_MEMOIZED_SIZE
+	const vector<unsigned int> & order = index.getOrder();
+	vector<unsigned int> sizes(index.size(), 0);
+	memoized.assign(index.size(), false);
+	vector<TreeNode *> nodes;
+
+	for (unsigned int i = order.size(); i > 0; i--) {
+		unsigned int production = order[i - 1];
+		unsigned int size = 0;
+
+		nodes.push_back(index.getRightHandSide(production));
+		while (!nodes.empty() && size < MINIMAL_MEMOIZED_SIZE) {
+			TreeNode * pNode = nodes.back();
+			nodes.pop_back();
+
+			Symbol * pSymbol = pNode->getSymbol();
+			unsigned int referenced = index.getProduction(pSymbol);
+			if (referenced != GrammarIndex::NO_PRODUCTION) {
+				size += sizes[referenced];
+			} else if (pSymbol != pParameterSymbol
+					&& pSymbol != pPlaceholderSymbol) {
+				size++;
+			}
+
+			for (unsigned int j = 0; j < pNode->getCurrentChildrenCount(); j++) {
+				nodes.push_back(pNode->getChild(j));
+			}
+		}
+		nodes.clear();
+
+		sizes[production] = min(size, MINIMAL_MEMOIZED_SIZE);
+		memoized[production] = size >= MINIMAL_MEMOIZED_SIZE;
+	}
+}
+
+unsigned int GrammarDagConstructor::evaluate()
+{
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+	Symbol * pPlaceholderSymbol = Symbol::getPlaceholderSymbol();
+
+	vector<PendingApplication> pending;
+	vector<unsigned int> arguments;
+	vector<pair<TreeNode *, bool> > nodes;
+	vector<unsigned int> values;
+
+	PendingApplication start = { index.getStartProduction(), 0, 0, 0, 0 };
+	pending.push_back(start);
+	nodes.push_back(make_pair(index.getRightHandSide(start.production), false));
+
+	unsigned int root = EMPTY_TREE;
+
+	while (!pending.empty()) {
+		PendingApplication & application = pending.back();
+
+		// the class of the application is known as soon as all nodes
+		// of the right-hand side were visited
+		if (nodes.size() == application.firstNode) {
+			unsigned int rank = arguments.size() - application.firstArgument;
+			if (application.nextArgument != rank
+					|| values.size() != application.firstClass + 1) {
+				cout << "Fatal error: The number of parameters of a production "
+					"does not match its rank. Exiting ..." << endl;
+				exit(1);
+			}
+
+			unsigned int result = values.back();
+			values.pop_back();
+			if (memoized[application.production]) {
+				applications[getApplicationKey(application.production,
+						rank > 0 ? &arguments[application.firstArgument] : 0,
+						rank)] = result;
+			}
+
+			arguments.resize(application.firstArgument);
+			pending.pop_back();
+			if (pending.empty()) {
+				root = result;
+			} else {
+				values.push_back(result);
+			}
+			continue;
+		}
+
+		TreeNode * pNode = nodes.back().first;
+		bool childrenVisited = nodes.back().second;
+		nodes.pop_back();
+
+		Symbol * pSymbol = pNode->getSymbol();
+		unsigned int childrenCount = pNode->getCurrentChildrenCount();
+
+		if (!childrenVisited) {
+			if (pSymbol == pParameterSymbol) {
+				if (application.firstArgument + application.nextArgument
+						>= arguments.size()) {
+					cout << "Fatal error: The number of parameters of a "
+						"production does not match its rank. Exiting ..." << endl;
+					exit(1);
+				}
+				values.push_back(arguments[application.firstArgument
+						+ application.nextArgument++]);
+			} else if (pSymbol == pPlaceholderSymbol) {
+				values.push_back(EMPTY_TREE);
+			} else {
+				// the children are visited from left to right
+				nodes.push_back(make_pair(pNode, true));
+				for (unsigned int i = childrenCount; i > 0; i--) {
+					nodes.push_back(make_pair(pNode->getChild(i - 1), false));
+				}
+			}
+			continue;
+		}
+
+		unsigned int firstChild = values.size() - childrenCount;
+		const unsigned int * children = childrenCount > 0 ? &values[firstChild] : 0;
+		unsigned int production = index.getProduction(pSymbol);
+
+		if (production == GrammarIndex::NO_PRODUCTION) {
+			unsigned int result = getClass(pSymbol, children, childrenCount);
+			values.resize(firstChild);
+			values.push_back(result);
+			continue;
+		}
+
+		if (pSymbol->getRank() != childrenCount) {
+			cout << "Fatal error: The rank of a nonterminal does not match "
+				"its number of children. Exiting ..." << endl;
+			exit(1);
+		}
+
+		if (memoized[production]) {
+			NumberMap::iterator it = applications.find(
+					getApplicationKey(production, children, childrenCount));
+			if (it != applications.end()) {
+				values.resize(firstChild);
+				values.push_back(it->second);
+				continue;
+			}
+		}
+
+		// the argument classes are moved from the stack of the values to
+		// the stack of the arguments
+		PendingApplication called;
+		called.production = production;
+		called.firstArgument = arguments.size();
+		called.nextArgument = 0;
+		called.firstNode = nodes.size();
+		called.firstClass = firstChild;
+		arguments.insert(arguments.end(), values.begin() + firstChild,
+				values.end());
+		values.resize(firstChild);
+		nodes.push_back(make_pair(index.getRightHandSide(production), false));
+
+		// the reference to the application becomes invalid here
+		pending.push_back(called);
+	}
+
+	return root;
+}
+
+unsigned long long GrammarDagConstructor::getApplicationKey(
+		unsigned int production, const unsigned int * arguments,
+		unsigned int rank)
+{
+	unsigned int sequence = EMPTY_TREE;
+	if (rank == 1) {
+		sequence = arguments[0];
+	} else {
+		for (unsigned int i = 0; i < rank; i++) {
+			pair<NumberMap::iterator, bool> result = sequences.insert(make_pair(
+					((unsigned long long) sequence << 32) | arguments[i],
+					(unsigned int) sequences.size()));
+			sequence = result.first->second;
+		}
+	}
+
+	return ((unsigned long long) production << 32) | sequence;
+}
+
+unsigned int GrammarDagConstructor::getClass(Symbol * pSymbol,
+		const unsigned int * children, unsigned int childrenCount)
+{
+	if (pSymbol->getRank() != childrenCount) {
+		cout << "Fatal error: The rank of a terminal symbol does not match "
+			"its number of children. Exiting ..." << endl;
+		exit(1);
+	}
+
+	unsigned int left = EMPTY_TREE;
+	unsigned int right = EMPTY_TREE;
+	if (pSymbol->hasLeftChild()) {
+		left = children[0];
+	}
+	if (pSymbol->hasRightChild()) {
+		right = children[childrenCount - 1];
+	}
+
+	unsigned int characteristic = (left != EMPTY_TREE ? 2 : 0)
+			+ (right != EMPTY_TREE ? 1 : 0);
+	Symbol *& pBinarySymbol = binarySymbols[4 * pSymbol->getId() + characteristic];
+	if (pBinarySymbol == 0) {
+		if (pSymbol->hasLeftChild() == (left != EMPTY_TREE)
+				&& pSymbol->hasRightChild() == (right != EMPTY_TREE)) {
+			pBinarySymbol = pSymbol;
+		} else {
+			pBinarySymbol = BinaryTreeConstructor::retrieveSymbol(
+					Symbol::getElementTypeById(pSymbol->getId()),
+					left != EMPTY_TREE, right != EMPTY_TREE);
+		}
+	}
+
+	pair<unsigned int, unsigned long long> classKey(pBinarySymbol->getId(),
+			((unsigned long long) left << 32) | right);
+	pair<ClassMap::iterator, bool> result = classes.insert(make_pair(classKey, (unsigned int) classSymbols.size()));
+
+	if (result.second) {
+		classSymbols.push_back(pBinarySymbol);
+		leftClasses.push_back(left);
+		rightClasses.push_back(right);
+
+		if (classSymbols.size() == warningSize) {
+			cout << "Warning: The binary DAG of the tree represented by the "
+					"input grammar (" << inputSize << " nodes) has more than "
+					<< warningSize << " nodes. Recompressing the grammar is not "
+					"cheaper than compressing the XML document." << endl;
+		}
+	}
+
+	return result.first->second;
+}
+
+void GrammarDagConstructor::construct(unsigned int root)
+{
+	unsigned int size = classSymbols.size();
+
+	// top-down: the children of a class have smaller numbers
+	vector<unsigned long long> occurrences(size, 0);
+	vector<unsigned int> inDegrees(size, 0);
+	occurrences[root] = 1;
+
+	unsigned long long numberOfNodes = 0;
+	for (unsigned int i = size; i > 0; i--) {
+		unsigned int current = i - 1;
+		if (occurrences[current] == 0) {
+			continue;
+		}
+
+		numberOfNodes += occurrences[current];
+		if (numberOfNodes > 0xFFFFFFFFULL) {
+			cout << "Fatal error: The tree represented by the input grammar "
+				"has too many nodes. Exiting ..." << endl;
+			exit(1);
+		}
+
+		if (leftClasses[current] != EMPTY_TREE) {
+			occurrences[leftClasses[current]] += occurrences[current];
+			inDegrees[leftClasses[current]]++;
+		}
+		if (rightClasses[current] != EMPTY_TREE) {
+			occurrences[rightClasses[current]] += occurrences[current];
+			inDegrees[rightClasses[current]]++;
+		}
+	}
+	nodeCount = numberOfNodes;
+
+	// the subtrees occurring more than once become DAG productions like
+	// in TreeConstructor::shareTree(), the productions of the children
+	// are created first
+	bool useDag = TreeRePairMode::getInstance()->isUseDag();
+	vector<Production *> productions(size, (Production *) 0);
+	vector<Production *> dagProductions;
+
+	if (useDag) {
+		for (unsigned int current = 0; current < size; current++) {
+			if (occurrences[current] == 0 || inDegrees[current] < 2) {
+				continue;
+			}
+
+			Symbol * pSymbol = new Symbol();
+			pSymbol->setRank(0);
+
+			Production * pProduction = new Production(pSymbol,
+					createTree(current, productions));
+			pProduction->setTransitiveRefCount(occurrences[current]);
+			productions[current] = pProduction;
+			dagProductions.push_back(pProduction);
+		}
+	}
+
+	Production * pStartProduction = new Production(Symbol::getStartSymbol(),
+			createTree(root, productions));
+	pStartProduction->incrementRefCount();
+	pStartProduction->incrementTransitiveRefCount();
+
+	dagGrammar.addProduction(pStartProduction);
+	for (unsigned int i = 0; i < dagProductions.size(); i++) {
+		dagGrammar.addProduction(dagProductions[i]);
+	}
+}
+
+TreeNode * GrammarDagConstructor::createTree(unsigned int rootClass,
+		const vector<Production *> & productions)
+{
+	TreeNode * pRoot = new TreeNode(classSymbols[rootClass]);
+
+	vector<pair<TreeNode *, unsigned int> > nodes;
+	nodes.push_back(make_pair(pRoot, rootClass));
+
+	while (!nodes.empty()) {
+		TreeNode * pNode = nodes.back().first;
+		unsigned int current = nodes.back().second;
+		nodes.pop_back();
+
+		unsigned int children[2] = { leftClasses[current], rightClasses[current] };
+		for (unsigned int i = 0; i < 2; i++) {
+			if (children[i] == EMPTY_TREE) {
+				continue;
+			}
+
+			Production * pProduction = productions[children[i]];
+			if (pProduction != 0) {
+				TreeNode * pReferenceNode = new TreeNode(pProduction->getLeftHandSide());
+				pNode->addChild(pReferenceNode);
+				pProduction->addRefNode(pReferenceNode);
+				pProduction->incrementRefCount();
+			} else {
+				TreeNode * pChild = new TreeNode(classSymbols[children[i]]);
+				pNode->addChild(pChild);
+				nodes.push_back(make_pair(pChild, children[i]));
+			}
+		}
+	}
+
+	return pRoot;
+}
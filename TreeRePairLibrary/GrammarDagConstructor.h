@@ -0,0 +1,236 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "Grammar.h"
+#include "GrammarIndex.h"
+#include "Symbol.h"
+#include "TreeNode.h"
+
+#include <boost/unordered_map.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Converts a linear SLCF tree grammar (e.g., read from a file generated
+ * by TreeRePair or in BPLEX-like format) into the grammar which
+ * XMLTreeParser would have constructed from the XML document represented
+ * by it: a start production and the productions of the minimal DAG of the
+ * binary tree (see TreeRePairMode::isUseDag()). This way, the grammar can
+ * be recompressed without decompressing it.
+ *
+ * The subtrees of the binary tree are computed bottom-up and hash-consed,
+ * i.e., every distinct subtree is represented by a unique number (its
+ * class) which is determined by its terminal symbol and the classes of
+ * its children. The classes of the applications of productions to
+ * sequences of argument classes are memoized, so every application is
+ * evaluated at most once. Only the productions generating at least
+ * MINIMAL_MEMOIZED_SIZE nodes (not counting the arguments) are memoized
+ * since evaluating a smaller production again is cheaper than looking it
+ * up. Therefore, the running time and the memory needed depend on the
+ * size of the grammar and on the size of the minimal DAG. The latter may
+ * be exponentially larger than the grammar, e.g., the next-sibling
+ * chains of n identical siblings are n different subtrees while a
+ * grammar needs O(log n) nodes. In this case, the cost is that of
+ * compressing the document and a warning is printed (see
+ * MAXIMAL_GROWTH).
+ *
+ * The terminal symbols of the input grammar may have two children each,
+ * which may be the placeholder symbol (as in grammars in BPLEX-like
+ * format). They are replaced by the terminal symbols of
+ * BinaryTreeConstructor having the children characteristics of the
+ * actual subtrees.
+ */
+class GrammarDagConstructor
+{
+public:
+	/**
+	 * The constructor. The input grammar is not changed.
+	 * @param inputDagGrammar the grammar containing the start production
+	 *  of the input grammar
+	 * @param inputMainGrammar the grammar containing the remaining
+	 *  productions of the input grammar
+	 * @param dagGrammar the Grammar instance which serves as a container
+	 *  of the start production and the DAG productions to construct
+	 */
+	GrammarDagConstructor(Grammar & inputDagGrammar,
+			Grammar & inputMainGrammar, Grammar & dagGrammar);
+	~GrammarDagConstructor(void);
+
+	/**
+	 * Returns the number of nodes of the binary tree represented by the
+	 * input grammar.
+	 */
+	unsigned int getNodeCount() const { return nodeCount; };
+
+	/**
+	 * Returns the number of nodes of the minimal DAG of the binary tree.
+	 */
+	unsigned int getNumberOfClasses() const { return classSymbols.size(); };
+
+	/**
+	 * Returns the number of nodes of the right-hand sides of the input
+	 * grammar.
+	 */
+	unsigned long long getInputSize() const { return inputSize; };
+
+private:
+	/**
+	 * The class of the empty tree, i.e., of a missing child. It is also
+	 * used as the number of the empty sequence of arguments.
+	 */
+	static const unsigned int EMPTY_TREE = 0xFFFFFFFF;
+
+	/**
+	 * See above.
+	 */
+	static const unsigned int MINIMAL_MEMOIZED_SIZE = 16;
+
+	/**
+	 * A warning is printed as soon as the minimal DAG has MAXIMAL_GROWTH
+	 * times as many nodes as the input grammar (and at least
+	 * MINIMAL_WARNING_SIZE nodes).
+	 */
+	static const unsigned int MAXIMAL_GROWTH = 64;
+	static const unsigned int MINIMAL_WARNING_SIZE = 1 << 20;
+
+	/**
+	 * An application of a production whose class is still to compute.
+	 * The nodes of its right-hand side are visited in postorder and the
+	 * classes of the visited subtrees are kept on a stack. The argument
+	 * classes, the nodes and the classes of all pending applications are
+	 * stored in common stacks, an application only stores where its
+	 * entries begin.
+	 */
+	struct PendingApplication
+	{
+		unsigned int production;
+		unsigned int firstArgument;
+		unsigned int nextArgument;
+		unsigned int firstNode;
+		unsigned int firstClass;
+	};
+
+	/**
+	 * Returns the specified grammar after checking that it contains a
+	 * start production.
+	 */
+	static Grammar & checkStartProduction(Grammar & inputDagGrammar);
+
+	/**
+	 * Decides which productions are memoized.
+	 */
+	void initializeMemoization();
+
+	/**
+	 * Computes the classes of all subtrees of the binary tree represented
+	 * by the input grammar and returns the class of the tree.
+	 */
+	unsigned int evaluate();
+
+	/**
+	 * Returns the key of the application of the specified production to
+	 * the specified argument classes.
+	 */
+	unsigned long long getApplicationKey(unsigned int production,
+			const unsigned int * arguments, unsigned int rank);
+
+	/**
+	 * Returns the class of the subtree with the specified terminal symbol
+	 * of the input grammar whose children have the specified classes.
+	 */
+	unsigned int getClass(Symbol * pSymbol, const unsigned int * children,
+			unsigned int childrenCount);
+
+	/**
+	 * Creates the start production and the DAG productions.
+	 */
+	void construct(unsigned int root);
+
+	/**
+	 * Creates a copy of the subtree of the specified class in which the
+	 * shared subtrees are replaced by the nonterminals of their
+	 * productions.
+	 */
+	TreeNode * createTree(unsigned int rootClass,
+			const vector<Production *> & productions);
+
+	GrammarIndex index;
+	Grammar & dagGrammar;
+
+	unsigned int nodeCount;
+
+	/**
+	 * See getInputSize().
+	 */
+	unsigned long long inputSize;
+
+	/**
+	 * The number of classes at which the warning about the size of the
+	 * DAG is printed.
+	 */
+	unsigned long long warningSize;
+
+	/**
+	 * By production: indicates whether its applications are memoized.
+	 */
+	vector<bool> memoized;
+
+	/**
+	 * By class: the terminal symbol and the classes of the children
+	 * (EMPTY_TREE if missing). The children of a class have smaller
+	 * numbers than the class itself.
+	 */
+	vector<Symbol *> classSymbols;
+	vector<unsigned int> leftClasses;
+	vector<unsigned int> rightClasses;
+
+	typedef boost::unordered_map<pair<unsigned int, unsigned long long>,
+			unsigned int> ClassMap;
+	typedef boost::unordered_map<unsigned long long, unsigned int> NumberMap;
+
+	/**
+	 * The classes by terminal symbol id and children classes.
+	 */
+	ClassMap classes;
+
+	/**
+	 * The sequences of argument classes are hash-consed like the
+	 * subtrees: a sequence is numbered by the number of the sequence
+	 * without its last class and the last class. The arguments of a
+	 * production of rank 1 are numbered by their class instead.
+	 */
+	NumberMap sequences;
+
+	/**
+	 * The classes of the evaluated applications by the number of the
+	 * production and the number of the sequence of argument classes.
+	 */
+	NumberMap applications;
+
+	/**
+	 * By symbol id and children characteristic (two bits): the terminal
+	 * symbol of BinaryTreeConstructor to use.
+	 */
+	vector<Symbol *> binarySymbols;
+};
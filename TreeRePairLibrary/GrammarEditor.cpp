@@ -0,0 +1,644 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "GrammarEditor.h"
+
+#include "BinaryTreeConstructor.h"
+#include "Digram.h"
+#include "DigramCounter.h"
+#include "DigramPriorityQueue.h"
+#include "DigramReplacer.h"
+#include "GrammarPruner.h"
+#include "ReferencesTreeCounter.h"
+#include "TreeDeleter.h"
+#include "TreeRePairMode.h"
+
+#include <iostream>
+#include <cstdlib>
+
+const unsigned long long GrammarEditor::UNKNOWN_SIZE;
+const unsigned int GrammarEditor::NO_SEGMENT;
+const unsigned int GrammarEditor::GROWTH_DIVISOR;
+
+GrammarEditor::GrammarEditor(Grammar & dagGrammarPar, Grammar & mainGrammarPar) :
+	dagGrammar(dagGrammarPar), mainGrammar(mainGrammarPar), pStartProduction(0),
+			grammarSize(0), addedNodes(0), numberOfRecompressions(0)
+{
+	if (dagGrammar.size() != 1) {
+		cout << "Fatal error: The grammar to edit must consist of a start "
+			"production and of productions which are not part of a DAG. "
+			"Exiting ..." << endl;
+		exit(1);
+	}
+	pStartProduction = dagGrammar[0];
+
+	computeSegments();
+	computeSizes(pStartProduction->getRightHandSide());
+
+	vector<TreeNode *> nodes;
+	collectNodes(pStartProduction->getRightHandSide(), nodes);
+	for (unsigned int i = 0; i < mainGrammar.size(); i++) {
+		collectNodes(mainGrammar[i]->getRightHandSide(), nodes);
+	}
+	grammarSize = nodes.size();
+}
+
+GrammarEditor::~GrammarEditor(void)
+{
+}
+
+bool GrammarEditor::insertSubtree(unsigned long long preorder,
+		TreeNode * pRoot, bool asFirstChild)
+{
+	Symbol * pRootSymbol = pRoot->getSymbol();
+	if (pRootSymbol->hasRightChild()) {
+		cout << "Fatal error: The root of an inserted tree must not have "
+			"a right child. Exiting ..." << endl;
+		exit(1);
+	}
+
+	if (!asFirstChild && preorder == 0) {
+		return false;
+	}
+
+	TreeNode * pNode = findElement(preorder);
+	if (pNode == 0) {
+		return false;
+	}
+
+	addedNodes += computeSizes(pRoot);
+	unsigned long long insertedSize = sizes[pRoot->getId()];
+	string elementType = Symbol::getElementTypeById(pRootSymbol->getId());
+
+	Symbol * pSymbol = pNode->getSymbol();
+	bool occupied = asFirstChild ? pSymbol->hasLeftChild()
+			: pSymbol->hasRightChild();
+
+	if (occupied) {
+		// the binary child in the chosen position becomes the right child
+		// of the root of the inserted tree
+		unsigned int index = asFirstChild ? 0
+				: pNode->getCurrentChildrenCount() - 1;
+		TreeNode * pFollowingNode = pNode->getChild(index);
+
+		TreeNode * pNewRoot = new TreeNode(BinaryTreeConstructor::retrieveSymbol(
+				elementType, pRootSymbol->hasLeftChild(), true));
+		if (pRootSymbol->hasLeftChild()) {
+			pNewRoot->addChild(pRoot->getChild(0));
+		}
+		pNewRoot->addChild(pFollowingNode);
+		pNode->setChild(index, pNewRoot);
+		setSize(pNewRoot, insertedSize + sizes[pFollowingNode->getId()]);
+		delete pRoot;
+
+		updateSizes(pNode, insertedSize);
+	} else {
+		// the element gets a binary child, i.e., its symbol changes
+		bool leftChild = pSymbol->hasLeftChild() || asFirstChild;
+		bool rightChild = pSymbol->hasRightChild() || !asFirstChild;
+		TreeNode * pNewNode = new TreeNode(BinaryTreeConstructor::retrieveSymbol(
+				Symbol::getElementTypeById(pSymbol->getId()), leftChild, rightChild));
+
+		if (asFirstChild) {
+			pNewNode->addChild(pRoot);
+		}
+		for (unsigned int i = 0; i < pNode->getCurrentChildrenCount(); i++) {
+			pNewNode->addChild(pNode->getChild(i));
+		}
+		if (!asFirstChild) {
+			pNewNode->addChild(pRoot);
+		}
+
+		replaceNode(pNode, pNewNode);
+		setSize(pNewNode, sizes[pNode->getId()]);
+		delete pNode;
+
+		updateSizes(pNewNode, insertedSize);
+	}
+
+	finishEdit();
+	return true;
+}
+
+bool GrammarEditor::deleteSubtree(unsigned long long preorder)
+{
+	if (preorder == 0) {
+		return false;
+	}
+
+	TreeNode * pNode = findElement(preorder);
+	if (pNode == 0) {
+		return false;
+	}
+
+	// the parent in the binary tree has to be a node of the start
+	// production, too, as it may lose a child
+	while (!isTerminal(pNode->getParent()->getSymbol())) {
+		addedNodes += computeSizes(inlineNonterminal(pNode->getParent()));
+	}
+	TreeNode * pParent = pNode->getParent();
+	unsigned int index = pNode->getIndex();
+
+	Symbol * pSymbol = pNode->getSymbol();
+	TreeNode * pNextSibling = 0;
+	if (pSymbol->hasRightChild()) {
+		pNextSibling = pNode->getChild(pNode->getCurrentChildrenCount() - 1);
+	}
+
+	unsigned long long deletedSize = sizes[pNode->getId()];
+	if (pNextSibling != 0) {
+		deletedSize -= sizes[pNextSibling->getId()];
+	}
+
+	if (pSymbol->hasLeftChild()) {
+		// the traversal must not leave the subtree
+		TreeNode * pFirstChild = pNode->getChild(0);
+		pFirstChild->setParent(0);
+		TreeDeleter treeDeleter;
+		treeDeleter.deleteTree(pFirstChild);
+	}
+	delete pNode;
+
+	if (pNextSibling != 0) {
+		pParent->setChild(index, pNextSibling);
+	} else {
+		// the parent loses a binary child, i.e., its symbol changes
+		Symbol * pParentSymbol = pParent->getSymbol();
+		bool isLeftChild = pParentSymbol->hasLeftChild() && index == 0;
+		TreeNode * pNewParent = new TreeNode(BinaryTreeConstructor::retrieveSymbol(
+				Symbol::getElementTypeById(pParentSymbol->getId()),
+				pParentSymbol->hasLeftChild() && !isLeftChild,
+				pParentSymbol->hasRightChild() && isLeftChild));
+
+		for (unsigned int i = 0; i < pParent->getCurrentChildrenCount(); i++) {
+			if (i != index) {
+				pNewParent->addChild(pParent->getChild(i));
+			}
+		}
+
+		replaceNode(pParent, pNewParent);
+		setSize(pNewParent, sizes[pParent->getId()]);
+		delete pParent;
+		pParent = pNewParent;
+	}
+
+	updateSizes(pParent, -(long long) deletedSize);
+
+	finishEdit();
+	return true;
+}
+
+bool GrammarEditor::renameElement(unsigned long long preorder,
+		const string & elementType)
+{
+	TreeNode * pNode = findElement(preorder);
+	if (pNode == 0) {
+		return false;
+	}
+
+	Symbol * pSymbol = pNode->getSymbol();
+	Symbol * pNewSymbol = BinaryTreeConstructor::retrieveSymbol(elementType,
+			pSymbol->hasLeftChild(), pSymbol->hasRightChild());
+
+	if (pNewSymbol != pSymbol) {
+		TreeNode * pNewNode = new TreeNode(pNewSymbol);
+		for (unsigned int i = 0; i < pNode->getCurrentChildrenCount(); i++) {
+			pNewNode->addChild(pNode->getChild(i));
+		}
+
+		replaceNode(pNode, pNewNode);
+		setSize(pNewNode, sizes[pNode->getId()]);
+		delete pNode;
+	}
+
+	finishEdit();
+	return true;
+}
+
+void GrammarEditor::recompress()
+{
+	repairStartProduction();
+	computeSegments();
+
+	// the pruning can only inline productions which are not referenced
+	// at the root of the start production
+	sizes.assign(TreeNode::idCounter, UNKNOWN_SIZE);
+	while (!isTerminal(pStartProduction->getRightHandSide()->getSymbol())) {
+		computeSizes(inlineNonterminal(pStartProduction->getRightHandSide()));
+	}
+
+	removeUnreachableProductions();
+	pruneGrammar();
+
+	// the nodes of the inlined productions have not been numbered
+	sizes.assign(TreeNode::idCounter, UNKNOWN_SIZE);
+	computeSizes(pStartProduction->getRightHandSide());
+
+	vector<TreeNode *> nodes;
+	collectNodes(pStartProduction->getRightHandSide(), nodes);
+	for (unsigned int i = 0; i < mainGrammar.size(); i++) {
+		collectNodes(mainGrammar[i]->getRightHandSide(), nodes);
+	}
+	grammarSize = nodes.size();
+	addedNodes = 0;
+	numberOfRecompressions++;
+}
+
+unsigned long long GrammarEditor::getOwnSize(Symbol * pSymbol)
+{
+	if (isTerminal(pSymbol)) {
+		return 1;
+	}
+
+	unsigned int begin = segmentBegins[pSymbol->getId()];
+	unsigned long long size = 0;
+	for (unsigned int i = 0; i <= pSymbol->getRank(); i++) {
+		size += segmentLengths[begin + i];
+	}
+	return size;
+}
+
+void GrammarEditor::computeSegments()
+{
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+	segmentBegins.resize(Symbol::counter, NO_SEGMENT);
+
+	vector<PendingNode> nodes;
+
+	for (unsigned int i = 0; i < mainGrammar.size(); i++) {
+		Production * pProduction = mainGrammar[i];
+		unsigned int id = pProduction->getLeftHandSide()->getId();
+		if (segmentBegins[id] != NO_SEGMENT) {
+			continue;
+		}
+
+		unsigned int begin = segmentLengths.size();
+		unsigned int current = begin;
+		segmentLengths.push_back(0);
+
+		PendingNode root = { pProduction->getRightHandSide(), NO_SEGMENT };
+		nodes.push_back(root);
+
+		while (!nodes.empty()) {
+			PendingNode pending = nodes.back();
+			nodes.pop_back();
+
+			Symbol * pSymbol = pending.pNode->getSymbol();
+			if (pending.segment != NO_SEGMENT) {
+				segmentLengths[current] +=
+						segmentLengths[segmentBegins[pSymbol->getId()] + pending.segment];
+				continue;
+			}
+
+			if (pSymbol == pParameterSymbol) {
+				current = segmentLengths.size();
+				segmentLengths.push_back(0);
+				continue;
+			}
+
+			unsigned int children = pending.pNode->getCurrentChildrenCount();
+			if (isTerminal(pSymbol)) {
+				segmentLengths[current]++;
+				for (unsigned int j = children; j > 0; j--) {
+					PendingNode child = { pending.pNode->getChild(j - 1), NO_SEGMENT };
+					nodes.push_back(child);
+				}
+			} else {
+				// the segments of the referenced production and its
+				// arguments alternate
+				segmentLengths[current] += segmentLengths[segmentBegins[pSymbol->getId()]];
+				for (unsigned int j = children; j > 0; j--) {
+					PendingNode segment = { pending.pNode, j };
+					nodes.push_back(segment);
+					PendingNode child = { pending.pNode->getChild(j - 1), NO_SEGMENT };
+					nodes.push_back(child);
+				}
+			}
+		}
+
+		if (segmentLengths.size() - begin != pProduction->getLeftHandSide()->getRank() + 1) {
+			cout << "Fatal error: The rank of a nonterminal does not "
+				"match the number of parameters of its production. "
+				"Exiting ..." << endl;
+			exit(1);
+		}
+		segmentBegins[id] = begin;
+	}
+}
+
+unsigned long long GrammarEditor::computeSizes(TreeNode * pRoot)
+{
+	if (sizes.size() < TreeNode::idCounter) {
+		sizes.resize(TreeNode::idCounter, UNKNOWN_SIZE);
+	}
+	if (sizes[pRoot->getId()] != UNKNOWN_SIZE) {
+		return 0;
+	}
+
+	unsigned long long computed = 0;
+
+	// the nodes are visited in postorder, the second component indicates
+	// whether the children have been visited already
+	vector<pair<TreeNode *, bool> > nodes;
+	nodes.push_back(make_pair(pRoot, false));
+
+	while (!nodes.empty()) {
+		TreeNode * pNode = nodes.back().first;
+		bool childrenVisited = nodes.back().second;
+		nodes.pop_back();
+
+		unsigned int children = pNode->getCurrentChildrenCount();
+		if (!childrenVisited) {
+			nodes.push_back(make_pair(pNode, true));
+			for (unsigned int i = 0; i < children; i++) {
+				TreeNode * pChild = pNode->getChild(i);
+				if (sizes[pChild->getId()] == UNKNOWN_SIZE) {
+					nodes.push_back(make_pair(pChild, false));
+				}
+			}
+			continue;
+		}
+
+		unsigned long long size = getOwnSize(pNode->getSymbol());
+		for (unsigned int i = 0; i < children; i++) {
+			size += sizes[pNode->getChild(i)->getId()];
+		}
+		sizes[pNode->getId()] = size;
+		computed++;
+	}
+
+	return computed;
+}
+
+void GrammarEditor::setSize(TreeNode * pNode, unsigned long long size)
+{
+	if (sizes.size() < TreeNode::idCounter) {
+		sizes.resize(TreeNode::idCounter, UNKNOWN_SIZE);
+	}
+	sizes[pNode->getId()] = size;
+}
+
+void GrammarEditor::updateSizes(TreeNode * pNode, long long difference)
+{
+	for (; pNode != 0; pNode = pNode->getParent()) {
+		sizes[pNode->getId()] += difference;
+	}
+}
+
+TreeNode * GrammarEditor::findElement(unsigned long long preorder)
+{
+	TreeNode * pNode = pStartProduction->getRightHandSide();
+	if (preorder >= sizes[pNode->getId()]) {
+		return 0;
+	}
+
+	// the number of elements of the subtree of pNode preceding the element
+	unsigned long long offset = preorder;
+
+	while (true) {
+		Symbol * pSymbol = pNode->getSymbol();
+		unsigned int children = pNode->getCurrentChildrenCount();
+
+		if (isTerminal(pSymbol)) {
+			if (offset == 0) {
+				return pNode;
+			}
+			offset--;
+
+			for (unsigned int i = 0; i < children; i++) {
+				TreeNode * pChild = pNode->getChild(i);
+				unsigned long long size = sizes[pChild->getId()];
+				if (offset < size) {
+					pNode = pChild;
+					break;
+				}
+				offset -= size;
+			}
+			continue;
+		}
+
+		// the segments of the production and the arguments alternate
+		unsigned int begin = segmentBegins[pSymbol->getId()];
+		unsigned long long argumentOffset = offset;
+		TreeNode * pArgument = 0;
+		for (unsigned int i = 0; i < children; i++) {
+			if (argumentOffset < segmentLengths[begin + i]) {
+				break;
+			}
+			argumentOffset -= segmentLengths[begin + i];
+
+			TreeNode * pChild = pNode->getChild(i);
+			unsigned long long size = sizes[pChild->getId()];
+			if (argumentOffset < size) {
+				pArgument = pChild;
+				break;
+			}
+			argumentOffset -= size;
+		}
+
+		if (pArgument != 0) {
+			pNode = pArgument;
+			offset = argumentOffset;
+		} else {
+			// the element is generated by the production itself
+			pNode = inlineNonterminal(pNode);
+			addedNodes += computeSizes(pNode);
+		}
+	}
+}
+
+TreeNode * GrammarEditor::inlineNonterminal(TreeNode * pNode)
+{
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+	Production * pProduction = mainGrammar.getProductionBySymbol(pNode->getSymbol());
+
+	TreeNode * pCopy = 0;
+	unsigned int parameter = 0;
+
+	// the nodes of the right-hand side are copied in preorder together
+	// with the copies of their parents, i.e., the parameters are
+	// encountered in the order of their numbers
+	vector<pair<TreeNode *, TreeNode *> > nodes;
+	nodes.push_back(make_pair(pProduction->getRightHandSide(), (TreeNode *) 0));
+
+	while (!nodes.empty()) {
+		TreeNode * pOriginal = nodes.back().first;
+		TreeNode * pParent = nodes.back().second;
+		nodes.pop_back();
+
+		TreeNode * pNewNode = 0;
+		if (pOriginal->getSymbol() == pParameterSymbol) {
+			pNewNode = pNode->getChild(parameter++);
+		} else {
+			pNewNode = new TreeNode(pOriginal->getSymbol());
+			for (unsigned int i = pOriginal->getCurrentChildrenCount(); i > 0; i--) {
+				nodes.push_back(make_pair(pOriginal->getChild(i - 1), pNewNode));
+			}
+		}
+
+		if (pParent == 0) {
+			pCopy = pNewNode;
+		} else {
+			pParent->addChild(pNewNode);
+		}
+	}
+
+	replaceNode(pNode, pCopy);
+	delete pNode;
+
+	return pCopy;
+}
+
+void GrammarEditor::replaceNode(TreeNode * pOldNode, TreeNode * pNewNode)
+{
+	TreeNode * pParent = pOldNode->getParent();
+	if (pParent != 0) {
+		pParent->setChild(pOldNode->getIndex(), pNewNode);
+	} else {
+		dagGrammar.updateRightHandSide(pStartProduction, pNewNode);
+	}
+}
+
+void GrammarEditor::finishEdit()
+{
+	if (addedNodes * GROWTH_DIVISOR > grammarSize) {
+		recompress();
+	}
+}
+
+void GrammarEditor::removeUnreachableProductions()
+{
+	// a production may only be referenced by the start production and by
+	// productions following it
+	vector<bool> isReachable(Symbol::counter, false);
+	vector<TreeNode *> nodes;
+
+	collectNodes(pStartProduction->getRightHandSide(), nodes);
+	for (unsigned int i = 0; i < nodes.size(); i++) {
+		isReachable[nodes[i]->getSymbol()->getId()] = true;
+	}
+
+	unsigned int size = mainGrammar.size();
+	vector<bool> isRemoved(size, false);
+	vector<Production *> removedProductions;
+
+	for (unsigned int i = size; i > 0; i--) {
+		Production * pProduction = mainGrammar[i - 1];
+		if (!isReachable[pProduction->getLeftHandSide()->getId()]) {
+			isRemoved[i - 1] = true;
+			removedProductions.push_back(pProduction);
+			continue;
+		}
+
+		nodes.clear();
+		collectNodes(pProduction->getRightHandSide(), nodes);
+		for (unsigned int j = 0; j < nodes.size(); j++) {
+			isReachable[nodes[j]->getSymbol()->getId()] = true;
+		}
+	}
+
+	mainGrammar.removeProductions(isRemoved);
+
+	for (unsigned int i = 0; i < removedProductions.size(); i++) {
+		Production::deleteProduction(removedProductions[i]);
+	}
+}
+
+void GrammarEditor::repairStartProduction()
+{
+	// the occurrence lists may still contain nodes deleted by the edits
+	vector<TreeNode *> nodes;
+	collectNodes(pStartProduction->getRightHandSide(), nodes);
+	for (unsigned int i = 0; i < nodes.size(); i++) {
+		TreeNode * pNode = nodes[i];
+		for (unsigned int j = 0; j < pNode->getCurrentChildrenCount(); j++) {
+			pNode->setNextDigramOccurrence(j, 0);
+			pNode->setPreviousDigramOccurrence(j, 0);
+		}
+	}
+
+	pStartProduction->setRefCount(1);
+	pStartProduction->setTransitiveRefCount(1);
+
+	HASH_D_D digramHashMap;
+	DigramPriorityQueue priorityQueue(nodes.size(), &digramHashMap);
+	DigramCounter digramCounter(dagGrammar, &digramHashMap, &priorityQueue);
+	DigramReplacer digramReplacer(&priorityQueue, &digramCounter,
+			&digramHashMap, dagGrammar, mainGrammar);
+
+	for (HASH_D_D::iterator it = digramHashMap.begin(); it != digramHashMap.end();) {
+		Digram * pDigram = it->second;
+		++it;
+		delete pDigram;
+	}
+}
+
+void GrammarEditor::pruneGrammar()
+{
+	if (mainGrammar.size() == 0 || TreeRePairMode::getInstance()->getOptimizationMode()
+			== TreeRePairMode::OPTIMIZE_DISABLE) {
+		return;
+	}
+
+	// the pruning needs the references and the parameter nodes of all
+	// productions (the latter are not known for productions which were
+	// read from a file)
+	Symbol * pParameterSymbol = Symbol::getParameterSymbol();
+	vector<TreeNode *> nodes;
+
+	for (unsigned int i = 0; i < mainGrammar.size(); i++) {
+		Production * pProduction = mainGrammar[i];
+		pProduction->setRefCount(0);
+		pProduction->getReferencingNodes()->clear();
+
+		nodes.clear();
+		collectNodes(pProduction->getRightHandSide(), nodes);
+		unsigned int parameter = 0;
+		for (unsigned int j = 0; j < nodes.size(); j++) {
+			if (nodes[j]->getSymbol() == pParameterSymbol) {
+				pProduction->setParameter(parameter++, nodes[j]);
+			}
+		}
+	}
+
+	ReferencesTreeCounter treeCounter(pStartProduction->getRightHandSide(),
+			&dagGrammar, mainGrammar);
+	for (unsigned int i = 0; i < mainGrammar.size(); i++) {
+		ReferencesTreeCounter treeCounter(mainGrammar[i]->getRightHandSide(),
+				0, mainGrammar);
+	}
+
+	GrammarPruner pruner(dagGrammar, mainGrammar, false);
+	pruner.pruneGrammar();
+}
+
+void GrammarEditor::collectNodes(TreeNode * pRoot, vector<TreeNode *> & nodes)
+{
+	vector<TreeNode *> pendingNodes;
+	pendingNodes.push_back(pRoot);
+
+	while (!pendingNodes.empty()) {
+		TreeNode * pNode = pendingNodes.back();
+		pendingNodes.pop_back();
+		nodes.push_back(pNode);
+
+		for (unsigned int i = pNode->getCurrentChildrenCount(); i > 0; i--) {
+			pendingNodes.push_back(pNode->getChild(i - 1));
+		}
+	}
+}
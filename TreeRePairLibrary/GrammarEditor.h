@@ -0,0 +1,251 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "Grammar.h"
+#include "Production.h"
+#include "Symbol.h"
+#include "TreeNode.h"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Edits the XML document represented by a linear SLCF tree grammar
+ * without decompressing it. The elements are addressed by their preorder
+ * numbers (the root element has number 0). Subtrees can be inserted and
+ * deleted and elements can be renamed.
+ *
+ * Every edit is carried out on the right-hand side of the start
+ * production: the nonterminal nodes on the path from its root to the
+ * edited element are replaced by copies of the right-hand sides of their
+ * productions (path copying). The productions themselves are not changed
+ * since they may be referenced elsewhere. The numbers of elements
+ * generated by the nodes of the start production and by the segments of
+ * the right-hand sides between their parameters are kept, so an edit
+ * costs time proportional to the depth of the grammar (times the size of
+ * a right-hand side) plus the size of the inserted subtree.
+ *
+ * The copies make the start production grow. As soon as the edits have
+ * added more than a quarter of the size of the grammar, the start
+ * production is re-paired, i.e., the digrams occurring more than once in
+ * it are replaced like in TreeRePairAlgorithm (the nonterminals of the
+ * existing productions are treated like terminal symbols), and the
+ * grammar is pruned afterwards.
+ *
+ * The grammars must have been read in compression mode (see
+ * TreeRePairMode::setAlgMode()) since the re-pairing needs the digram
+ * occurrence lists of the nodes.
+ */
+class GrammarEditor
+{
+public:
+	/**
+	 * The constructor precomputes the numbers of elements generated by
+	 * the productions.
+	 * @param dagGrammar the grammar containing the start production
+	 * @param mainGrammar the grammar containing the remaining productions
+	 */
+	GrammarEditor(Grammar & dagGrammar, Grammar & mainGrammar);
+	~GrammarEditor(void);
+
+	/**
+	 * Returns the number of elements of the document.
+	 */
+	unsigned long long getNumberOfElements() {
+		return sizes[pStartProduction->getRightHandSide()->getId()];
+	};
+
+	/**
+	 * Inserts the specified tree (in the binary representation, i.e.,
+	 * its root must not have a right child) as the first child or as the
+	 * next sibling of the element with the specified preorder number. The
+	 * editor takes ownership of the nodes of the tree. Returns false if
+	 * there is no such element or if a sibling of the root element is to
+	 * be inserted.
+	 */
+	bool insertSubtree(unsigned long long preorder, TreeNode * pRoot,
+			bool asFirstChild);
+
+	/**
+	 * Deletes the subtree rooted at the element with the specified
+	 * preorder number. Returns false if there is no such element or if
+	 * it is the root element.
+	 */
+	bool deleteSubtree(unsigned long long preorder);
+
+	/**
+	 * Changes the element type of the element with the specified preorder
+	 * number. Returns false if there is no such element.
+	 */
+	bool renameElement(unsigned long long preorder, const string & elementType);
+
+	/**
+	 * Re-pairs the start production and prunes the grammar (see above).
+	 * Productions which are not reachable anymore are deleted.
+	 */
+	void recompress();
+
+	/**
+	 * Returns the number of times the grammar was recompressed.
+	 */
+	unsigned int getNumberOfRecompressions() { return numberOfRecompressions; };
+
+private:
+	/**
+	 * A node of a right-hand side which is still to visit (segment is
+	 * NO_SEGMENT) or a nonterminal node whose segment with the specified
+	 * index follows the arguments visited before.
+	 */
+	struct PendingNode
+	{
+		TreeNode * pNode;
+		unsigned int segment;
+	};
+
+	static const unsigned long long UNKNOWN_SIZE = ~0ULL;
+
+	static const unsigned int NO_SEGMENT = ~0U;
+
+	/**
+	 * The start production is recompressed as soon as the edits have added
+	 * more than the size of the grammar divided by this number of nodes.
+	 */
+	static const unsigned int GROWTH_DIVISOR = 4;
+
+	bool isTerminal(Symbol * pSymbol) {
+		return Symbol::isTerminalSymbol(pSymbol->getId());
+	};
+
+	/**
+	 * Returns the number of elements generated by the specified symbol
+	 * (not counting the arguments of a nonterminal).
+	 */
+	unsigned long long getOwnSize(Symbol * pSymbol);
+
+	/**
+	 * Computes the segment lengths of all productions for which they are
+	 * not known yet. A production may only reference productions
+	 * preceding it.
+	 */
+	void computeSegments();
+
+	/**
+	 * Computes the numbers of elements of the subtrees of the start
+	 * production rooted at the nodes of the subtree rooted at the
+	 * specified node whose numbers are not known yet. Returns the number
+	 * of these nodes.
+	 */
+	unsigned long long computeSizes(TreeNode * pRoot);
+
+	void setSize(TreeNode * pNode, unsigned long long size);
+
+	/**
+	 * Adds the specified difference to the numbers of elements of the
+	 * specified node of the start production and of its ancestors.
+	 */
+	void updateSizes(TreeNode * pNode, long long difference);
+
+	/**
+	 * Returns the terminal node of the start production generating the
+	 * element with the specified preorder number (or 0 if there is no
+	 * such element). The nonterminal nodes on the path to it are replaced
+	 * by the right-hand sides of their productions if necessary.
+	 */
+	TreeNode * findElement(unsigned long long preorder);
+
+	/**
+	 * Replaces the specified nonterminal node of the start production by
+	 * a copy of the right-hand side of its production whose parameters
+	 * are replaced by the children of the node. Returns the root of the
+	 * copy.
+	 */
+	TreeNode * inlineNonterminal(TreeNode * pNode);
+
+	/**
+	 * Puts the specified node in the place of the specified node of the
+	 * start production (the latter is not deleted).
+	 */
+	void replaceNode(TreeNode * pOldNode, TreeNode * pNewNode);
+
+	/**
+	 * Recompresses the grammar if the edits have made it grow too much.
+	 */
+	void finishEdit();
+
+	/**
+	 * Deletes all productions which are not reachable from the start
+	 * production.
+	 */
+	void removeUnreachableProductions();
+
+	/**
+	 * Replaces the digrams occurring more than once in the start
+	 * production by new productions.
+	 */
+	void repairStartProduction();
+
+	/**
+	 * Eliminates the productions which are referenced only once or do
+	 * not save any edges (see GrammarPruner).
+	 */
+	void pruneGrammar();
+
+	/**
+	 * Appends the nodes of the tree rooted at the specified node to the
+	 * specified vector in preorder.
+	 */
+	static void collectNodes(TreeNode * pRoot, vector<TreeNode *> & nodes);
+
+	Grammar & dagGrammar;
+
+	Grammar & mainGrammar;
+
+	Production * pStartProduction;
+
+	/**
+	 * By node id: the number of elements of the expanded subtree rooted
+	 * at a node of the start production (or UNKNOWN_SIZE).
+	 */
+	vector<unsigned long long> sizes;
+
+	/**
+	 * By symbol id: the index of the first segment length of the
+	 * production of a nonterminal (or NO_SEGMENT).
+	 */
+	vector<unsigned int> segmentBegins;
+
+	/**
+	 * The numbers of elements of the segments of the expanded right-hand
+	 * sides before, between and after the parameters (a production of
+	 * rank r has r + 1 segments).
+	 */
+	vector<unsigned long long> segmentLengths;
+
+	/**
+	 * The number of nodes of all right-hand sides after the last
+	 * recompression and the number of nodes added since.
+	 */
+	unsigned long long grammarSize;
+	unsigned long long addedNodes;
+
+	unsigned int numberOfRecompressions;
+};
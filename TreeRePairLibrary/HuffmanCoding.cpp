@@ -18,204 +18,168 @@
  */
 #include "HuffmanCoding.h"
 
-#include "HuffmanTreeNode.h"
-#include "HuffmanTreeDeleter.h"
-
 #include "TreeRePairConstants.h"
-#include "Helper.h"
+#include "Symbol.h"
 
-#include <queue>
+#include <algorithm>
+#include <climits>
 
 using namespace std;
 
 HuffmanCoding::HuffmanCoding(BitWriter & bitWriterPar, ofstream & foutPar,
 		bool unencodedPar) :
-	Huffman(), pHuffmanTreeNodesVector(0), bitWriter(bitWriterPar), fout(
-			foutPar), unencoded(unencodedPar), biggestDecimal(0)
+	bitWriter(bitWriterPar), fout(foutPar), unencoded(unencodedPar),
+			biggestDecimal(0), maximumCodeLength(0)
 {
-	pHuffmanTreeNodesVector = new vector<HuffmanTreeNode*> ;
 }
 
 HuffmanCoding::~HuffmanCoding()
 {
 }
 
-unsigned int HuffmanCoding::getMaximumCodeLength()
+void HuffmanCoding::countSymbol(const unsigned int symbol,
+		const unsigned int add)
 {
-
-	unsigned int maximumCodeLength = 0;
-
-	HASH_S_H::iterator it;
-	for (it = pHashedHuffmanTreeNodes->begin(); it
-			!= pHashedHuffmanTreeNodes->end(); ++it)
+	// the code lengths are enumerated up to the biggest symbol and their
+	// number is written using CODE_LENGTH_BITS bits
+	if (symbol >= (1u << CODE_LENGTH_BITS) - 1)
 	{
-		HuffmanTreeNode * pHuffmanTreeNode = it->second;
-		unsigned int codeLength =
-				pHuffmanTreeNode->getBitRepresentation().length();
-
-		if (codeLength > maximumCodeLength)
-		{
-			maximumCodeLength = codeLength;
-		}
+		cout << "Fatal error: Can't encode value " << symbol << ". Exiting ...";
+		exit(1);
 	}
 
-	return maximumCodeLength;
-
-}
+	if (symbol >= frequencies.size())
+	{
+		frequencies.resize(symbol + 1, 0);
+		counted.resize(symbol + 1, false);
+	}
 
-void HuffmanCoding::countSymbol(const unsigned int symbol,
-		const unsigned int add)
-{
 	if (biggestDecimal < symbol)
 	{
 		biggestDecimal = symbol;
 	}
 
-	HASH_S_H::iterator result = pHashedHuffmanTreeNodes->find(symbol);
-	HuffmanTreeNode * pHuffmanTreeNode = 0;
-	if (result == pHashedHuffmanTreeNodes->end())
+	if (!counted[symbol])
 	{
-		pHuffmanTreeNode = addHuffmanTreeNode(symbol);
-	} else {
-		pHuffmanTreeNode = result->second;
+		counted[symbol] = true;
+		symbols.push_back(symbol);
 	}
-	pHuffmanTreeNode->addToFrequency(add);
-}
-
-HuffmanTreeNode * HuffmanCoding::addHuffmanTreeNode(const unsigned int symbol)
-{
-	HuffmanTreeNode * pHuffmanTreeNode = new HuffmanTreeNode();
-	(*pHashedHuffmanTreeNodes)[symbol] = pHuffmanTreeNode;
-
-	pHuffmanTreeNodesVector->push_back(pHuffmanTreeNode);
-
-	return pHuffmanTreeNode;
+	frequencies[symbol] += add;
 }
 
-void HuffmanCoding::computeHuffmanCodes(HuffmanTreeNode * pNode,
-		const string &representation)
+void HuffmanCoding::computeHuffmanCodes()
 {
-
-	if (pNode->getLeftChild() != 0)
-	{
-		computeHuffmanCodes(pNode->getLeftChild(), representation + "0");
-		computeHuffmanCodes(pNode->getRightChild(), representation
-				+ "1");
-	}
-	else
-	{
-		pNode->setBitRepresentation(representation);
-	}
-
+	computeCodeLengths();
+	computeCanonicalCodes();
 }
 
-void HuffmanCoding::computeHuffmanTree()
+void HuffmanCoding::computeCodeLengths()
 {
+	codeLengths.assign(frequencies.size(), 0);
+	maximumCodeLength = 0;
 
-	// cout << "biggest decimal is " << biggestDecimal << endl;
-
-	if (pHuffmanTreeNodesVector->size() == 1)
+	unsigned int n = symbols.size();
+	if (n <= 1)
 	{
-		pRootNode = (*pHuffmanTreeNodesVector)[0];
+		// a single symbol is represented by the empty code
 		return;
 	}
 
-	sort(pHuffmanTreeNodesVector->begin(), pHuffmanTreeNodesVector->end(),
-			cmpHuffmanTreeNodes);
-
-	queue<HuffmanTreeNode*> pNodesQueue;
-	queue<HuffmanTreeNode*> pSubTreesQueue;
-
-	for (unsigned int i = 0; i < pHuffmanTreeNodesVector->size(); i++)
+	// the leaves sorted by increasing frequency (the symbols are kept in
+	// the order of their first occurrence to get a deterministic result)
+	vector<pair<unsigned int, unsigned int> > leaves(n);
+	for (unsigned int i = 0; i < n; i++)
 	{
-		pNodesQueue.push((*pHuffmanTreeNodesVector)[i]);
+		leaves[i] = make_pair(frequencies[symbols[i]], symbols[i]);
 	}
+	stable_sort(leaves.begin(), leaves.end(), cmpLeaves);
 
-	delete pHuffmanTreeNodesVector;
+	// two-queue construction: the leaves are taken from the sorted list,
+	// the internal nodes 0, ..., n - 2 are created in order of increasing
+	// weight and therefore form the second queue
+	vector<unsigned long long> weights(n - 1);
+	vector<unsigned int> parents(2 * n - 1);
+	unsigned int nextLeaf = 0, nextNode = 0;
 
-	while (true)
+	for (unsigned int node = 0; node < n - 1; node++)
 	{
-
-		int frequencyNodesQueue = INT_MAX;
-		int frequencySubTreesQueue = INT_MAX;
-
-		if (!pNodesQueue.empty())
-		{
-			frequencyNodesQueue = pNodesQueue.front()->getFrequency();
-		}
-
-		if (!pSubTreesQueue.empty())
-		{
-			frequencySubTreesQueue = pSubTreesQueue.front()->getFrequency();
-		}
-
-		HuffmanTreeNode * pFirstNode;
-		if (frequencyNodesQueue < frequencySubTreesQueue)
-		{
-			pFirstNode = pNodesQueue.front();
-			pNodesQueue.pop();
-			if (!pNodesQueue.empty())
-			{
-				frequencyNodesQueue = pNodesQueue.front()->getFrequency();
-			}
-			else
-			{
-				frequencyNodesQueue = INT_MAX;
-			}
-		}
-		else
+		unsigned int children[2];
+		unsigned long long childWeights[2];
+		for (unsigned int c = 0; c < 2; c++)
 		{
-			pFirstNode = pSubTreesQueue.front();
-			pSubTreesQueue.pop();
-			if (!pSubTreesQueue.empty())
+			bool takeLeaf = nextLeaf < n && (nextNode == node
+					|| leaves[nextLeaf].first < weights[nextNode]);
+			if (takeLeaf)
 			{
-				frequencySubTreesQueue = pSubTreesQueue.front()->getFrequency();
+				childWeights[c] = leaves[nextLeaf].first;
+				children[c] = nextLeaf++;
 			}
 			else
 			{
-				frequencySubTreesQueue = INT_MAX;
+				childWeights[c] = weights[nextNode];
+				children[c] = n + nextNode++;
 			}
 		}
 
-		// huffman tree is complete
-		if (frequencyNodesQueue == INT_MAX && frequencySubTreesQueue == INT_MAX)
-		{
-			pSubTreesQueue.push(pFirstNode);
-			break;
-		}
+		weights[node] = childWeights[0] + childWeights[1];
+		parents[children[0]] = n + node;
+		parents[children[1]] = n + node;
+	}
 
-		HuffmanTreeNode * pSecondNode = 0;
-		if (frequencyNodesQueue < frequencySubTreesQueue)
-		{
-			pSecondNode = pNodesQueue.front();
-			pNodesQueue.pop();
-		}
-		else
+	// the depth of a node is the depth of its parent plus one, the root
+	// is the last internal node and parents are created after their
+	// children
+	vector<unsigned int> depths(2 * n - 1);
+	depths[2 * n - 2] = 0;
+	for (int i = 2 * n - 3; i >= 0; i--)
+	{
+		depths[i] = depths[parents[i]] + 1;
+	}
+
+	for (unsigned int i = 0; i < n; i++)
+	{
+		codeLengths[leaves[i].second] = depths[i];
+		if (depths[i] > maximumCodeLength)
 		{
-			pSecondNode = pSubTreesQueue.front();
-			pSubTreesQueue.pop();
+			maximumCodeLength = depths[i];
 		}
-
-		HuffmanTreeNode * pNewNode = new HuffmanTreeNode();
-		pNewNode->setFrequency(pFirstNode->getFrequency()
-				+ pSecondNode->getFrequency());
-		pNewNode->setLeftChild(pFirstNode);
-		pNewNode->setRightChild(pSecondNode);
-
-		pSubTreesQueue.push(pNewNode);
 	}
+}
 
-	pRootNode = pSubTreesQueue.front();
-
-	computeHuffmanCodes(pRootNode, string(""));
-
-	return;
+bool HuffmanCoding::cmpLeaves(const pair<unsigned int, unsigned int> & leaf1,
+		const pair<unsigned int, unsigned int> & leaf2)
+{
+	return leaf1.first < leaf2.first;
 }
 
-bool HuffmanCoding::cmpHuffmanTreeNodes(HuffmanTreeNode * pNode1,
-		HuffmanTreeNode * pNode2)
+// see page 7 in DEFLATE specification
+void HuffmanCoding::computeCanonicalCodes()
 {
-	return pNode1->getFrequency() < pNode2->getFrequency();
+	codes.assign(codeLengths.size(), 0);
+
+	vector<unsigned int> lengthCounts(maximumCodeLength + 1, 0);
+	for (unsigned int symbol = 0; symbol < codeLengths.size(); symbol++)
+	{
+		lengthCounts[codeLengths[symbol]]++;
+	}
+	lengthCounts[0] = 0;
+
+	vector<uint64_t> nextCodes(maximumCodeLength + 1, 0);
+	uint64_t code = 0;
+	for (unsigned int bits = 1; bits <= maximumCodeLength; bits++)
+	{
+		code = (code + lengthCounts[bits - 1]) << 1;
+		nextCodes[bits] = code;
+	}
+
+	for (unsigned int symbol = 0; symbol < codeLengths.size(); symbol++)
+	{
+		unsigned int codeLength = codeLengths[symbol];
+		if (codeLength != 0)
+		{
+			codes[symbol] = nextCodes[codeLength]++;
+		}
+	}
 }
 
 void HuffmanCoding::writeHuffmanCode(const int symbol, bool isSymbol)
@@ -236,10 +200,9 @@ void HuffmanCoding::writeHuffmanCode(const int symbol, bool isSymbol)
 	}
 	else
 	{
-		HASH_S_H::iterator result = pHashedHuffmanTreeNodes->find(symbol);
-		if (result != pHashedHuffmanTreeNodes->end()) {
-			HuffmanTreeNode * pHuffmanTreeNode = result->second;
-			bitWriter.writeBitString(pHuffmanTreeNode->getBitRepresentation());
+		unsigned int index = symbol;
+		if (index < counted.size() && counted[index]) {
+			bitWriter.writeBits(codes[index], codeLengths[index]);
 		} else {
 			cout << "Fatal error: Can't encode value " << symbol << ". Exiting ...";
 			exit(1);
@@ -248,70 +211,20 @@ void HuffmanCoding::writeHuffmanCode(const int symbol, bool isSymbol)
 
 }
 
-void HuffmanCoding::reorganizeHuffmanCodes()
+#ifdef DEBUG
+void HuffmanCoding::printCoding()
 {
-	unsigned int ** bl_count = new unsigned int *[getMaximumCodeLength() + 1];
-	unsigned int ** next_code = new unsigned int *[getMaximumCodeLength() + 1];
-
-	for (unsigned int i = 0; i <= getMaximumCodeLength(); i++)
-	{
-		bl_count[i] = new unsigned int(0);
-		next_code[i] = new unsigned int(0);
-	}
-
-	for (unsigned int symbol = 0; symbol <= biggestDecimal; symbol++)
-	{
-
-		HASH_S_H::iterator it = pHashedHuffmanTreeNodes->find(symbol);
-		if (it != pHashedHuffmanTreeNodes->end())
-		{
-			HuffmanTreeNode * pHuffmanTreeNode = it->second;
-
-			// cout << "old: " << symbol << " : " << pHuffmanTreeNode->getBitRepresentation() << endl;
-
-			unsigned int codeLength =
-					pHuffmanTreeNode->getBitRepresentation().length();
-			unsigned int * count = bl_count[codeLength];
-			(*count)++;
-		}
-	}
-
-	unsigned int code = 0;
-	(*(bl_count[0])) = 0;
-
-	for (unsigned int bits = 1; bits <= getMaximumCodeLength(); bits++)
-	{
-		code = (code + (*(bl_count[bits - 1]))) << 1;
-		(*(next_code[bits])) = code;
-	}
-
-	for (unsigned int symbol = 0; symbol <= biggestDecimal; symbol++)
+	for (unsigned int symbol = 0; symbol < counted.size(); symbol++)
 	{
-
-		HASH_S_H::iterator it = pHashedHuffmanTreeNodes->find(symbol);
-		if (it != pHashedHuffmanTreeNodes->end())
+		if (counted[symbol])
 		{
-			HuffmanTreeNode * pHuffmanTreeNode = it->second;
-			unsigned int codeLength =
-					pHuffmanTreeNode->getBitRepresentation().length();
-			if (codeLength != 0)
+			cout << symbol << ": ";
+			for (int i = codeLengths[symbol] - 1; i >= 0; i--)
 			{
-				pHuffmanTreeNode->setBitRepresentation(convertUintToBinary(
-						(*(next_code[codeLength])), codeLength));
-				(*(next_code[codeLength]))++;
-
-				// cout << "new: " << symbol << " : " << pHuffmanTreeNode->getBitRepresentation() << endl;
+				cout << ((codes[symbol] >> i) & 1);
 			}
+			cout << endl;
 		}
 	}
-
-
-	for (unsigned int i = 0; i <= getMaximumCodeLength(); i++)
-	{
-		delete bl_count[i];
-		delete next_code[i];
-	}
-
-	delete [] bl_count;
-	delete [] next_code;
 }
+#endif
@@ -18,21 +18,21 @@
  */
 #pragma once
 
-#include "Huffman.h"
 #include "BitWriter.h"
-#include "HuffmanTreeNode.h"
-#include "TreeRePairTypes.h"
 
 #include <fstream>
-#include <string>
+#include <vector>
+#include <utility>
+#include <stdint.h>
 
 using namespace std;
 
 /**
- * This class implements a Huffman coding which directly supports the
- * output of the Huffman codes into a binary file.
+ * This class implements a canonical Huffman coding which directly supports
+ * the output of the Huffman codes into a binary file. The frequencies,
+ * code lengths and codes are kept in dense arrays indexed by symbol.
  */
-class HuffmanCoding : public Huffman
+class HuffmanCoding
 {
 public:
 	/**
@@ -48,11 +48,14 @@ public:
 	~HuffmanCoding();
 
 	/**
-	 * Computes the Huffman tree with based on the number of occurrences of
-	 * each symbol of the input message. The number of occurrences are counted
-	 * using the method HuffmanCoding::countSymbol().
+	 * Computes the code lengths based on the number of occurrences of
+	 * each symbol of the input message and assigns the canonical Huffman
+	 * codes (see page 7 in DEFLATE specification). With the canonical codes
+	 * the Huffman coding can be reconstructed from an enumeration of its
+	 * code lengths. The number of occurrences are counted using the method
+	 * HuffmanCoding::countSymbol().
 	 */
-	void computeHuffmanTree();
+	void computeHuffmanCodes();
 
 	/**
 	 * Updates the number of occurrences counter for the given symbol.
@@ -74,30 +77,19 @@ public:
 	void writeHuffmanCode(const int symbol, bool isSymbol = false);
 
 	/**
-	 * Write an enumeration of the code lengths to the output file. With
-	 * this information the Huffman tree can be reconstructed at any time.
-	 * However, it is required to call HuffmanCoding::reorganizeHuffmanCodes()
-	 * before.
-	 * @param pHuffmanCoding an optional Huffman coding which is used to
-	 *  encode the enumeration of code lengths; if null, then a fixed-length
-	 *  coding is used
+	 * Returns the length of the Huffman code of the specified symbol (0 if
+	 * the symbol was not counted).
 	 */
-	void writeHuffmanTree(HuffmanCoding * pHuffmanCoding = 0);
-
-	/**
-	 * Reorganizes the Huffman codes of this Huffman coding (without reducing
-	 * the compression performance of the coding) in order to be able to
-	 * represent the Huffman tree by an enumeration of its code lengths
-	 * (see page 7 in DEFLATE specification).
-	 */
-	void reorganizeHuffmanCodes();
+	unsigned int getCodeLength(unsigned int symbol) {
+		return symbol < codeLengths.size() ? codeLengths[symbol] : 0;
+	};
 
 	/**
-	 * Returns a hash map allowing constant time access to the Huffman code
-	 * of a input symbol.
+	 * Returns the Huffman code of the specified symbol. The code is stored
+	 * in the HuffmanCoding::getCodeLength() least significant bits.
 	 */
-	HASH_S_H * getHuffmanTreeNodes() {
-		return pHashedHuffmanTreeNodes;
+	uint64_t getCode(unsigned int symbol) {
+		return symbol < codes.size() ? codes[symbol] : 0;
 	};
 
 	/**
@@ -111,34 +103,61 @@ public:
 	/**
 	 * Returns the length of the longest Huffman code of this Huffman coding.
 	 */
-	unsigned int getMaximumCodeLength();
+	unsigned int getMaximumCodeLength() {
+		return maximumCodeLength;
+	};
+
+#ifdef DEBUG
+	void printCoding();
+#endif
 
 private:
 	/**
-	 * Returns true if and only if the input symbol represented by the first
-	 * node occurs less often than the input symbol represented by the second
-	 * Huffman tree node. This method is used to sort the Huffman tree nodes.
+	 * Computes the length of the Huffman code of each symbol. The leaves
+	 * are sorted by frequency once, afterwards the Huffman tree is built
+	 * with two queues in linear time. Only the depths of its leaves are
+	 * kept.
 	 */
-	static bool cmpHuffmanTreeNodes(HuffmanTreeNode * pNode1,
-				HuffmanTreeNode * pNode2);
+	void computeCodeLengths();
 
 	/**
-	 * Adds a Huffman tree node for the specified input symbol.
+	 * Assigns the canonical Huffman codes based on the code lengths.
 	 */
-	HuffmanTreeNode * addHuffmanTreeNode(const unsigned int symbol);
+	void computeCanonicalCodes();
 
 	/**
-	 * Recursively computes the Huffman codes for the input symbols. This
-	 * method is called after the Huffman tree has been generated by the
-	 * HuffmanCoding::computeHuffmanTree() method.
+	 * Returns true if and only if the first leaf (a pair of frequency and
+	 * symbol) occurs less often than the second one. This method is used
+	 * to sort the leaves.
 	 */
-	void computeHuffmanCodes(HuffmanTreeNode * pNode,
-			const string &representation);
+	static bool cmpLeaves(const pair<unsigned int, unsigned int> & leaf1,
+			const pair<unsigned int, unsigned int> & leaf2);
 
 	/**
-	 * Keeps track of all Huffman tree nodes representing an input symbol.
+	 * The number of occurrences of each symbol.
 	 */
-	vector<HuffmanTreeNode*> * pHuffmanTreeNodesVector;
+	vector<unsigned int> frequencies;
+
+	/**
+	 * Indicates for each symbol whether it was counted (a symbol may be
+	 * counted with zero occurrences and still needs a code).
+	 */
+	vector<bool> counted;
+
+	/**
+	 * The counted symbols in the order of their first occurrence.
+	 */
+	vector<unsigned int> symbols;
+
+	/**
+	 * The length of the Huffman code of each symbol.
+	 */
+	vector<unsigned int> codeLengths;
+
+	/**
+	 * The Huffman code of each symbol.
+	 */
+	vector<uint64_t> codes;
 
 	/**
 	 * The bit writer to use to write out the Huffman codes.
@@ -162,4 +181,9 @@ private:
 	 * Huffman coding.
 	 */
 	unsigned int biggestDecimal;
+
+	/**
+	 * The length of the longest Huffman code.
+	 */
+	unsigned int maximumCodeLength;
 };
@@ -104,13 +104,9 @@ HuffmanSuccinctWriter::HuffmanSuccinctWriter(Grammar & dagGrammarPar,
 	countSymbolsInRankInfo(pHuffmanCodingProductions);
 	countSymbolsInNameInfo(pHuffmanCodingNames);
 
-	pHuffmanCodingStartProduction->computeHuffmanTree();
-	pHuffmanCodingProductions->computeHuffmanTree();
-	pHuffmanCodingNames->computeHuffmanTree();
-
-	pHuffmanCodingStartProduction->reorganizeHuffmanCodes();
-	pHuffmanCodingProductions->reorganizeHuffmanCodes();
-	pHuffmanCodingNames->reorganizeHuffmanCodes();
+	pHuffmanCodingStartProduction->computeHuffmanCodes();
+	pHuffmanCodingProductions->computeHuffmanCodes();
+	pHuffmanCodingNames->computeHuffmanCodes();
 
 	computeMaximalBaseCodeLength();
 
@@ -119,8 +115,7 @@ HuffmanSuccinctWriter::HuffmanSuccinctWriter(Grammar & dagGrammarPar,
 	countBaseHuffmanTree(pHuffmanCodingNames);
 	addValuesForRunlengthCoding(pSuperHuffmanCoding);
 
-	pSuperHuffmanCoding->computeHuffmanTree();
-	pSuperHuffmanCoding->reorganizeHuffmanCodes();
+	pSuperHuffmanCoding->computeHuffmanCodes();
 	writeSuperHuffmanTree();
 
 //	cout << "base Huffman coding for start production: " << endl;
@@ -176,8 +171,7 @@ void HuffmanSuccinctWriter::writeNumberOfTerminals(HuffmanCoding * pHuffmanCodin
 	}
 	else
 	{
-		/*bitWriter.writeBitString(decToBinary(Symbol::getNumberOfTerminals(),
-				CODE_LENGTH_BITS));*/
+		/*writeBinary(Symbol::getNumberOfTerminals(), CODE_LENGTH_BITS);*/
 		pHuffmanCoding->writeHuffmanCode(Symbol::getNumberOfTerminals(), false);
 	}
 }
@@ -209,7 +203,6 @@ void HuffmanSuccinctWriter::computeMaximalBaseCodeLength()
 
 void HuffmanSuccinctWriter::countBaseHuffmanTree(HuffmanCoding * pHuffmanCoding)
 {
-	HASH_S_H * pHashedHuffmanTreeNodes = pHuffmanCoding->getHuffmanTreeNodes();
 	unsigned int biggestDecimal = pHuffmanCoding->getBiggestDecimal();
 	unsigned int lastCodeLength = UINT_MAX;
 	unsigned int occurrences = 0;
@@ -217,17 +210,7 @@ void HuffmanSuccinctWriter::countBaseHuffmanTree(HuffmanCoding * pHuffmanCoding)
 	for (unsigned int symbol = 0; symbol <= biggestDecimal; symbol++)
 	{
 
-		HASH_S_H::iterator it = pHashedHuffmanTreeNodes->find(symbol);
-		unsigned int codeLength = 0;
-		if (it != pHashedHuffmanTreeNodes->end())
-		{
-			HuffmanTreeNode * pHuffmanTreeNode = it->second;
-			codeLength = pHuffmanTreeNode->getBitRepresentation().length();
-		}
-		else
-		{
-			// do nothing
-		}
+		unsigned int codeLength = pHuffmanCoding->getCodeLength(symbol);
 
 		if (lastCodeLength == codeLength)
 		{
@@ -320,7 +303,6 @@ void HuffmanSuccinctWriter::writeBaseHuffmanTree(HuffmanCoding * pHuffmanCoding)
 		fout << endl;
 	}
 
-	HASH_S_H * pHashedHuffmanTreeNodes = pHuffmanCoding->getHuffmanTreeNodes();
 	unsigned int biggestDecimal = pHuffmanCoding->getBiggestDecimal();
 	unsigned int lastCodeLength = UINT_MAX;
 	unsigned int occurrences = 0;
@@ -334,27 +316,14 @@ void HuffmanSuccinctWriter::writeBaseHuffmanTree(HuffmanCoding * pHuffmanCoding)
 	}
 	else
 	{
-		bitWriter.writeBitString(decToBinary(biggestDecimal + 1,
-				CODE_LENGTH_BITS));
+		writeBinary(biggestDecimal + 1, CODE_LENGTH_BITS);
 	}
 
 	// code lengths
 	for (unsigned int symbol = 0; symbol <= biggestDecimal; symbol++)
 	{
 
-		HASH_S_H::iterator it = pHashedHuffmanTreeNodes->find(symbol);
-		unsigned int codeLength = 0;
-		if (it != pHashedHuffmanTreeNodes->end())
-		{
-			HuffmanTreeNode * pHuffmanTreeNode = it->second;
-			codeLength = pHuffmanTreeNode->getBitRepresentation().length();
-
-			// cout << symbol << " : " << pHuffmanTreeNode->getBitRepresentation() << endl;
-		}
-		else
-		{
-			// do nothing
-		}
+		unsigned int codeLength = pHuffmanCoding->getCodeLength(symbol);
 
 		if (lastCodeLength == codeLength)
 		{
@@ -409,8 +378,8 @@ void HuffmanSuccinctWriter::writeBaseCodeLength(
 			{
 				pSuperHuffmanCoding->writeHuffmanCode(
 						maxBaseCodeLength + 1, false);
-				bitWriter.writeBitString(decToBinary(rlcMaxRepNonNullCodeLength
-						- RLC_MAX_RUN_LENGTH - 1, RLC_NON_NULL_CODE_LENGTH_BITS));
+				writeBinary(rlcMaxRepNonNullCodeLength
+						- RLC_MAX_RUN_LENGTH - 1, RLC_NON_NULL_CODE_LENGTH_BITS);
 				result--;
 
 				// cout << "runlength 1: " << runLength1Divisor << endl;
@@ -421,8 +390,8 @@ void HuffmanSuccinctWriter::writeBaseCodeLength(
 			{
 				pSuperHuffmanCoding->writeHuffmanCode(
 						maxBaseCodeLength + 1, false);
-				bitWriter.writeBitString(decToBinary(result
-						- RLC_MAX_RUN_LENGTH - 1, RLC_NON_NULL_CODE_LENGTH_BITS));
+				writeBinary(result
+						- RLC_MAX_RUN_LENGTH - 1, RLC_NON_NULL_CODE_LENGTH_BITS);
 
 				// cout << "runlength 1: " << result << endl;
 			}
@@ -439,8 +408,8 @@ void HuffmanSuccinctWriter::writeBaseCodeLength(
 			{
 				pSuperHuffmanCoding->writeHuffmanCode(
 						maxBaseCodeLength + 3, false);
-				bitWriter.writeBitString(decToBinary(rlcMaxRepNullCodeLengthMany
-						- rlcMaxRepNullCodeLengthFew - 1, RLC_NULL_CODE_LENGTH_MANY_BITS));
+				writeBinary(rlcMaxRepNullCodeLengthMany
+						- rlcMaxRepNullCodeLengthFew - 1, RLC_NULL_CODE_LENGTH_MANY_BITS);
 				result--;
 
 				// cout << "runlength 3: " << runLength3Val << endl;
@@ -451,8 +420,8 @@ void HuffmanSuccinctWriter::writeBaseCodeLength(
 			{
 				pSuperHuffmanCoding->writeHuffmanCode(
 						maxBaseCodeLength + 3, false);
-				bitWriter.writeBitString(decToBinary(result - rlcMaxRepNullCodeLengthFew
-						- 1, RLC_NULL_CODE_LENGTH_MANY_BITS));
+				writeBinary(result - rlcMaxRepNullCodeLengthFew
+						- 1, RLC_NULL_CODE_LENGTH_MANY_BITS);
 
 				// cout << "runlength 3: " << result << endl;
 			}
@@ -460,8 +429,8 @@ void HuffmanSuccinctWriter::writeBaseCodeLength(
 			{
 				pSuperHuffmanCoding->writeHuffmanCode(
 						maxBaseCodeLength + 2, false);
-				bitWriter.writeBitString(decToBinary(result
-						- RLC_MAX_RUN_LENGTH - 1, RLC_NULL_CODE_LENGTH_FEW_BITS));
+				writeBinary(result
+						- RLC_MAX_RUN_LENGTH - 1, RLC_NULL_CODE_LENGTH_FEW_BITS);
 
 				// cout << "runlength 2: " << result << endl;
 			}
@@ -499,12 +468,9 @@ void HuffmanSuccinctWriter::writeSuperHuffmanTree()
 	}
 	else
 	{
-		bitWriter.writeBitString(decToBinary(bitsPerCodeLength,
-				CODE_LENGTH_BITS));
+		writeBinary(bitsPerCodeLength, CODE_LENGTH_BITS);
 	}
 
-	HASH_S_H * pHashedHuffmanTreeNodes =
-			pSuperHuffmanCoding->getHuffmanTreeNodes();
 	unsigned int biggestDecimal =
 			pSuperHuffmanCoding->getBiggestDecimal();
 
@@ -515,8 +481,7 @@ void HuffmanSuccinctWriter::writeSuperHuffmanTree()
 	}
 	else
 	{
-		bitWriter.writeBitString(decToBinary(biggestDecimal + 1,
-				CODE_LENGTH_BITS));
+		writeBinary(biggestDecimal + 1, CODE_LENGTH_BITS);
 	}
 
 //	cout << "number of code lengths: " << biggestDecimal + 1 << endl;
@@ -525,19 +490,7 @@ void HuffmanSuccinctWriter::writeSuperHuffmanTree()
 	for (unsigned int symbol = 0; symbol <= biggestDecimal; symbol++)
 	{
 
-		HASH_S_H::iterator it = pHashedHuffmanTreeNodes->find(symbol);
-		int codeLength = 0;
-		if (it != pHashedHuffmanTreeNodes->end())
-		{
-			HuffmanTreeNode * pHuffmanTreeNode = it->second;
-			codeLength = pHuffmanTreeNode->getBitRepresentation().length();
-
-			// cout << symbol << " : " << pHuffmanTreeNode->getBitRepresentation() << endl;
-		}
-		else
-		{
-			// do nothing
-		}
+		int codeLength = pSuperHuffmanCoding->getCodeLength(symbol);
 
 		writeSuperCodeLength(codeLength, bitsPerCodeLength);
 
@@ -558,28 +511,13 @@ void HuffmanSuccinctWriter::writeSuperCodeLength(const int n,
 	}
 	else
 	{
-		bitWriter.writeBitString(decToBinary(n, bitsPerCodeLength));
+		writeBinary(n, bitsPerCodeLength);
 	}
 }
 
 unsigned int HuffmanSuccinctWriter::computeBitsPerSuperCodeLength()
 {
-	HASH_S_H * pHashedHuffmanTreeNodes = pSuperHuffmanCoding->getHuffmanTreeNodes();
-
-	unsigned int maxCodeLength = 0;
-
-	HASH_S_H::iterator it;
-	for (it = pHashedHuffmanTreeNodes->begin(); it
-			!= pHashedHuffmanTreeNodes->end(); ++it)
-	{
-		HuffmanTreeNode * pHuffmanTreeNode = it->second;
-		unsigned int currentCodeLength =
-				pHuffmanTreeNode->getBitRepresentation().length();
-		if (currentCodeLength > maxCodeLength)
-		{
-			maxCodeLength = currentCodeLength;
-		}
-	}
+	unsigned int maxCodeLength = pSuperHuffmanCoding->getMaximumCodeLength();
 
 	// + 1 since ceil(log2(16)) is 4 but needs 5 bits
 	return calculateNeededBits(maxCodeLength);
@@ -669,15 +607,15 @@ void HuffmanSuccinctWriter::writeRankInfo(HuffmanCoding * pHuffmanCoding)
 {
 	// TODO optimize dont count symbols when constructing huffman tree
 	// and when writing out (i.e. don't do it twice)
-	bitWriter.writeBitString(string("00"));
+	bitWriter.writeBits(0, 2);
 	pHuffmanCoding->writeHuffmanCode(countSymbols(false, false), false);
 	writeRankInfoAux(pHuffmanCoding, false, false);
 
-	bitWriter.writeBitString(string("01"));
+	bitWriter.writeBits(1, 2);
 	pHuffmanCoding->writeHuffmanCode(countSymbols(false, true), false);
 	writeRankInfoAux(pHuffmanCoding, false, true);
 
-	bitWriter.writeBitString(string("10"));
+	bitWriter.writeBits(2, 2);
 	pHuffmanCoding->writeHuffmanCode(countSymbols(true, false), false);
 	writeRankInfoAux(pHuffmanCoding, true, false);
 }
@@ -720,12 +658,12 @@ void HuffmanSuccinctWriter::writeNameInfo(HuffmanCoding * pHuffmanCoding)
 	}
 }
 
-string HuffmanSuccinctWriter::decToBinary(const unsigned int n,
+void HuffmanSuccinctWriter::writeBinary(const unsigned int n,
 		unsigned int numberOfBits)
 {
 
 	// #ifdef DEBUG
-	if (n > (pow(2.0, (int) numberOfBits) - 1))
+	if (numberOfBits < 32 && (n >> numberOfBits) != 0)
 	{
 		cout << "Error: Couldn't encode decimal " << n << ". "
 			"Not enough available bits. Exiting ..." << endl;
@@ -733,22 +671,7 @@ string HuffmanSuccinctWriter::decToBinary(const unsigned int n,
 	}
 	// #endif
 
-	int rem = n;
-	string bitStr = "";
-	for (int e = (numberOfBits - 1); e >= 0; e--)
-	{
-		if (((double) rem / pow(2.0, e)) >= 1.0)
-		{
-			bitStr += "1";
-			rem = rem - (int) floor(pow(2.0, e));
-		}
-		else
-		{
-			bitStr += "0";
-		}
-	}
-
-	return bitStr;
+	bitWriter.writeBits(n, numberOfBits);
 }
 
 unsigned int HuffmanSuccinctWriter::countSymbols(bool leftChild,
@@ -49,16 +49,14 @@ protected:
 
 private:
 	/**
-	 * Converts the specified integer to a bit string of the
-	 * specified length.
-	 * @param n the integer to convert
+	 * Writes the specified integer as a binary number of the
+	 * specified length using the bit writer.
+	 * @param n the integer to write
 	 * @param numberOfBits Specifies the number of bits to use. If not
 	 *  sufficient an error message is produced and the application
 	 *  exits.
-	 * @returns the binary representation of the input value
 	 */
-	static string decToBinary(const unsigned int n,
-			unsigned int numberOfBits);
+	void writeBinary(const unsigned int n, unsigned int numberOfBits);
 
 	/**
 	 * Computes the number of bits needed to represent the specified
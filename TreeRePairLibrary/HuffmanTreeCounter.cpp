@@ -28,34 +28,17 @@
 HuffmanTreeCounter::HuffmanTreeCounter(Grammar * grammarPar,
 		HuffmanCoding * pHuffmanCodingPar,
 		TreeNode * pRootPar) :
-	TreeTraversal(pRootPar), dagGrammar(grammarPar), pHuffmanCoding(pHuffmanCodingPar)
+	dagGrammar(grammarPar), pHuffmanCoding(pHuffmanCodingPar)
 {
-	traverseTree();
+	traverseTree(pRootPar);
 }
 
 HuffmanTreeCounter::~HuffmanTreeCounter(void)
 {
 }
 
-void HuffmanTreeCounter::processNode(TreeNode * pParent, unsigned int index,
-		int depth, bool closing)
+void HuffmanTreeCounter::preVisit(TreeNode * pNode, unsigned int index, int depth)
 {
-
-	TreeNode * pNode;
-	if (index != UINT_MAX)
-	{
-		pNode = pParent->getChild(index);
-	}
-	else
-	{
-		pNode = pParent;
-	}
-
-	if (closing)
-	{
-		return;
-	}
-
 	if (dagGrammar != 0 && dagGrammar->isNonTerminal(pNode->getSymbol())) {
 		Production * pProduction = dagGrammar->getProductionBySymbol(pNode->getSymbol());
 		HuffmanTreeCounter treeCounter(dagGrammar, pHuffmanCoding, pProduction->getRightHandSide());
@@ -19,7 +19,7 @@
 #pragma once
 
 #include "HuffmanCoding.h"
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "TreeRePairTypes.h"
 
 #include <vector>
@@ -30,8 +30,10 @@
  * of occurrences counter of the specified Huffman coding.
  */
 class HuffmanTreeCounter
-	: TreeTraversal
+	: public StaticTreeTraversal<HuffmanTreeCounter>
 {
+	friend class StaticTreeTraversal<HuffmanTreeCounter>;
+
 public:
 	/**
 	 * The constructor of the class.
@@ -47,7 +49,7 @@ public:
 	~HuffmanTreeCounter(void);
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
 	/**
@@ -27,35 +27,18 @@
 HuffmanTreeWriter::HuffmanTreeWriter(Grammar * grammarPar,
 		HuffmanCoding * pHuffmanCodingPar,
 		BitWriter & bitWriterPar, TreeNode * pRootPar) :
-	TreeTraversal(pRootPar), dagGrammar(grammarPar), pHuffmanCoding(pHuffmanCodingPar), bitWriter(
+	dagGrammar(grammarPar), pHuffmanCoding(pHuffmanCodingPar), bitWriter(
 			bitWriterPar)
 {
-	traverseTree();
+	traverseTree(pRootPar);
 }
 
 HuffmanTreeWriter::~HuffmanTreeWriter(void)
 {
 }
 
-void HuffmanTreeWriter::processNode(TreeNode * pParent, unsigned int index,
-		int depth, bool closing)
+void HuffmanTreeWriter::preVisit(TreeNode * pNode, unsigned int index, int depth)
 {
-
-	TreeNode * pNode;
-	if (index != UINT_MAX)
-	{
-		pNode = pParent->getChild(index);
-	}
-	else
-	{
-		pNode = pParent;
-	}
-
-	if (closing)
-	{
-		return;
-	}
-
 	if (dagGrammar != 0 && dagGrammar->isNonTerminal(pNode->getSymbol())) {
 		Production * pProduction = dagGrammar->getProductionBySymbol(pNode->getSymbol());
 		HuffmanTreeWriter treeWriter(dagGrammar, pHuffmanCoding, bitWriter, pProduction->getRightHandSide());
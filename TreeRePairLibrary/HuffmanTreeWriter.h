@@ -20,15 +20,17 @@
 
 #include "HuffmanCoding.h"
 #include "BitWriter.h"
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "TreeRePairTypes.h"
 #include "Grammar.h"
 
 /**
  * This class uses a Huffman coding to write out a tree.
  */
-class HuffmanTreeWriter : TreeTraversal
+class HuffmanTreeWriter : public StaticTreeTraversal<HuffmanTreeWriter>
 {
+	friend class StaticTreeTraversal<HuffmanTreeWriter>;
+
 public:
 	/**
 	 * The constructor.
@@ -48,8 +50,7 @@ public:
 	~HuffmanTreeWriter(void);
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth,
-			bool closing);
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
 	/**
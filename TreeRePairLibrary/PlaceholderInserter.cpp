@@ -22,7 +22,7 @@
 #include "Production.h"
 
 PlaceholderInserter::PlaceholderInserter(Grammar & dagGrammarPar) :
-	TreeTraversal(0), dagGrammar(dagGrammarPar) // , justCount(false)
+	dagGrammar(dagGrammarPar) // , justCount(false)
 {
 	HASH_ST_VS symbolsHashMap;
 
@@ -84,9 +84,8 @@ PlaceholderInserter::PlaceholderInserter(Grammar & dagGrammarPar) :
 //					if (counter < 20) {
 //						justCount = false;
 						for (unsigned int j = 0; j < dagGrammar.size(); j++) {
-							pRoot = dagGrammar[j]->getRightHandSide();
 							pCurrentProduction = dagGrammar[j];
-							traverseTree();
+							traverseTree(dagGrammar[j]->getRightHandSide());
 						}
 //					}
 
@@ -103,25 +102,8 @@ PlaceholderInserter::~PlaceholderInserter(void)
 {
 }
 
-void PlaceholderInserter::processNode(TreeNode * pParent, unsigned int index,
-		int depth, bool closing)
+void PlaceholderInserter::postVisit(TreeNode * pNode, unsigned int index, int depth)
 {
-
-	TreeNode * pNode;
-	if (index != UINT_MAX)
-	{
-		pNode = pParent->getChild(index);
-	}
-	else
-	{
-		pNode = pParent;
-	}
-
-	if (!closing)
-	{
-		return;
-	}
-
 	if (pNode->getSymbol() == pOldSymbol) {
 
 //		if (justCount) {
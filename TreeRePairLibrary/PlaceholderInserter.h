@@ -18,7 +18,7 @@
  */
 #pragma once
 
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "TreeRePairTypes.h"
 #include "Grammar.h"
 
@@ -29,8 +29,10 @@
  * place holder nodes at the corresponding children positions.
  */
 class PlaceholderInserter
-	: TreeTraversal
+	: public StaticTreeTraversal<PlaceholderInserter>
 {
+	friend class StaticTreeTraversal<PlaceholderInserter>;
+
 public:
 	/**
 	 * The constructor.
@@ -40,7 +42,7 @@ public:
 	~PlaceholderInserter(void);
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void postVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
 	/**
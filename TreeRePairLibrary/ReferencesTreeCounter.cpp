@@ -22,51 +22,88 @@
 #include "HuffmanSuccinctWriter.h"
 #include "Production.h"
 
+#include <deque>
+
 ReferencesTreeCounter::ReferencesTreeCounter(TreeNode * pRootPar,
 		Grammar * dagGrammarPar, Grammar & mainGrammarPar) :
-	TreeTraversal(pRootPar), dagGrammar(dagGrammarPar), mainGrammar(mainGrammarPar)
+	dagGrammar(dagGrammarPar), mainGrammar(mainGrammarPar),
+	currentUnit(0)
 {
-	traverseTree();
+	countReferences(pRootPar);
 }
 
 ReferencesTreeCounter::~ReferencesTreeCounter(void)
 {
 }
 
-void ReferencesTreeCounter::processNode(TreeNode * pParent, unsigned int index,
-		int depth, bool closing)
+void ReferencesTreeCounter::countReferences(TreeNode * pRootPar)
 {
+	unitRoots.push_back(pRootPar);
+	referencedUnits.resize(1);
+	referencingNodes.resize(1);
+	pendingReferences.push_back(0);
 
-	TreeNode * pNode;
-	if (index != UINT_MAX)
-	{
-		pNode = pParent->getChild(index);
-	}
-	else
-	{
-		pNode = pParent;
+	// traverse every unit exactly once, new units are appended while
+	// traversing the ones found so far
+	for (currentUnit = 0; currentUnit < unitRoots.size(); currentUnit++) {
+		traverseTree(unitRoots[currentUnit]);
 	}
 
-	if (closing)
-	{
-		return;
-	}
+	// propagate the multiplicities in topological order, i.e., a unit is
+	// processed after all units referencing it have been processed
+	multiplicities.assign(unitRoots.size(), 0);
+	multiplicities[0] = 1;
+
+	deque<unsigned int> readyUnits;
+	readyUnits.push_back(0);
+
+	while (!readyUnits.empty()) {
+		unsigned int unit = readyUnits.front();
+		readyUnits.pop_front();
+		unsigned int multiplicity = multiplicities[unit];
+
+		vector<TreeNode *> & nodes = referencingNodes[unit];
+		for (unsigned int i = 0; i < nodes.size(); i++) {
+			Production * pProduction = mainGrammar.getProductionBySymbol(nodes[i]->getSymbol());
+			pProduction->setRefCount(pProduction->getRefCount() + multiplicity);
+			pProduction->addRefNode(nodes[i]);
+		}
 
-	if (dagGrammar != 0 && dagGrammar->isNonTerminal(pNode->getSymbol())) {
-		Production * pProduction = dagGrammar->getProductionBySymbol(pNode->getSymbol());
-		ReferencesTreeCounter treeCounter(pProduction->getRightHandSide(), dagGrammar, mainGrammar);
-	} else {
-		countReference(pNode);
+		vector<unsigned int> & units = referencedUnits[unit];
+		for (unsigned int i = 0; i < units.size(); i++) {
+			multiplicities[units[i]] += multiplicity;
+			if (--pendingReferences[units[i]] == 0) {
+				readyUnits.push_back(units[i]);
+			}
+		}
 	}
 }
 
-void ReferencesTreeCounter::countReference(TreeNode * pNode) {
+unsigned int ReferencesTreeCounter::getUnitIndex(Production * pProduction)
+{
+	unsigned int id = pProduction->getLeftHandSide()->getId();
+	HASH_I_I::iterator it = unitIndexes.find(id);
+	if (it != unitIndexes.end()) {
+		return it->second;
+	}
+
+	unsigned int unit = unitRoots.size();
+	unitIndexes[id] = unit;
+	unitRoots.push_back(pProduction->getRightHandSide());
+	referencedUnits.resize(unit + 1);
+	referencingNodes.resize(unit + 1);
+	pendingReferences.push_back(0);
+	return unit;
+}
 
+void ReferencesTreeCounter::preVisit(TreeNode * pNode, unsigned int index, int depth)
+{
 	Symbol * pSymbol = pNode->getSymbol();
-	if (mainGrammar.isNonTerminal(pSymbol)) {
-		Production * pProduction = mainGrammar.getProductionBySymbol(pSymbol);
-		pProduction->incrementRefCount();
-		pProduction->addRefNode(pNode);
+	if (dagGrammar != 0 && dagGrammar->isNonTerminal(pSymbol)) {
+		unsigned int unit = getUnitIndex(dagGrammar->getProductionBySymbol(pSymbol));
+		referencedUnits[currentUnit].push_back(unit);
+		pendingReferences[unit]++;
+	} else if (mainGrammar.isNonTerminal(pSymbol)) {
+		referencingNodes[currentUnit].push_back(pNode);
 	}
-
 }
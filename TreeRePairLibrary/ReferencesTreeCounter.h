@@ -18,7 +18,7 @@
  */
 #pragma once
 
-#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
 #include "TreeRePairTypes.h"
 #include "Grammar.h"
 
@@ -26,10 +26,18 @@
  * This class is used to count the references count of the productions
  * generated during the replacement step, i.e., it is determined how many
  * nodes are labeled with the left-hand side of a certain production.
+ *
+ * The right-hand side of every production of the optional DAG grammar
+ * is traversed only once. The references found in it are weighted by the
+ * number of times the production is referenced in the tree represented by
+ * the DAG. These multiplicities are propagated in topological order
+ * without recursion, i.e., deep DAGs cannot overflow the stack.
  */
 class ReferencesTreeCounter
-	: TreeTraversal
+	: public StaticTreeTraversal<ReferencesTreeCounter>
 {
+	friend class StaticTreeTraversal<ReferencesTreeCounter>;
+
 public:
 	/**
 	 * The constructor.
@@ -46,15 +54,24 @@ public:
 	~ReferencesTreeCounter(void);
 
 protected:
-	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing);
+	void preVisit(TreeNode * pNode, unsigned int index, int depth);
 
 private:
 	/**
-	 * Checks if the specified node is labeled by a nonterminal of the main
-	 * grammar and if so updates the reference counter of the corresponding
-	 * production.
+	 * Traverses the specified tree and the right-hand sides of all
+	 * productions of the DAG grammar reachable from it (each of them
+	 * exactly once) and updates the reference counters of the productions
+	 * of the main grammar.
 	 */
-	void countReference(TreeNode * pNode);
+	void countReferences(TreeNode * pRoot);
+
+	/**
+	 * Returns the index of the unit (i.e., the tree to traverse or the
+	 * right-hand side of a production of the DAG grammar) for the specified
+	 * production of the DAG grammar. A new unit is created if the production
+	 * was not encountered before.
+	 */
+	unsigned int getUnitIndex(Production * pProduction);
 
 	/**
 	 * The optional grammar whose nonterminals are
@@ -69,4 +86,44 @@ private:
 	 * number of occurrences shall be determined.
 	 */
 	Grammar & mainGrammar;
+
+	/**
+	 * The roots of the units. The first unit is the tree to traverse, the
+	 * others are right-hand sides of productions of the DAG grammar.
+	 */
+	vector<TreeNode *> unitRoots;
+
+	/**
+	 * Maps the ids of the left-hand sides of the productions of the DAG
+	 * grammar to the indexes of the corresponding units.
+	 */
+	HASH_I_I unitIndexes;
+
+	/**
+	 * For each unit, the indexes of the units referenced by it (one entry
+	 * per referencing node).
+	 */
+	vector<vector<unsigned int> > referencedUnits;
+
+	/**
+	 * For each unit, the nodes labeled by a nonterminal of the main grammar.
+	 */
+	vector<vector<TreeNode *> > referencingNodes;
+
+	/**
+	 * For each unit, the number of references from units which have not
+	 * been processed yet.
+	 */
+	vector<unsigned int> pendingReferences;
+
+	/**
+	 * For each unit, the number of times it occurs in the tree represented
+	 * by the first unit and the DAG grammar.
+	 */
+	vector<unsigned int> multiplicities;
+
+	/**
+	 * The index of the unit currently traversed.
+	 */
+	unsigned int currentUnit;
 };
@@ -0,0 +1,97 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "ReplacementTracer.h"
+
+#include "Symbol.h"
+#include "TreeRePairConstants.h"
+
+#include <iostream>
+#include <stdio.h>
+
+ReplacementTracer::ReplacementTracer(const char * pFilePath) :
+	bufferLength(0), iteration(0), lastTime(0)
+{
+	fout.open(pFilePath, ios::out | ios::binary);
+	if (!fout.is_open())
+	{
+		cout << "Could not open trace file " << pFilePath << ". Exiting ..." << endl;
+		exit(1);
+	}
+
+	pBuffer = new char[TRACE_BUFFER_SIZE];
+
+	bufferLength = snprintf(pBuffer, TRACE_BUFFER_SIZE, "iteration,parent,index,"
+			"child,occurrences,replaced,deregistered,registered,scan_length,"
+			"nanoseconds\n");
+}
+
+ReplacementTracer::~ReplacementTracer()
+{
+	flush();
+	fout.close();
+	delete[] pBuffer;
+}
+
+void ReplacementTracer::start()
+{
+	lastTime = now();
+}
+
+void ReplacementTracer::recordIteration(Digram * pDigram,
+		unsigned int numberOfOccs, unsigned int replaced,
+		unsigned int deregistered, unsigned int registered,
+		unsigned int scanLength)
+{
+	unsigned long long currentTime = now();
+
+	// a line never exceeds 128 characters
+	if (bufferLength + 128 > TRACE_BUFFER_SIZE)
+	{
+		flush();
+	}
+
+	bufferLength += snprintf(pBuffer + bufferLength,
+			TRACE_BUFFER_SIZE - bufferLength, "%u,%u,%u,%u,%u,%u,%u,%u,%u,%llu\n",
+			iteration, pDigram->getParentSymbol()->getId(),
+			pDigram->getChildIndex(), pDigram->getChildSymbol()->getId(),
+			numberOfOccs, replaced, deregistered, registered, scanLength,
+			currentTime - lastTime);
+
+	iteration++;
+
+	// do not account the time needed for recording to the next iteration
+	lastTime = now();
+}
+
+void ReplacementTracer::flush()
+{
+	fout.write(pBuffer, bufferLength);
+	bufferLength = 0;
+}
+
+unsigned long long ReplacementTracer::now()
+{
+#if !defined(__GNUC__)
+	return ((unsigned long long) clock()) * (1000000000ULL / CLOCKS_PER_SEC);
+#else
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec * 1000000000ULL + time.tv_nsec;
+#endif
+}
@@ -0,0 +1,111 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#pragma once
+
+#include "Digram.h"
+
+#include <fstream>
+#include <time.h>
+
+using namespace std;
+
+/**
+ * This class records a trace of the digram replacement loop (see
+ * DigramReplacer). For every iteration, one line is appended to a
+ * CSV file containing the chosen digram, its number of occurrences,
+ * the number of occurrences actually replaced, the number of
+ * occurrences deregistered and registered, the number of digram lists
+ * and digrams inspected by DigramPriorityQueue::top() and the elapsed
+ * time in nanoseconds. The lines are collected in a buffer which is
+ * written to the file only if it is full.
+ */
+class ReplacementTracer
+{
+public:
+	/**
+	 * The constructor.
+	 * @param pFilePath the file to which the trace shall be written
+	 */
+	ReplacementTracer(const char * pFilePath);
+
+	/**
+	 * The destructor. It flushes the buffer and closes the file.
+	 */
+	virtual ~ReplacementTracer();
+
+	/**
+	 * Marks the beginning of the first iteration. It must be called
+	 * before the first digram is retrieved from the priority queue.
+	 */
+	void start();
+
+	/**
+	 * Records one iteration. The elapsed time is measured since the
+	 * last call of this method or of start().
+	 * @param pDigram the digram replaced during the iteration
+	 * @param numberOfOccs the number of occurrences of the digram
+	 *  reported by the priority queue
+	 * @param replaced the number of occurrences actually replaced
+	 * @param deregistered the number of occurrences removed from the
+	 *  sets occ_t of other digrams
+	 * @param registered the number of occurrences added to the sets
+	 *  occ_t of other digrams
+	 * @param scanLength the number of digram lists and digrams inspected
+	 *  by the priority queue in order to retrieve the digram
+	 */
+	void recordIteration(Digram * pDigram, unsigned int numberOfOccs,
+			unsigned int replaced, unsigned int deregistered,
+			unsigned int registered, unsigned int scanLength);
+
+private:
+	/**
+	 * Writes the contents of the buffer to the file.
+	 */
+	void flush();
+
+	/**
+	 * Returns the current time of a monotonic clock in nanoseconds.
+	 */
+	static unsigned long long now();
+
+	/**
+	 * The output stream of the trace file.
+	 */
+	ofstream fout;
+
+	/**
+	 * The buffer collecting the lines of the trace.
+	 */
+	char * pBuffer;
+
+	/**
+	 * The number of characters currently held by the buffer.
+	 */
+	unsigned int bufferLength;
+
+	/**
+	 * The number of iterations recorded so far.
+	 */
+	unsigned int iteration;
+
+	/**
+	 * The time of the last call of recordIteration() or start().
+	 */
+	unsigned long long lastTime;
+};
@@ -18,7 +18,7 @@
  */
 #include "Statistics.h"
 
-#include "EdgeCounter.h"
+#include "ExpandedEdgeCounter.h"
 #include "Helper.h"
 #include "Production.h"
 
@@ -34,11 +34,9 @@ Statistics::Statistics(const char * pFilePathPar,
 	pFilePath(pFilePathPar), timeInSeconds(timeInSecondsPar),
 	numberOfInputEdges(numberOfInputEdgesPar), mode(modePar), memVmRSS(0)
 {
-	EdgeCounter edgeCounter(&dagGrammar);
-	edgeCounter.countEdges(dagGrammar[0]->getRightHandSide());
-	edgeCounter.countEdges(mainGrammar);
-
-	edgesOutputSize = edgeCounter.getNumberOfEdges();
+	ExpandedEdgeCounter edgeCounter(dagGrammar);
+	edgesOutputSize = edgeCounter.countEdges(dagGrammar[0]->getRightHandSide())
+			+ edgeCounter.countEdges(mainGrammar);
 
 	computeEdgesCompression();
 
@@ -48,7 +46,7 @@ Statistics::Statistics(const char * pFilePathPar,
 
 	numberOfNonTerminals = mainGrammar.size() + 1;
 
-	computeInitialSize(dagGrammar);
+	computeInitialSize(edgeCounter, dagGrammar);
 	computeInitialSizeFactor();
 }
 
@@ -107,11 +105,9 @@ void Statistics::computeFilesystemInputSize()
 	filesystemInputSize = Helper::getFileSize(pFilePath);
 }
 
-void Statistics::computeInitialSize(Grammar & dagGrammar)
+void Statistics::computeInitialSize(ExpandedEdgeCounter & edgeCounter, Grammar & dagGrammar)
 {
-	EdgeCounter edgeCounter(&dagGrammar);
-	edgeCounter.countEdges(dagGrammar[0]->getRightHandSide());
-	initialSize = edgeCounter.getNumberOfEdges();
+	initialSize = edgeCounter.countEdges(dagGrammar[0]->getRightHandSide());
 }
 
 void Statistics::computeEdgesCompression()
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "Grammar.h"
+#include "ExpandedEdgeCounter.h"
 #include "TreeRePairMacros.h"
 
 /**
@@ -237,8 +238,10 @@ private:
 	/**
 	 * Computes the size (number of edges) of the right-hand side
 	 * of the start production of the generated grammar.
+	 * @param edgeCounter the counter providing the sizes of the
+	 *  subtrees represented by the nonterminals of the DAG grammar
 	 */
-	void computeInitialSize(Grammar & dagGrammar);
+	void computeInitialSize(ExpandedEdgeCounter & edgeCounter, Grammar & dagGrammar);
 
 	/**
 	 * Computes the factor with respect to the size of the input tree
@@ -19,6 +19,9 @@
 #include "TreeRePairAlgorithm.h"
 
 #include "XMLTreeParser.h"
+#include "GrammarDagConstructor.h"
+#include "HuffmanSuccinctReader.h"
+#include "BplexGrammarReader.h"
 
 #include "Helper.h"
 #include "Statistics.h"
@@ -38,6 +41,7 @@
 
 #include "TreeRePairMode.h"
 #include "TreeRePairConstants.h"
+#include "Profiler.h"
 
 #include <fstream>
 #include <time.h>
@@ -46,7 +50,19 @@
 using namespace std;
 
 TreeRePairAlgorithm::TreeRePairAlgorithm(char * pFilePathPar) :
-	pFilePath(pFilePathPar), nodeCount(0)
+	pFilePath(pFilePathPar), pSyntheticTreeParameters(0), nodeCount(0)
+{
+	compress();
+}
+
+TreeRePairAlgorithm::TreeRePairAlgorithm(char * pFilePathPar,
+		const SyntheticTreeParameters & parameters) :
+	pFilePath(pFilePathPar), pSyntheticTreeParameters(&parameters), nodeCount(0)
+{
+	compress();
+}
+
+void TreeRePairAlgorithm::compress()
 {
 	TreeRePairMode::getInstance()->setAlgMode(TreeRePairMode::COMPRESS);
 
@@ -68,7 +84,12 @@ TreeRePairAlgorithm::TreeRePairAlgorithm(char * pFilePathPar) :
 
 	pDigramHashMap = new HASH_D_D;
 
+	Profiler * pProfiler = Profiler::getInstance();
+
+	pProfiler->startPhase("parse");
 	parseInput();
+	pProfiler->stopPhase();
+	pProfiler->setCounter("nodes_parsed", nodeCount);
 	
 	// for testing purposes only
 	// DegeneratedTreeGenerator generator(dagGrammar, 8192);
@@ -94,7 +115,12 @@ TreeRePairAlgorithm::TreeRePairAlgorithm(char * pFilePathPar) :
 
 	if (TreeRePairMode::getInstance()->isUseDag())
 	{
+		pProfiler->startPhase("dag_pruning");
+		unsigned int dagProductions = dagGrammar.size();
 		pruneDagGrammar();
+		pProfiler->stopPhase();
+		pProfiler->setCounter("dag_productions_pruned",
+				dagProductions - dagGrammar.size());
 	}
 
 //	dag unfolding test
@@ -114,6 +140,7 @@ TreeRePairAlgorithm::TreeRePairAlgorithm(char * pFilePathPar) :
 	// experimental
 	// PlaceholderInserter inserter(dagGrammar);
 
+	pProfiler->startPhase("initial_counting");
 	pPriorityQueue = new DigramPriorityQueue(nodeCount, pDigramHashMap);
 
 	if (TreeRePairMode::getInstance()->isVerboseMode())
@@ -122,21 +149,32 @@ TreeRePairAlgorithm::TreeRePairAlgorithm(char * pFilePathPar) :
 	}
 
 	pDigramCounter = new DigramCounter(dagGrammar, pDigramHashMap, pPriorityQueue);
+	pProfiler->stopPhase();
 
 	if (TreeRePairMode::getInstance()->isVerboseMode())
 	{
 		cout << "Replacing digrams ..." << endl;
 	}
 
+	pProfiler->startPhase("replacement");
 	DigramReplacer digramReplacer(pPriorityQueue, pDigramCounter,
 			pDigramHashMap, dagGrammar, mainGrammar);
+	pProfiler->stopPhase();
+	pProfiler->setCounter("digrams_created",
+			pDigramCounter->getNumberOfCreatedDigrams());
+	pProfiler->setCounter("productions_introduced", mainGrammar.size());
 
 	// Helper::printDigramsHashMap(pDigramHashMap);
 	// Production::print(cout, dagGrammar[0]);
 
 
 	if (TreeRePairMode::getInstance()->getOptimizationMode() != TreeRePairMode::OPTIMIZE_DISABLE) {
+		pProfiler->startPhase("grammar_pruning");
+		unsigned int productions = mainGrammar.size();
 		pruneGrammar();
+		pProfiler->stopPhase();
+		pProfiler->setCounter("productions_pruned",
+				productions - mainGrammar.size());
 	}
 
 	//for (unsigned int i = 0; i < dagGrammar.size(); i++) {
@@ -145,7 +183,13 @@ TreeRePairAlgorithm::TreeRePairAlgorithm(char * pFilePathPar) :
 	//	Production::print(cout, pProduction);
 	//}
 
-	HuffmanSuccinctWriter succinctWriter(dagGrammar, mainGrammar, pFilePath);
+	pProfiler->startPhase("huffman_encoding");
+	{
+		HuffmanSuccinctWriter succinctWriter(dagGrammar, mainGrammar, pFilePath);
+	}
+	pProfiler->stopPhase();
+	pProfiler->setCounter("bytes_written", Helper::getFileSize(
+			Helper::getFilePathForBinary(pFilePath).c_str()));
 
 	if (TreeRePairMode::getInstance()->useTextualGrammar())
 	{
@@ -170,6 +214,11 @@ TreeRePairAlgorithm::TreeRePairAlgorithm(char * pFilePathPar) :
 #endif
 
 	writeStatistics((unsigned int) timeInMilliseconds, numberOfInputEdges);
+
+	if (TreeRePairMode::getInstance()->getProfileFilePath() != 0)
+	{
+		pProfiler->writeJsonFile(TreeRePairMode::getInstance()->getProfileFilePath());
+	}
 }
 
 TreeRePairAlgorithm::~TreeRePairAlgorithm(void)
@@ -188,10 +237,15 @@ TreeRePairAlgorithm::~TreeRePairAlgorithm(void)
 	delete pPriorityQueue;
 	delete pDigramHashMap;
 
+	// the trees of the grammars still reference the symbols
+	dagGrammar.deleteProductions();
+	mainGrammar.deleteProductions();
+
 	Helper::deleteSymbols();
 
 	delete pDigramCounter;
 
+	Profiler::deleteInstance();
 	TreeRePairMode::deleteInstance();
 }
 
@@ -231,9 +285,52 @@ void TreeRePairAlgorithm::writeStatistics(unsigned int timeInMilliseconds,
 
 void TreeRePairAlgorithm::parseInput()
 {
+	if (pSyntheticTreeParameters != 0) {
+		SyntheticTreeGenerator generator(dagGrammar, *pSyntheticTreeParameters);
+		nodeCount = generator.getNodeCount();
+		return;
+	}
+
+	string filePath(pFilePath);
+	bool isSuccinctGrammar = hasExtension(filePath, ".rep");
+	bool isBplexGrammar = hasExtension(filePath, ".g");
+
+	if (!isSuccinctGrammar && !isBplexGrammar) {
+		XMLTreeParser xmlParser(pFilePath, dagGrammar);
+		nodeCount = xmlParser.getNodeCount();
+		return;
+	}
+
+	// an existing grammar is converted into the DAG of the tree it
+	// represents without decompressing it, its productions are deleted
+	// when leaving this method
+	Symbol::getStartSymbol();
+	Grammar inputDagGrammar;
+	Grammar inputMainGrammar;
+	if (isSuccinctGrammar) {
+		HuffmanSuccinctReader reader(pFilePath, inputDagGrammar, inputMainGrammar);
+	} else {
+		BplexGrammarReader reader(pFilePath, inputDagGrammar, inputMainGrammar);
+	}
 
-	XMLTreeParser xmlParser(pFilePath, dagGrammar);
-	nodeCount = xmlParser.getNodeCount();
+	GrammarDagConstructor constructor(inputDagGrammar, inputMainGrammar,
+			dagGrammar);
+	nodeCount = constructor.getNodeCount();
+
+	if (TreeRePairMode::getInstance()->isVerboseMode()) {
+		cout << "Input grammar with " << inputMainGrammar.size() + 1
+				<< " productions and " << constructor.getInputSize()
+				<< " nodes represents a binary DAG with "
+				<< constructor.getNumberOfClasses() << " nodes." << endl;
+	}
+}
+
+bool TreeRePairAlgorithm::hasExtension(const string & filePath,
+		const string & extension)
+{
+	return filePath.length() > extension.length()
+			&& filePath.compare(filePath.length() - extension.length(),
+					extension.length(), extension) == 0;
 }
 
 void TreeRePairAlgorithm::pruneGrammar()
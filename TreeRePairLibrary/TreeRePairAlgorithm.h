@@ -31,6 +31,7 @@
 
 class XMLTreeParser;
 class Statistics;
+struct SyntheticTreeParameters;
 
 /*! \mainpage TreeRePair Distribution API Reference
  *
@@ -52,16 +53,40 @@ public:
 	 */
 	TreeRePairAlgorithm(char * pFilePath);
 
+	/**
+	 * A constructor which compresses a synthetic tree instead of an
+	 * input XML document (see SyntheticTreeGenerator).
+	 * @param pFilePath the file name from which the names of the output
+	 *  files are derived (it does not need to exist)
+	 * @param parameters the parameters of the tree to generate
+	 */
+	TreeRePairAlgorithm(char * pFilePath,
+			const SyntheticTreeParameters & parameters);
+
 	~TreeRePairAlgorithm(void);
 
 private:
+	/**
+	 * Runs all steps of the algorithm.
+	 */
+	void compress();
+
 	/**
 	 * Parses the input XML document and constructs a DAG representation
 	 * of the binary representation of the XML document tree in main
-	 * memory.
+	 * memory. If the input file is a grammar generated by TreeRePair
+	 * (extension "rep") or a grammar in BPLEX-like format (extension "g"),
+	 * the DAG is constructed from the grammar without decompressing it
+	 * (see GrammarDagConstructor).
 	 */
 	void parseInput();
 
+	/**
+	 * Returns true if the specified file path ends with the specified
+	 * extension (including the dot).
+	 */
+	static bool hasExtension(const string & filePath, const string & extension);
+
 	/**
 	 * Writes the statistics of the run of the algorithm to a binary output
 	 * file or/and to the standard output.
@@ -86,6 +111,12 @@ private:
 	 */
 	char * pFilePath;
 
+	/**
+	 * The parameters of the synthetic tree to compress (0 if an input
+	 * XML document is compressed).
+	 */
+	const SyntheticTreeParameters * pSyntheticTreeParameters;
+
 	/**
 	 * The digram hash map allowing constant time access to the instances
 	 * of the Digram instance.
@@ -0,0 +1,695 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "XMLTreeParser.h"
+#include "TreeGenerator.h"
+#include "TreeTraversal.h"
+#include "StaticTreeTraversal.h"
+#include "Grammar.h"
+#include "Production.h"
+#include "Digram.h"
+#include "DigramPriorityQueue.h"
+#include "Symbol.h"
+#include "BitWriter.h"
+#include "BitReader.h"
+#include "HuffmanCoding.h"
+#include "HuffmanDecoding.h"
+#include "TreeRePairConstants.h"
+#include "TreeRePairVersion.h"
+#include "TablePrinter.h"
+#include "Helper.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+#include <time.h>
+
+using namespace std;
+
+#define MICRO_BENCHMARK_TEMP_FILE "TreeRePairMicroBenchmark.tmp"
+
+/**
+ * The measurements of one microbenchmark.
+ */
+struct MicroBenchmarkResult
+{
+	string name;
+	unsigned long long operations;
+	vector<double> nanosecondsPerOperation;
+};
+
+/**
+ * A row of a CSV file written by an earlier run.
+ */
+struct BaselineResult
+{
+	string name;
+	double medianNanosecondsPerOperation;
+};
+
+/**
+ * Records the access pattern of the digram counting phase, i.e., the
+ * edges in the order in which the DigramCounter registers them, and
+ * the labels of the nodes in preorder (which is the order in which
+ * they are written by the HuffmanSuccinctWriter).
+ */
+class WorkloadRecorder : public TreeTraversal
+{
+public:
+	WorkloadRecorder(Grammar & dagGrammar) : TreeTraversal(0) {
+		for (unsigned int i = 0; i < dagGrammar.size(); i++) {
+			pRoot = dagGrammar[i]->getRightHandSide();
+			traverseTree();
+		}
+	};
+
+	/**
+	 * The edges (parent node, child index) in postorder.
+	 */
+	vector<pair<TreeNode *, unsigned int> > edges;
+
+	/**
+	 * The ids of the symbols labeling the nodes in preorder.
+	 */
+	vector<unsigned int> labels;
+
+protected:
+	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing) {
+		if (!closing) {
+			if (index == UINT_MAX) {
+				labels.push_back(pNode->getSymbol()->getId());
+			} else {
+				labels.push_back(pNode->getChild(index)->getSymbol()->getId());
+			}
+		} else if (index != UINT_MAX) {
+			edges.push_back(make_pair(pNode, index));
+		}
+	};
+};
+
+/**
+ * The cheapest possible tree traversal; used to measure the overhead
+ * of TreeTraversal::traverseTree() itself.
+ */
+class VisitCounter : public TreeTraversal
+{
+public:
+	VisitCounter() : TreeTraversal(0), visits(0) {};
+
+	void traverse(TreeNode * pRootPar) {
+		pRoot = pRootPar;
+		traverseTree();
+	};
+
+	unsigned long long visits;
+
+protected:
+	void processNode(TreeNode * pNode, unsigned int index, int depth, bool closing) {
+		visits++;
+	};
+};
+
+/**
+ * The counterpart of the VisitCounter class for the statically dispatched
+ * StaticTreeTraversal class. It counts the same number of visits (two per
+ * node).
+ */
+class StaticVisitCounter : public StaticTreeTraversal<StaticVisitCounter>
+{
+	friend class StaticTreeTraversal<StaticVisitCounter>;
+
+public:
+	StaticVisitCounter() : visits(0) {};
+
+	void traverse(TreeNode * pRoot) {
+		traverseTree(pRoot);
+	};
+
+	unsigned long long visits;
+
+protected:
+	void preVisit(TreeNode * pNode, unsigned int index, int depth) {
+		visits++;
+	};
+
+	void postVisit(TreeNode * pNode, unsigned int index, int depth) {
+		visits++;
+	};
+};
+
+static double getNanoseconds()
+{
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec * 1000000000.0 + time.tv_nsec;
+}
+
+static void printHelp() {
+	string blank = Helper::getBlankCharacters(1);
+
+	cout << endl;
+	cout << "TreeRePair is an implementation of the Re-pair for Trees algorithm." << endl;
+	cout << "This tool measures the core data structures of TreeRePair and" << endl;
+	cout << "TreeDePair using the access pattern recorded from an input tree." << endl;
+	cout << endl;
+	cout << "Copyright (c) 2010 Roy Mennicke, Build date: " << VERSION << endl;
+	cout << endl;
+	cout << "Usage: TreeRePairMicroBenchmark [-nodes N] [-seed S] [-repetitions R]" << endl;
+	cout << "           [-csv FILE] [-baseline FILE] [INPUT_FILE]" << endl;
+
+	cout << endl << "Parameters:" << endl;
+
+	cout << blank << "INPUT_FILE" << endl;
+	cout << blank << blank << "The XML file whose tree is used as workload. If omitted, a" << endl;
+	cout << blank << blank << "synthetic tree is generated." << endl;
+
+	cout << blank << "-nodes N" << endl;
+	cout << blank << blank << "The number of nodes of the synthetic tree. Default is 1000000." << endl;
+
+	cout << blank << "-seed S" << endl;
+	cout << blank << blank << "The seed used to generate the synthetic tree. Default is 1." << endl;
+
+	cout << blank << "-repetitions R" << endl;
+	cout << blank << blank << "The number of times each benchmark is run. Default is 5." << endl;
+
+	cout << blank << "-csv FILE" << endl;
+	cout << blank << blank << "Writes the results to the specified CSV file." << endl;
+
+	cout << blank << "-baseline FILE" << endl;
+	cout << blank << blank << "Compares the results to a CSV file written by an earlier run." << endl;
+
+	cout << endl;
+}
+
+static char * getParameter(int argc, char * args[], int i)
+{
+	if (i + 1 >= argc)
+	{
+		cout << "Missing value for switch " << args[i] << "." << endl;
+		exit(1);
+	}
+	return args[i + 1];
+}
+
+static string formatDouble(double value, const char * format)
+{
+	char buf[32];
+	snprintf(buf, sizeof(buf), format, value);
+	return buf;
+}
+
+static unsigned int calculateNeededBits(unsigned int n)
+{
+	unsigned int bits = 1;
+	while (n >>= 1) {
+		bits++;
+	}
+	return bits;
+}
+
+static void addSample(MicroBenchmarkResult & result, double start,
+		double end, unsigned long long operations)
+{
+	result.operations = operations;
+	result.nanosecondsPerOperation.push_back(operations == 0 ? 0 :
+			(end - start) / operations);
+}
+
+/**
+ * Builds the digram hash map for the recorded edges. The digram of
+ * the i-th edge is stored at position i of edgeDigrams.
+ */
+static void buildDigrams(vector<pair<TreeNode *, unsigned int> > & edges,
+		HASH_D_D & digramHashMap, vector<Digram *> & edgeDigrams)
+{
+	edgeDigrams.resize(edges.size());
+	for (unsigned int i = 0; i < edges.size(); i++) {
+		TreeNode * pNode = edges[i].first;
+		unsigned int index = edges[i].second;
+		Digram * pDigram = new Digram(index, pNode->getSymbol(),
+				pNode->getChild(index)->getSymbol(), pNode, pNode);
+
+		HASH_D_D::iterator it = digramHashMap.find(pDigram);
+		if (it != digramHashMap.end()) {
+			delete pDigram;
+			pDigram = it->second;
+		} else {
+			digramHashMap[pDigram] = pDigram;
+		}
+		edgeDigrams[i] = pDigram;
+	}
+}
+
+static void deleteDigrams(HASH_D_D & digramHashMap)
+{
+	vector<Digram *> digrams;
+	for (HASH_D_D::iterator it = digramHashMap.begin(); it != digramHashMap.end(); ++it) {
+		digrams.push_back(it->second);
+	}
+	digramHashMap.clear();
+	for (unsigned int i = 0; i < digrams.size(); i++) {
+		delete digrams[i];
+	}
+}
+
+static void benchmarkTreeTraversal(Grammar & dagGrammar,
+		MicroBenchmarkResult & result)
+{
+	VisitCounter counter;
+	double start = getNanoseconds();
+	for (unsigned int i = 0; i < dagGrammar.size(); i++) {
+		counter.traverse(dagGrammar[i]->getRightHandSide());
+	}
+	addSample(result, start, getNanoseconds(), counter.visits);
+}
+
+static void benchmarkStaticTreeTraversal(Grammar & dagGrammar,
+		MicroBenchmarkResult & result)
+{
+	StaticVisitCounter counter;
+	double start = getNanoseconds();
+	for (unsigned int i = 0; i < dagGrammar.size(); i++) {
+		counter.traverse(dagGrammar[i]->getRightHandSide());
+	}
+	addSample(result, start, getNanoseconds(), counter.visits);
+}
+
+static void benchmarkHashLookup(vector<pair<TreeNode *, unsigned int> > & edges,
+		MicroBenchmarkResult & result)
+{
+	HASH_D_D digramHashMap;
+	vector<Digram *> edgeDigrams;
+	buildDigrams(edges, digramHashMap, edgeDigrams);
+
+	// every lookup uses a freshly allocated key like the DigramCounter does
+	vector<Digram *> keys(edges.size());
+	for (unsigned int i = 0; i < edges.size(); i++) {
+		keys[i] = new Digram(*edgeDigrams[i]);
+	}
+
+	unsigned long long found = 0;
+	double start = getNanoseconds();
+	for (unsigned int i = 0; i < keys.size(); i++) {
+		if (digramHashMap.find(keys[i]) != digramHashMap.end()) {
+			found++;
+		}
+	}
+	addSample(result, start, getNanoseconds(), keys.size());
+
+	if (found != keys.size()) {
+		cout << "Fatal error: Digram hash map lookup failed. Exiting ..." << endl;
+		exit(1);
+	}
+
+	for (unsigned int i = 0; i < keys.size(); i++) {
+		delete keys[i];
+	}
+	deleteDigrams(digramHashMap);
+}
+
+static void benchmarkPriorityQueueUpdates(vector<pair<TreeNode *, unsigned int> > & edges,
+		unsigned int nodeCount, MicroBenchmarkResult & incrementResult,
+		MicroBenchmarkResult & decrementResult)
+{
+	HASH_D_D digramHashMap;
+	vector<Digram *> edgeDigrams;
+	buildDigrams(edges, digramHashMap, edgeDigrams);
+	DigramPriorityQueue priorityQueue(nodeCount, &digramHashMap);
+
+	double start = getNanoseconds();
+	for (unsigned int i = 0; i < edgeDigrams.size(); i++) {
+		priorityQueue.incrementQuantity(edgeDigrams[i], 1);
+	}
+	addSample(incrementResult, start, getNanoseconds(), edgeDigrams.size());
+
+	// decrementing the first occurrence of each digram would delete it
+	vector<Digram *> decrements;
+	HASH_D_D firstOccurrences;
+	for (unsigned int i = 0; i < edgeDigrams.size(); i++) {
+		if (firstOccurrences.find(edgeDigrams[i]) == firstOccurrences.end()) {
+			firstOccurrences[edgeDigrams[i]] = edgeDigrams[i];
+		} else {
+			decrements.push_back(edgeDigrams[i]);
+		}
+	}
+
+	start = getNanoseconds();
+	for (unsigned int i = 0; i < decrements.size(); i++) {
+		priorityQueue.decrementQuantity(decrements[i], 1);
+	}
+	addSample(decrementResult, start, getNanoseconds(), decrements.size());
+
+	deleteDigrams(digramHashMap);
+}
+
+static void benchmarkPriorityQueueTop(vector<pair<TreeNode *, unsigned int> > & edges,
+		unsigned int nodeCount, MicroBenchmarkResult & result)
+{
+	HASH_D_D digramHashMap;
+	vector<Digram *> edgeDigrams;
+	buildDigrams(edges, digramHashMap, edgeDigrams);
+	DigramPriorityQueue priorityQueue(nodeCount, &digramHashMap);
+	for (unsigned int i = 0; i < edgeDigrams.size(); i++) {
+		priorityQueue.incrementQuantity(edgeDigrams[i], 1);
+	}
+
+	// drains the queue in the order in which the replacement loop would
+	// consume it
+	unsigned long long operations = 0;
+	double start = getNanoseconds();
+	Digram * pDigram;
+	while ((pDigram = priorityQueue.top()) != 0) {
+		priorityQueue.setDigramQuantityToZero(pDigram);
+		operations++;
+	}
+	addSample(result, start, getNanoseconds(), operations);
+
+	deleteDigrams(digramHashMap);
+}
+
+/**
+ * Writes the code lengths in the format expected by
+ * HuffmanDecoding::processCodeLengths() and returns the number of bits
+ * written.
+ */
+static unsigned int writeCodeLengths(BitWriter & bitWriter,
+		HuffmanCoding & huffmanCoding)
+{
+	unsigned int bitsPerCodeLength = calculateNeededBits(
+			huffmanCoding.getMaximumCodeLength());
+
+	bitWriter.writeBits(bitsPerCodeLength, CODE_LENGTH_BITS);
+	bitWriter.writeBits(huffmanCoding.getBiggestDecimal() + 1,
+			CODE_LENGTH_BITS);
+
+	for (unsigned int symbol = 0; symbol <= huffmanCoding.getBiggestDecimal(); symbol++) {
+		bitWriter.writeBits(huffmanCoding.getCodeLength(symbol), bitsPerCodeLength);
+	}
+
+	return 2 * CODE_LENGTH_BITS
+			+ (huffmanCoding.getBiggestDecimal() + 1) * bitsPerCodeLength;
+}
+
+static void benchmarkBitWriter(HuffmanCoding & huffmanCoding,
+		vector<unsigned int> & labels, MicroBenchmarkResult & result)
+{
+	ofstream fout(MICRO_BENCHMARK_TEMP_FILE, ios::out | ios::binary | ios::trunc);
+	if (!fout.is_open()) {
+		cout << "Could not open file " << MICRO_BENCHMARK_TEMP_FILE << ". Exiting ..." << endl;
+		exit(1);
+	}
+
+	BitWriter bitWriter(fout, false);
+	writeCodeLengths(bitWriter, huffmanCoding);
+
+	double start = getNanoseconds();
+	for (unsigned int i = 0; i < labels.size(); i++) {
+		bitWriter.writeBits(huffmanCoding.getCode(labels[i]),
+				huffmanCoding.getCodeLength(labels[i]));
+	}
+	bitWriter.flushBuffer();
+	addSample(result, start, getNanoseconds(), labels.size());
+
+	fout.close();
+}
+
+static void benchmarkBitReader(unsigned int headerLength,
+		HuffmanCoding & huffmanCoding, vector<unsigned int> & labels,
+		MicroBenchmarkResult & result)
+{
+	ifstream fin(MICRO_BENCHMARK_TEMP_FILE, ios::in | ios::binary);
+	BitReader bitReader(&fin);
+	bitReader.consume(headerLength);
+
+	unsigned long long mismatches = 0;
+	double start = getNanoseconds();
+	for (unsigned int i = 0; i < labels.size(); i++) {
+		if (bitReader.readBits(huffmanCoding.getCodeLength(labels[i]))
+				!= huffmanCoding.getCode(labels[i])) {
+			mismatches++;
+		}
+	}
+	addSample(result, start, getNanoseconds(), labels.size());
+
+	fin.close();
+
+	if (mismatches != 0) {
+		cout << "Fatal error: Bit reader returned " << mismatches
+				<< " wrong codes. Exiting ..." << endl;
+		exit(1);
+	}
+}
+
+static void benchmarkHuffmanDecoding(vector<unsigned int> & labels,
+		MicroBenchmarkResult & result)
+{
+	ifstream fin(MICRO_BENCHMARK_TEMP_FILE, ios::in | ios::binary);
+	BitReader bitReader(&fin);
+	HuffmanDecoding huffmanDecoding(&bitReader);
+	huffmanDecoding.processCodeLengths();
+
+	unsigned long long mismatches = 0;
+	double start = getNanoseconds();
+	for (unsigned int i = 0; i < labels.size(); i++) {
+		if (huffmanDecoding.readNext() != labels[i]) {
+			mismatches++;
+		}
+	}
+	addSample(result, start, getNanoseconds(), labels.size());
+
+	fin.close();
+
+	if (mismatches != 0) {
+		cout << "Fatal error: Huffman decoding returned " << mismatches
+				<< " wrong symbols. Exiting ..." << endl;
+		exit(1);
+	}
+}
+
+static double getMedian(vector<double> values)
+{
+	sort(values.begin(), values.end());
+	unsigned int size = values.size();
+	if (size % 2 == 1) {
+		return values[size / 2];
+	}
+	return (values[size / 2 - 1] + values[size / 2]) / 2;
+}
+
+static vector<BaselineResult> readBaseline(const char * pFilePath)
+{
+	vector<BaselineResult> baseline;
+
+	ifstream fin(pFilePath);
+	if (!fin.is_open()) {
+		cout << "Could not open baseline file " << pFilePath << "." << endl;
+		exit(1);
+	}
+
+	string line;
+	getline(fin, line); // header
+	while (getline(fin, line)) {
+		char name[256];
+		unsigned long long operations;
+		double minimum, median;
+		if (sscanf(line.c_str(), "%255[^,],%llu,%lf,%lf", name, &operations,
+				&minimum, &median) == 4) {
+			BaselineResult result;
+			result.name = name;
+			result.medianNanosecondsPerOperation = median;
+			baseline.push_back(result);
+		}
+	}
+
+	return baseline;
+}
+
+static void writeCsv(const char * pFilePath, vector<MicroBenchmarkResult> & results)
+{
+	ofstream fout(pFilePath);
+	if (!fout.is_open()) {
+		cout << "Could not open CSV file " << pFilePath << "." << endl;
+		exit(1);
+	}
+
+	fout << "benchmark,operations,min_ns_per_op,median_ns_per_op" << endl;
+	for (unsigned int i = 0; i < results.size(); i++) {
+		vector<double> & samples = results[i].nanosecondsPerOperation;
+		fout << results[i].name << "," << results[i].operations << ","
+				<< formatDouble(*min_element(samples.begin(), samples.end()), "%.3f") << ","
+				<< formatDouble(getMedian(samples), "%.3f") << endl;
+	}
+
+	fout.close();
+}
+
+static void printResults(vector<MicroBenchmarkResult> & results,
+		vector<BaselineResult> & baseline)
+{
+	unsigned int widths[] = { 22, 12, 14, 14, 14, 9 };
+	TablePrinter tablePrinter;
+	tablePrinter.init(6, widths);
+	tablePrinter.addColumnData("Benchmark");
+	tablePrinter.addColumnData("Operations");
+	tablePrinter.addColumnData("Min [ns/op]");
+	tablePrinter.addColumnData("Median [ns/op]");
+	tablePrinter.addColumnData("Base. [ns/op]");
+	tablePrinter.addColumnData("Speedup");
+	tablePrinter.printRowAsHeader();
+
+	for (unsigned int i = 0; i < results.size(); i++) {
+		vector<double> & samples = results[i].nanosecondsPerOperation;
+		double median = getMedian(samples);
+
+		string baselineMedian = "-", speedup = "-";
+		for (unsigned int j = 0; j < baseline.size(); j++) {
+			if (baseline[j].name == results[i].name) {
+				baselineMedian = formatDouble(baseline[j].medianNanosecondsPerOperation, "%.2f");
+				if (median > 0) {
+					speedup = formatDouble(baseline[j].medianNanosecondsPerOperation
+							/ median, "%.2f");
+				}
+			}
+		}
+
+		tablePrinter.addColumnData(results[i].name);
+		tablePrinter.addColumnData(Helper::stringify((size_t) results[i].operations));
+		tablePrinter.addColumnData(formatDouble(*min_element(samples.begin(), samples.end()), "%.2f"));
+		tablePrinter.addColumnData(formatDouble(median, "%.2f"));
+		tablePrinter.addColumnData(baselineMedian);
+		tablePrinter.addColumnData(speedup);
+		tablePrinter.printRow();
+	}
+}
+
+int main (int argc, char* args[]) {
+
+	SyntheticTreeParameters parameters;
+	parameters.numberOfNodes = 1000000;
+	unsigned int repetitions = 5;
+	char * pInputFilePath = 0, * pCsvFilePath = 0, * pBaselineFilePath = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = args[i];
+		if (arg == "-nodes") {
+			parameters.numberOfNodes = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-seed") {
+			parameters.seed = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-repetitions") {
+			repetitions = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-csv") {
+			pCsvFilePath = getParameter(argc, args, i++);
+		} else if (arg == "-baseline") {
+			pBaselineFilePath = getParameter(argc, args, i++);
+		} else if (arg == "-help") {
+			printHelp();
+			exit(0);
+		} else if (arg[0] == '-') {
+			cout << "Unknown switch: " << arg << endl;
+			exit(1);
+		} else {
+			pInputFilePath = args[i];
+		}
+	}
+
+	if (repetitions == 0) {
+		cout << "The number of repetitions must be positive." << endl;
+		exit(1);
+	}
+
+	vector<BaselineResult> baseline;
+	if (pBaselineFilePath != 0) {
+		baseline = readBaseline(pBaselineFilePath);
+	}
+
+	Grammar dagGrammar;
+	unsigned int nodeCount;
+	if (pInputFilePath != 0) {
+		XMLTreeParser xmlParser(pInputFilePath, dagGrammar);
+		nodeCount = xmlParser.getNodeCount();
+	} else {
+		SyntheticTreeGenerator generator(dagGrammar, parameters);
+		nodeCount = generator.getNodeCount();
+	}
+
+	WorkloadRecorder recorder(dagGrammar);
+	cout << "workload: " << nodeCount << " nodes, " << dagGrammar.size()
+			<< " DAG productions, " << recorder.edges.size() << " edges, "
+			<< recorder.labels.size() << " labels" << endl << endl;
+
+	// the Huffman coding of the labels serves as workload for the bit
+	// writer, the bit reader and the Huffman decoding
+	ofstream dummyStream;
+	BitWriter dummyWriter(dummyStream, false);
+	HuffmanCoding huffmanCoding(dummyWriter, dummyStream, false);
+	for (unsigned int i = 0; i < recorder.labels.size(); i++) {
+		huffmanCoding.countSymbol(recorder.labels[i]);
+	}
+	huffmanCoding.computeHuffmanCodes();
+	bool huffmanCodingUsable = huffmanCoding.getMaximumCodeLength() > 0;
+
+	ofstream headerStream(MICRO_BENCHMARK_TEMP_FILE, ios::out | ios::binary | ios::trunc);
+	BitWriter headerWriter(headerStream, false);
+	unsigned int headerLength = writeCodeLengths(headerWriter, huffmanCoding);
+	headerStream.close();
+
+	vector<MicroBenchmarkResult> results(9);
+	results[0].name = "tree_traversal";
+	results[1].name = "tree_traversal_static";
+	results[2].name = "digram_hash_lookup";
+	results[3].name = "queue_increment";
+	results[4].name = "queue_decrement";
+	results[5].name = "queue_top";
+	results[6].name = "bit_writer_write";
+	results[7].name = "bit_reader_read";
+	results[8].name = "huffman_read_next";
+
+	for (unsigned int i = 0; i < repetitions; i++) {
+		benchmarkTreeTraversal(dagGrammar, results[0]);
+		benchmarkStaticTreeTraversal(dagGrammar, results[1]);
+		benchmarkHashLookup(recorder.edges, results[2]);
+		benchmarkPriorityQueueUpdates(recorder.edges, nodeCount, results[3], results[4]);
+		benchmarkPriorityQueueTop(recorder.edges, nodeCount, results[5]);
+		if (huffmanCodingUsable) {
+			benchmarkBitWriter(huffmanCoding, recorder.labels, results[6]);
+			benchmarkBitReader(headerLength, huffmanCoding, recorder.labels, results[7]);
+			benchmarkHuffmanDecoding(recorder.labels, results[8]);
+		}
+	}
+
+	if (!huffmanCodingUsable) {
+		cout << "The input tree has a single label, the Huffman coding benchmarks are skipped." << endl;
+		results.resize(6);
+	}
+
+	remove(MICRO_BENCHMARK_TEMP_FILE);
+
+	printResults(results, baseline);
+
+	if (pCsvFilePath != 0) {
+		writeCsv(pCsvFilePath, results);
+	}
+
+	dagGrammar.deleteProductions();
+	Helper::deleteSymbols();
+
+	return 0;
+}
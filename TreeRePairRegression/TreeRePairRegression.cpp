@@ -0,0 +1,656 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "TreeGenerator.h"
+#include "XMLParser.h"
+#include "XmlContentHandler.h"
+#include "XmlWriter.h"
+#include "TreeRePairVersion.h"
+#include "TablePrinter.h"
+#include "Helper.h"
+#include "Grammar.h"
+#include "Production.h"
+#include "Symbol.h"
+#include "TreeNode.h"
+#include "ReferencesTreeCounter.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <boost/unordered_map.hpp>
+#include <stdio.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+using namespace std;
+
+/**
+ * Timing differences below this value (in milliseconds) are regarded
+ * as noise and never reported as regression.
+ */
+#define REGRESSION_MIN_TIME_DIFFERENCE 5.0
+
+/**
+ * The number of levels of the shared DAG whose reference counts are
+ * checked, i.e., the represented tree contains 2^levels copies of the
+ * innermost subtree.
+ */
+#define REGRESSION_SHARED_DAG_LEVELS 16
+
+/**
+ * A document of the regression corpus.
+ */
+struct CorpusDocument
+{
+	const char * name;
+	unsigned int maxDepth;
+	unsigned int fanOut;
+	unsigned int vocabularySize;
+	double repetitiveness;
+};
+
+/**
+ * The regression corpus. The documents differ in depth, width, size of
+ * the vocabulary and repetitiveness.
+ */
+static const CorpusDocument corpus[] = {
+	{ "balanced", 6, 8, 32, 0.5 },
+	{ "deep", 24, 2, 16, 0.5 },
+	{ "wide", 3, 64, 32, 0.5 },
+	{ "random", 6, 8, 64, 0.0 },
+	{ "repetitive", 6, 8, 32, 0.95 },
+	{ "small_vocabulary", 8, 4, 4, 0.5 }
+};
+
+/**
+ * The metrics measured for one document.
+ */
+struct RegressionMetrics
+{
+	string document;
+	unsigned int numberOfNodes;
+	double compressionTimeInMs;
+	double decompressionTimeInMs;
+	long long peakMemoryInKb;
+	long long repSizeInBytes;
+};
+
+/**
+ * Records the structure of a XML document, i.e., the sequence of its
+ * start-tags and end-tags.
+ */
+class XmlStructureRecorder : public XmlContentHandler
+{
+public:
+	void startElement(string & name) {
+		boost::unordered_map<string, unsigned int>::iterator it = names.find(name);
+		if (it == names.end()) {
+			it = names.insert(make_pair(name, (unsigned int) names.size() + 1)).first;
+		}
+		events.push_back(it->second);
+	};
+
+	void endElement(string & name) {
+		events.push_back(0);
+	};
+
+	void endDocument() {};
+
+	/**
+	 * The ids of the element types of the start-tags; every end-tag
+	 * is represented by 0.
+	 */
+	vector<unsigned int> events;
+
+	/**
+	 * Maps the element types to ids.
+	 */
+	boost::unordered_map<string, unsigned int> names;
+};
+
+static void printHelp() {
+	string blank = Helper::getBlankCharacters(1);
+
+	cout << endl;
+	cout << "TreeRePair is an implementation of the Re-pair for Trees algorithm." << endl;
+	cout << "This tool compresses and decompresses a generated corpus of XML" << endl;
+	cout << "documents using TreeRePair and TreeDePair, checks the round trip" << endl;
+	cout << "and compares time, memory and output size to a baseline. Before," << endl;
+	cout << "the reference counting on a highly shared DAG is checked." << endl;
+	cout << endl;
+	cout << "Copyright (c) 2010 Roy Mennicke, Build date: " << VERSION << endl;
+	cout << endl;
+	cout << "Usage: TreeRePairRegression [-baseline FILE] [-write_baseline FILE]" << endl;
+	cout << "           [-nodes N] [-repetitions R] [-time_threshold T]" << endl;
+	cout << "           [-memory_threshold M] [-size_threshold S] [-bin DIR] [-keep]" << endl;
+
+	cout << endl << "Parameters:" << endl;
+
+	cout << blank << "-baseline FILE" << endl;
+	cout << blank << blank << "The baseline to compare the results to. The tool fails if a" << endl;
+	cout << blank << blank << "metric of a document exceeds its baseline value by more than" << endl;
+	cout << blank << blank << "the corresponding threshold." << endl;
+
+	cout << blank << "-write_baseline FILE" << endl;
+	cout << blank << blank << "Writes the results to the specified baseline file." << endl;
+
+	cout << blank << "-nodes N" << endl;
+	cout << blank << blank << "The number of nodes of each document. Default is 100000." << endl;
+
+	cout << blank << "-repetitions R" << endl;
+	cout << blank << blank << "The number of runs per document; the fastest run counts." << endl;
+	cout << blank << blank << "Default is 3." << endl;
+
+	cout << blank << "-time_threshold T" << endl;
+	cout << blank << blank << "The tolerated relative increase of the compression and the" << endl;
+	cout << blank << blank << "decompression time. Default is 0.2 (20 percent)." << endl;
+
+	cout << blank << "-memory_threshold M" << endl;
+	cout << blank << blank << "The tolerated relative increase of the peak memory usage." << endl;
+	cout << blank << blank << "Default is 0.1." << endl;
+
+	cout << blank << "-size_threshold S" << endl;
+	cout << blank << blank << "The tolerated relative increase of the size of the compressed" << endl;
+	cout << blank << blank << "file. Default is 0." << endl;
+
+	cout << blank << "-bin DIR" << endl;
+	cout << blank << blank << "The directory containing the TreeRePair and TreeDePair" << endl;
+	cout << blank << blank << "directories. Default is \"..\"." << endl;
+
+	cout << blank << "-keep" << endl;
+	cout << blank << blank << "Keeps the generated and the decompressed documents." << endl;
+
+	cout << endl;
+}
+
+static char * getParameter(int argc, char * args[], int i)
+{
+	if (i + 1 >= argc)
+	{
+		cout << "Missing value for switch " << args[i] << "." << endl;
+		exit(1);
+	}
+	return args[i + 1];
+}
+
+static string formatDouble(double value, const char * format)
+{
+	char buf[32];
+	snprintf(buf, sizeof(buf), format, value);
+	return buf;
+}
+
+static double getMilliseconds()
+{
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return time.tv_sec * 1000.0 + time.tv_nsec / 1000000.0;
+}
+
+/**
+ * Runs the specified executable with the specified file as only argument
+ * and returns false if it did not exit successfully. The output of the
+ * executable is discarded.
+ */
+static bool runExecutable(const string & executable, const string & filePath,
+		double & wallTimeInMs, long long & peakMemoryInKb)
+{
+	cout << flush;
+
+	double start = getMilliseconds();
+
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		int devNull = open("/dev/null", O_WRONLY);
+		if (devNull >= 0) {
+			dup2(devNull, STDOUT_FILENO);
+			dup2(devNull, STDERR_FILENO);
+		}
+		execl(executable.c_str(), executable.c_str(), filePath.c_str(), (char *) 0);
+		_exit(127);
+	}
+	else if (pid < 0)
+	{
+		cout << "Could not fork. Exiting ..." << endl;
+		exit(1);
+	}
+
+	int status;
+	rusage usage;
+	wait4(pid, &status, 0, &usage);
+
+	wallTimeInMs = getMilliseconds() - start;
+	peakMemoryInKb = usage.ru_maxrss;
+
+	return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static void recordStructure(const string & filePath, XmlStructureRecorder & recorder)
+{
+	XMLParser parser((char *) filePath.c_str(), recorder);
+}
+
+/**
+ * Returns true if and only if the two documents consist of the same
+ * elements in the same order.
+ */
+static bool haveSameStructure(const string & filePathA, const string & filePathB)
+{
+	XmlStructureRecorder recorderA, recorderB;
+	recordStructure(filePathA, recorderA);
+	recordStructure(filePathB, recorderB);
+
+	if (recorderA.events.size() != recorderB.events.size()) {
+		return false;
+	}
+
+	// the ids are assigned in the order of the first occurrence, so
+	// equal sequences of ids imply equal sequences of element types
+	if (recorderA.events != recorderB.events) {
+		return false;
+	}
+
+	boost::unordered_map<string, unsigned int>::iterator it;
+	for (it = recorderA.names.begin(); it != recorderA.names.end(); ++it) {
+		boost::unordered_map<string, unsigned int>::iterator other =
+				recorderB.names.find(it->first);
+		if (other == recorderB.names.end() || other->second != it->second) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static vector<RegressionMetrics> readBaseline(const char * pFilePath)
+{
+	vector<RegressionMetrics> baseline;
+
+	ifstream fin(pFilePath);
+	if (!fin.is_open()) {
+		cout << "Could not open baseline file " << pFilePath
+				<< ". Use -write_baseline to create it." << endl;
+		exit(1);
+	}
+
+	string line;
+	getline(fin, line); // header
+	while (getline(fin, line)) {
+		char document[256];
+		RegressionMetrics metrics;
+		if (sscanf(line.c_str(), "%255[^,],%u,%lf,%lf,%lld,%lld", document,
+				&metrics.numberOfNodes, &metrics.compressionTimeInMs,
+				&metrics.decompressionTimeInMs, &metrics.peakMemoryInKb,
+				&metrics.repSizeInBytes) == 6) {
+			metrics.document = document;
+			baseline.push_back(metrics);
+		}
+	}
+
+	return baseline;
+}
+
+static void writeBaseline(const char * pFilePath, vector<RegressionMetrics> & results)
+{
+	ofstream fout(pFilePath);
+	if (!fout.is_open()) {
+		cout << "Could not open baseline file " << pFilePath << "." << endl;
+		exit(1);
+	}
+
+	fout << "document,nodes,compression_ms,decompression_ms,peak_rss_kb,rep_bytes" << endl;
+	for (unsigned int i = 0; i < results.size(); i++) {
+		fout << results[i].document << "," << results[i].numberOfNodes << ","
+				<< formatDouble(results[i].compressionTimeInMs, "%.3f") << ","
+				<< formatDouble(results[i].decompressionTimeInMs, "%.3f") << ","
+				<< results[i].peakMemoryInKb << "," << results[i].repSizeInBytes << endl;
+	}
+
+	fout.close();
+}
+
+/**
+ * Compares a metric to its baseline value and reports a regression.
+ * @returns true if the metric regressed
+ */
+static bool checkMetric(const string & document, const char * pMetric,
+		double value, double baselineValue, double threshold,
+		double minimalDifference)
+{
+	if (value <= baselineValue * (1 + threshold)
+			|| value - baselineValue < minimalDifference) {
+		return false;
+	}
+
+	cout << "Regression: " << document << ": " << pMetric << " "
+			<< formatDouble(baselineValue, "%.1f") << " -> "
+			<< formatDouble(value, "%.1f") << " (+"
+			<< formatDouble(baselineValue > 0 ? (value / baselineValue - 1) * 100 : 100, "%.1f")
+			<< "%)" << endl;
+	return true;
+}
+
+/**
+ * Checks the reference counts determined by the ReferencesTreeCounter
+ * on a highly shared DAG grammar. The production of level i references
+ * the production of level i - 1 twice, i.e., the represented tree
+ * contains 2^levels copies of the production of level 0, which references
+ * the nonterminal A of the main grammar. The production of the middle
+ * level references the nonterminal B of the main grammar and the start
+ * production references the highest level, level 0 and B. Hence, level 0
+ * is reached on paths of different lengths. The counts are compared to
+ * the ones obtained by expanding the DAG.
+ * @returns true if all reference counts are correct
+ */
+static bool checkSharedDagReferenceCounts(unsigned int levels)
+{
+	Symbol * pLeafSymbol = new Symbol();
+	pLeafSymbol->setRank(0);
+	Symbol * pBinarySymbol = new Symbol();
+	pBinarySymbol->setRank(2);
+	Symbol * pTernarySymbol = new Symbol();
+	pTernarySymbol->setRank(3);
+
+	Grammar mainGrammar;
+	Symbol * pMainSymbols[2];
+	for (unsigned int i = 0; i < 2; i++) {
+		pMainSymbols[i] = new Symbol();
+		pMainSymbols[i]->setRank(0);
+		mainGrammar.addProduction(new Production(pMainSymbols[i],
+				new TreeNode(pLeafSymbol)));
+	}
+
+	vector<Production *> levelProductions;
+	for (unsigned int i = 0; i <= levels; i++) {
+		TreeNode * pRoot;
+		if (i == 0) {
+			pRoot = new TreeNode(pBinarySymbol);
+			pRoot->addChild(new TreeNode(pMainSymbols[0]));
+			pRoot->addChild(new TreeNode(pLeafSymbol));
+		} else {
+			Symbol * pLowerSymbol = levelProductions[i - 1]->getLeftHandSide();
+			pRoot = new TreeNode(i == levels / 2 ? pTernarySymbol : pBinarySymbol);
+			pRoot->addChild(new TreeNode(pLowerSymbol));
+			pRoot->addChild(new TreeNode(pLowerSymbol));
+			if (i == levels / 2) {
+				pRoot->addChild(new TreeNode(pMainSymbols[1]));
+			}
+		}
+
+		Symbol * pSymbol = new Symbol();
+		pSymbol->setRank(0);
+		levelProductions.push_back(new Production(pSymbol, pRoot));
+	}
+
+	TreeNode * pStartRoot = new TreeNode(pTernarySymbol);
+	pStartRoot->addChild(new TreeNode(levelProductions[levels]->getLeftHandSide()));
+	pStartRoot->addChild(new TreeNode(levelProductions[0]->getLeftHandSide()));
+	pStartRoot->addChild(new TreeNode(pMainSymbols[1]));
+
+	Grammar dagGrammar;
+	dagGrammar.addProduction(new Production(Symbol::getStartSymbol(), pStartRoot));
+	for (unsigned int i = 0; i < levelProductions.size(); i++) {
+		dagGrammar.addProduction(levelProductions[i]);
+	}
+
+	// count the references in the expanded tree
+	boost::unordered_map<unsigned int, unsigned int> expectedCounts;
+	vector<TreeNode *> nodes(1, pStartRoot);
+	while (!nodes.empty()) {
+		TreeNode * pNode = nodes.back();
+		nodes.pop_back();
+
+		Symbol * pSymbol = pNode->getSymbol();
+		if (dagGrammar.isNonTerminal(pSymbol)) {
+			nodes.push_back(dagGrammar.getProductionBySymbol(pSymbol)->getRightHandSide());
+			continue;
+		}
+		if (mainGrammar.isNonTerminal(pSymbol)) {
+			expectedCounts[pSymbol->getId()]++;
+		}
+		for (unsigned int i = 0; i < pNode->getCurrentChildrenCount(); i++) {
+			nodes.push_back(pNode->getChild(i));
+		}
+	}
+
+	ReferencesTreeCounter treeCounter(pStartRoot, &dagGrammar, mainGrammar);
+
+	bool correct = true;
+	for (unsigned int i = 0; i < mainGrammar.size(); i++) {
+		unsigned int count = mainGrammar[i]->getRefCount();
+		unsigned int expectedCount = expectedCounts[mainGrammar[i]->getLeftHandSide()->getId()];
+		if (count != expectedCount) {
+			cout << "shared_dag: nonterminal " << (char) ('A' + i) << " has "
+					<< count << " references instead of " << expectedCount << endl;
+			correct = false;
+		}
+	}
+
+	cout << "shared_dag: " << levels << " levels, reference counts "
+			<< (correct ? "ok" : "FAILED") << endl << endl;
+
+	dagGrammar.deleteProductions();
+	mainGrammar.deleteProductions();
+	Helper::deleteSymbols();
+	Symbol::reset();
+
+	return correct;
+}
+
+int main (int argc, char* args[]) {
+
+	char * pBaselineFilePath = 0, * pWriteBaselineFilePath = 0;
+	string binaryDirectory = "..";
+	unsigned int numberOfNodes = 100000, repetitions = 3;
+	double timeThreshold = 0.2, memoryThreshold = 0.1, sizeThreshold = 0;
+	bool keepFiles = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = args[i];
+		if (arg == "-baseline") {
+			pBaselineFilePath = getParameter(argc, args, i++);
+		} else if (arg == "-write_baseline") {
+			pWriteBaselineFilePath = getParameter(argc, args, i++);
+		} else if (arg == "-nodes") {
+			numberOfNodes = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-repetitions") {
+			repetitions = atoi(getParameter(argc, args, i++));
+		} else if (arg == "-time_threshold") {
+			timeThreshold = atof(getParameter(argc, args, i++));
+		} else if (arg == "-memory_threshold") {
+			memoryThreshold = atof(getParameter(argc, args, i++));
+		} else if (arg == "-size_threshold") {
+			sizeThreshold = atof(getParameter(argc, args, i++));
+		} else if (arg == "-bin") {
+			binaryDirectory = getParameter(argc, args, i++);
+		} else if (arg == "-keep") {
+			keepFiles = true;
+		} else if (arg == "-help") {
+			printHelp();
+			exit(0);
+		} else {
+			cout << "Unknown switch: " << arg << endl;
+			exit(1);
+		}
+	}
+
+	if (repetitions == 0) {
+		cout << "The number of repetitions must be positive." << endl;
+		exit(1);
+	}
+
+	string compressor = binaryDirectory + "/TreeRePair/TreeRePair";
+	string decompressor = binaryDirectory + "/TreeDePair/TreeDePair";
+	if (access(compressor.c_str(), X_OK) != 0 || access(decompressor.c_str(), X_OK) != 0) {
+		cout << "Could not find " << compressor << " or " << decompressor
+				<< ". Use the -bin switch." << endl;
+		exit(1);
+	}
+
+	vector<RegressionMetrics> baseline;
+	if (pBaselineFilePath != 0) {
+		baseline = readBaseline(pBaselineFilePath);
+	}
+
+	vector<RegressionMetrics> results;
+	vector<string> failures;
+
+	if (!checkSharedDagReferenceCounts(REGRESSION_SHARED_DAG_LEVELS)) {
+		failures.push_back("shared_dag: wrong reference counts");
+	}
+
+	unsigned int widths[] = { 18, 9, 13, 15, 14, 10, 11 };
+	TablePrinter tablePrinter;
+	tablePrinter.init(7, widths);
+	tablePrinter.addColumnData("Document");
+	tablePrinter.addColumnData("Nodes");
+	tablePrinter.addColumnData("Compr. [ms]");
+	tablePrinter.addColumnData("Decompr. [ms]");
+	tablePrinter.addColumnData("Peak mem [MB]");
+	tablePrinter.addColumnData("Rep [B]");
+	tablePrinter.addColumnData("Round trip");
+	tablePrinter.printRowAsHeader();
+
+	unsigned int numberOfDocuments = sizeof(corpus) / sizeof(corpus[0]);
+	for (unsigned int i = 0; i < numberOfDocuments; i++) {
+		SyntheticTreeParameters parameters;
+		parameters.numberOfNodes = numberOfNodes;
+		parameters.maxDepth = corpus[i].maxDepth;
+		parameters.fanOut = corpus[i].fanOut;
+		parameters.vocabularySize = corpus[i].vocabularySize;
+		parameters.repetitiveness = corpus[i].repetitiveness;
+		parameters.seed = i + 1;
+
+		string filePath = string("TreeRePairRegression_") + corpus[i].name + ".xml";
+		string repFilePath = Helper::getFilePathForBinary(filePath.c_str());
+		string uncompressedFilePath = Helper::getFilePathForUncompressed(repFilePath.c_str());
+
+		RegressionMetrics metrics;
+		metrics.document = corpus[i].name;
+
+		ofstream fout(filePath.c_str());
+		XmlWriter xmlWriter(fout);
+		metrics.numberOfNodes = SyntheticTreeGenerator::generate(parameters, xmlWriter);
+		fout.close();
+
+		metrics.compressionTimeInMs = metrics.decompressionTimeInMs = 0;
+		metrics.peakMemoryInKb = 0;
+		bool succeeded = true;
+
+		for (unsigned int j = 0; j < repetitions && succeeded; j++) {
+			double compressionTime, decompressionTime;
+			long long compressionMemory, decompressionMemory;
+
+			succeeded = runExecutable(compressor, filePath, compressionTime, compressionMemory)
+					&& runExecutable(decompressor, repFilePath, decompressionTime, decompressionMemory);
+
+			if (succeeded) {
+				if (j == 0 || compressionTime < metrics.compressionTimeInMs) {
+					metrics.compressionTimeInMs = compressionTime;
+				}
+				if (j == 0 || decompressionTime < metrics.decompressionTimeInMs) {
+					metrics.decompressionTimeInMs = decompressionTime;
+				}
+				metrics.peakMemoryInKb = max(metrics.peakMemoryInKb,
+						max(compressionMemory, decompressionMemory));
+			}
+		}
+
+		metrics.repSizeInBytes = Helper::getFileSize(repFilePath.c_str());
+
+		bool roundTripOk = succeeded && haveSameStructure(filePath, uncompressedFilePath);
+		if (!roundTripOk) {
+			failures.push_back(string(corpus[i].name) + ": round trip failed");
+		}
+
+		tablePrinter.addColumnData(metrics.document);
+		tablePrinter.addColumnData(metrics.numberOfNodes);
+		tablePrinter.addColumnData(formatDouble(metrics.compressionTimeInMs, "%.1f"));
+		tablePrinter.addColumnData(formatDouble(metrics.decompressionTimeInMs, "%.1f"));
+		tablePrinter.addColumnData(formatDouble(metrics.peakMemoryInKb / 1024.0, "%.1f"));
+		tablePrinter.addColumnData(Helper::stringify((size_t) metrics.repSizeInBytes));
+		tablePrinter.addColumnData(roundTripOk ? "ok" : "FAILED");
+		tablePrinter.printRow();
+
+		results.push_back(metrics);
+
+		if (!keepFiles) {
+			remove(filePath.c_str());
+			remove(repFilePath.c_str());
+			remove(uncompressedFilePath.c_str());
+		}
+	}
+
+	cout << endl;
+
+	unsigned int numberOfRegressions = 0;
+	for (unsigned int i = 0; i < results.size() && pBaselineFilePath != 0; i++) {
+		RegressionMetrics & metrics = results[i];
+
+		unsigned int j = 0;
+		while (j < baseline.size() && baseline[j].document != metrics.document) {
+			j++;
+		}
+
+		if (j == baseline.size()) {
+			cout << "No baseline for document " << metrics.document << "." << endl;
+			continue;
+		}
+
+		RegressionMetrics & base = baseline[j];
+		if (base.numberOfNodes != metrics.numberOfNodes) {
+			failures.push_back(metrics.document
+					+ ": baseline was recorded for a different number of nodes");
+			continue;
+		}
+
+		numberOfRegressions += checkMetric(metrics.document, "compression time [ms]",
+				metrics.compressionTimeInMs, base.compressionTimeInMs,
+				timeThreshold, REGRESSION_MIN_TIME_DIFFERENCE);
+		numberOfRegressions += checkMetric(metrics.document, "decompression time [ms]",
+				metrics.decompressionTimeInMs, base.decompressionTimeInMs,
+				timeThreshold, REGRESSION_MIN_TIME_DIFFERENCE);
+		numberOfRegressions += checkMetric(metrics.document, "peak memory [KB]",
+				metrics.peakMemoryInKb, base.peakMemoryInKb, memoryThreshold, 0);
+		numberOfRegressions += checkMetric(metrics.document, "rep size [B]",
+				metrics.repSizeInBytes, base.repSizeInBytes, sizeThreshold, 0);
+	}
+
+	if (pWriteBaselineFilePath != 0) {
+		writeBaseline(pWriteBaselineFilePath, results);
+	}
+
+	for (unsigned int i = 0; i < failures.size(); i++) {
+		cout << "Failure: " << failures[i] << endl;
+	}
+
+	if (numberOfRegressions > 0 || !failures.empty()) {
+		cout << numberOfRegressions << " regression(s), " << failures.size()
+				<< " failure(s)." << endl;
+		return 1;
+	}
+
+	cout << (pBaselineFilePath != 0 ? "No regressions." : "All round trips succeeded.") << endl;
+	return 0;
+}
@@ -0,0 +1,339 @@
+/*
+ * TreeRePair is an implementation of the Re-pair for Trees algorithm.
+ *
+ * Copyright (C) 2010  Roy Mennicke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License Version 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License Version 3 for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not,
+ * see <http://www.gnu.org/licenses/gpl-3.0.txt>.
+ */
+#include "TablePrinter.h"
+#include "Helper.h"
+#include "TreeRePairVersion.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <stdio.h>
+
+using namespace std;
+
+/**
+ * One line of a trace written by the ReplacementTracer.
+ */
+struct TraceIteration
+{
+	unsigned int iteration;
+	unsigned int parent;
+	unsigned int index;
+	unsigned int child;
+	unsigned int occurrences;
+	unsigned int replaced;
+	unsigned int deregistered;
+	unsigned int registered;
+	unsigned int scanLength;
+	unsigned long long nanoseconds;
+};
+
+static bool compareByTime(const TraceIteration & a, const TraceIteration & b)
+{
+	return a.nanoseconds > b.nanoseconds;
+}
+
+static void printHelp() {
+	string blank = Helper::getBlankCharacters(1);
+
+	cout << endl;
+	cout << "TreeRePair is an implementation of the Re-pair for Trees algorithm." << endl;
+	cout << "This tool summarizes a trace of the digram replacement loop which" << endl;
+	cout << "was written by TreeRePair using the -trace switch." << endl;
+	cout << endl;
+	cout << "Copyright (c) 2010 Roy Mennicke, Build date: " << VERSION << endl;
+	cout << endl;
+	cout << "Usage: TreeRePairTraceAnalyzer [-top N] trace_file" << endl;
+
+	cout << endl << "Parameters:" << endl;
+
+	cout << blank << "trace_file" << endl;
+	cout << blank << blank << "A CSV file written by TreeRePair -trace." << endl;
+
+	cout << blank << "-top N" << endl;
+	cout << blank << blank << "Lists the N most expensive iterations. Default is 10." << endl;
+
+	cout << endl;
+}
+
+static void readTrace(const char * pFilePath, vector<TraceIteration> & iterations)
+{
+	ifstream fin(pFilePath);
+	if (!fin.is_open())
+	{
+		cout << "Could not open trace file " << pFilePath << ". Exiting ..." << endl;
+		exit(1);
+	}
+
+	string line;
+	// skip the header
+	getline(fin, line);
+
+	while (getline(fin, line))
+	{
+		TraceIteration it;
+		if (sscanf(line.c_str(), "%u,%u,%u,%u,%u,%u,%u,%u,%u,%llu",
+				&it.iteration, &it.parent, &it.index, &it.child,
+				&it.occurrences, &it.replaced, &it.deregistered,
+				&it.registered, &it.scanLength, &it.nanoseconds) != 10)
+		{
+			cout << "Malformed line in trace file: " << line << endl;
+			exit(1);
+		}
+		iterations.push_back(it);
+	}
+}
+
+static string formatMs(unsigned long long nanoseconds)
+{
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%.3f", nanoseconds / 1000000.0);
+	return buf;
+}
+
+static string formatShare(unsigned long long part, unsigned long long total)
+{
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%.1f%%", total == 0 ? 0.0 : 100.0 * part / total);
+	return buf;
+}
+
+/**
+ * Prints the time needed by each tenth of the iterations.
+ */
+static void printDeciles(vector<TraceIteration> & iterations,
+		unsigned long long totalTime)
+{
+	unsigned int widths[] = { 17, 12, 8, 12, 12, 10 };
+	TablePrinter tablePrinter;
+	tablePrinter.init(6, widths);
+	tablePrinter.addColumnData("Iterations");
+	tablePrinter.addColumnData("Time [ms]");
+	tablePrinter.addColumnData("Share");
+	tablePrinter.addColumnData("Replaced");
+	tablePrinter.addColumnData("Reg./Dereg.");
+	tablePrinter.addColumnData("Avg. scan");
+	tablePrinter.printRowAsHeader();
+
+	unsigned int n = iterations.size();
+	for (unsigned int d = 0; d < 10; d++)
+	{
+		unsigned int from = (unsigned long long) n * d / 10;
+		unsigned int to = (unsigned long long) n * (d + 1) / 10;
+		if (from == to)
+		{
+			continue;
+		}
+
+		unsigned long long time = 0, replaced = 0, updates = 0, scan = 0;
+		for (unsigned int i = from; i < to; i++)
+		{
+			time += iterations[i].nanoseconds;
+			replaced += iterations[i].replaced;
+			updates += iterations[i].registered + iterations[i].deregistered;
+			scan += iterations[i].scanLength;
+		}
+
+		tablePrinter.addColumnData(Helper::stringify((size_t) from) + "-"
+				+ Helper::stringify((size_t) (to - 1)));
+		tablePrinter.addColumnData(formatMs(time));
+		tablePrinter.addColumnData(formatShare(time, totalTime));
+		tablePrinter.addColumnData(Helper::stringify((size_t) replaced));
+		tablePrinter.addColumnData(Helper::stringify((size_t) updates));
+		tablePrinter.addColumnData(Helper::stringify((size_t) (scan / (to - from))));
+		tablePrinter.printRow();
+	}
+}
+
+/**
+ * Groups the iterations by the number of occurrences replaced and prints
+ * the time needed by each group.
+ */
+static void printByReplacedOccurrences(vector<TraceIteration> & iterations,
+		unsigned long long totalTime)
+{
+	const unsigned int numberOfGroups = 6;
+	const char * names[numberOfGroups] = { "0-3", "4-15", "16-63", "64-255",
+			"256-1023", ">=1024" };
+	unsigned long long time[numberOfGroups] = { 0 };
+	unsigned long long replaced[numberOfGroups] = { 0 };
+	unsigned int count[numberOfGroups] = { 0 };
+
+	for (unsigned int i = 0; i < iterations.size(); i++)
+	{
+		unsigned int group = 0;
+		unsigned int bound = 4;
+		while (group < numberOfGroups - 1 && iterations[i].replaced >= bound)
+		{
+			group++;
+			bound *= 4;
+		}
+		time[group] += iterations[i].nanoseconds;
+		replaced[group] += iterations[i].replaced;
+		count[group]++;
+	}
+
+	unsigned int widths[] = { 17, 12, 12, 8, 14 };
+	TablePrinter tablePrinter;
+	tablePrinter.init(5, widths);
+	tablePrinter.addColumnData("Replaced occs.");
+	tablePrinter.addColumnData("Iterations");
+	tablePrinter.addColumnData("Time [ms]");
+	tablePrinter.addColumnData("Share");
+	tablePrinter.addColumnData("ns/occurrence");
+	tablePrinter.printRowAsHeader();
+
+	for (unsigned int g = 0; g < numberOfGroups; g++)
+	{
+		if (count[g] == 0)
+		{
+			continue;
+		}
+		tablePrinter.addColumnData(names[g]);
+		tablePrinter.addColumnData(count[g]);
+		tablePrinter.addColumnData(formatMs(time[g]));
+		tablePrinter.addColumnData(formatShare(time[g], totalTime));
+		tablePrinter.addColumnData(Helper::stringify((size_t) (replaced[g] == 0
+				? 0 : time[g] / replaced[g])));
+		tablePrinter.printRow();
+	}
+}
+
+/**
+ * Prints the most expensive iterations.
+ */
+static void printTopIterations(vector<TraceIteration> iterations,
+		unsigned int top)
+{
+	top = min(top, (unsigned int) iterations.size());
+	partial_sort(iterations.begin(), iterations.begin() + top,
+			iterations.end(), compareByTime);
+
+	unsigned int widths[] = { 10, 20, 10, 10, 12, 10, 12 };
+	TablePrinter tablePrinter;
+	tablePrinter.init(7, widths);
+	tablePrinter.addColumnData("Iteration");
+	tablePrinter.addColumnData("Digram");
+	tablePrinter.addColumnData("Occs.");
+	tablePrinter.addColumnData("Replaced");
+	tablePrinter.addColumnData("Reg./Dereg.");
+	tablePrinter.addColumnData("Scan");
+	tablePrinter.addColumnData("Time [ms]");
+	tablePrinter.printRowAsHeader();
+
+	for (unsigned int i = 0; i < top; i++)
+	{
+		TraceIteration & it = iterations[i];
+		tablePrinter.addColumnData(it.iteration);
+		tablePrinter.addColumnData("(" + Helper::stringify((size_t) it.parent) + ","
+				+ Helper::stringify((size_t) it.index) + ","
+				+ Helper::stringify((size_t) it.child) + ")");
+		tablePrinter.addColumnData(it.occurrences);
+		tablePrinter.addColumnData(it.replaced);
+		tablePrinter.addColumnData(Helper::stringify((size_t) it.registered) + "/"
+				+ Helper::stringify((size_t) it.deregistered));
+		tablePrinter.addColumnData(it.scanLength);
+		tablePrinter.addColumnData(formatMs(it.nanoseconds));
+		tablePrinter.printRow();
+	}
+}
+
+int main (int argc, char* args[]) {
+
+	char * pFilePath = 0;
+	unsigned int top = 10;
+
+	for (int i = 1; i < argc; i++)
+	{
+		char * arg = args[i];
+		if (arg[0] == '-')
+		{
+			switch (arg[1])
+			{
+			case 't': // -top
+				if (i + 1 >= argc)
+				{
+					cout << "Please specify the number of iterations to list." << endl;
+					exit(1);
+				}
+				top = atoi(args[i + 1]);
+				i++;
+				break;
+			case 'h': // -help
+				printHelp();
+				exit(0);
+				break;
+			default:
+				cout << "Unknown switch: " << arg << endl;
+				exit(1);
+				break;
+			}
+		}
+		else
+		{
+			pFilePath = arg;
+		}
+	}
+
+	if (pFilePath == 0) {
+		cout << "Please specify a trace file. Use the -help switch to show the help screen." << endl;
+		exit(1);
+	}
+
+	vector<TraceIteration> iterations;
+	readTrace(pFilePath, iterations);
+
+	unsigned long long totalTime = 0, replaced = 0, registered = 0,
+			deregistered = 0, scan = 0;
+	for (unsigned int i = 0; i < iterations.size(); i++)
+	{
+		totalTime += iterations[i].nanoseconds;
+		replaced += iterations[i].replaced;
+		registered += iterations[i].registered;
+		deregistered += iterations[i].deregistered;
+		scan += iterations[i].scanLength;
+	}
+
+	cout << "Iterations: " << iterations.size() << endl;
+	cout << "Total time: " << formatMs(totalTime) << " ms" << endl;
+	cout << "Occurrences replaced: " << replaced << endl;
+	cout << "Occurrences registered: " << registered << ", deregistered: "
+			<< deregistered << endl;
+	cout << "Priority queue scan length: " << scan << endl;
+
+	if (iterations.empty())
+	{
+		return 0;
+	}
+
+	cout << endl << "Time per tenth of the iterations:" << endl;
+	printDeciles(iterations, totalTime);
+
+	cout << endl << "Time by number of occurrences replaced:" << endl;
+	printByReplacedOccurrences(iterations, totalTime);
+
+	if (top > 0)
+	{
+		cout << endl << "Most expensive iterations:" << endl;
+		printTopIterations(iterations, top);
+	}
+
+	return 0;
+}